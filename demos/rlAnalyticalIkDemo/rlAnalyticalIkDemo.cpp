@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/JacobianInverseKinematics.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/SphericalWristInverseKinematics.h>
+#include <rl/mdl/XmlFactory.h>
+
+#include "MitsubishiRv6slInverseKinematics.h"
+
+int
+main(int argc, char** argv)
+{
+	try
+	{
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(MODELFILE));
+		
+		std::size_t goals = argc > 1 ? boost::lexical_cast<std::size_t>(argv[1]) : 1000;
+		
+		// reachable goals and unrelated start positions, identical for all solvers
+		
+		kinematic->seed(0);
+		
+		std::vector<rl::math::Transform> x(goals);
+		std::vector<rl::math::Vector> q(goals);
+		
+		for (std::size_t i = 0; i < goals; ++i)
+		{
+			kinematic->setPosition(kinematic->generatePositionUniform());
+			kinematic->forwardPosition();
+			x[i] = kinematic->getOperationalPosition(0);
+			q[i] = kinematic->generatePositionUniform();
+		}
+		
+		std::vector<std::pair<std::shared_ptr<rl::mdl::InverseKinematics>, std::string>> ik;
+		
+		std::shared_ptr<rl::mdl::JacobianInverseKinematics> jacobian = std::make_shared<rl::mdl::JacobianInverseKinematics>(kinematic.get());
+		jacobian->seed(0);
+		jacobian->setDuration(std::chrono::milliseconds(100));
+		ik.push_back(std::make_pair(jacobian, "rl::mdl::JacobianInverseKinematics"));
+		
+		ik.push_back(std::make_pair(std::make_shared<rl::mdl::SphericalWristInverseKinematics>(kinematic.get()), "rl::mdl::SphericalWristInverseKinematics"));
+		ik.push_back(std::make_pair(std::make_shared<MitsubishiRv6slInverseKinematics>(kinematic.get()), "MitsubishiRv6slInverseKinematics (generated)"));
+		
+		for (std::size_t i = 0; i < ik.size(); ++i)
+		{
+			std::vector<double> latency;
+			latency.reserve(goals);
+			std::size_t solved = 0;
+			
+			for (std::size_t j = 0; j < goals; ++j)
+			{
+				kinematic->setPosition(q[j]);
+				ik[i].first->clearGoals();
+				ik[i].first->addGoal(x[j], 0);
+				
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				bool valid = ik[i].first->solve();
+				std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+				
+				kinematic->forwardPosition();
+				
+				if (valid && kinematic->getOperationalPosition(0).toDelta(x[j]).norm() < 1.0e-6)
+				{
+					++solved;
+				}
+				
+				latency.push_back(std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(stop - start).count());
+			}
+			
+			std::sort(latency.begin(), latency.end());
+			
+			std::cout << ik[i].second << ": ";
+			std::cout << 100.0 * solved / goals << " % solved, ";
+			std::cout << "p50 " << latency[latency.size() * 50 / 100] << " us, ";
+			std::cout << "p90 " << latency[latency.size() * 90 / 100] << " us, ";
+			std::cout << "p99 " << latency[latency.size() * 99 / 100] << " us, ";
+			std::cout << "max " << latency.back() << " us" << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/BatchEvaluator.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlBatchDemo MODELFILE [SAMPLES] [THREADS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Dynamic> dynamic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		
+		std::size_t samples = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 10000;
+		std::size_t threads = argc > 3 ? boost::lexical_cast<std::size_t>(argv[3]) : 0;
+		
+		rl::math::Matrix Q(dynamic->getDofPosition(), samples);
+		rl::math::Matrix Qd = rl::math::Matrix::Random(dynamic->getDof(), samples);
+		rl::math::Matrix Qdd = rl::math::Matrix::Random(dynamic->getDof(), samples);
+		
+		for (std::size_t i = 0; i < samples; ++i)
+		{
+			Q.col(i) = dynamic->generatePositionUniform();
+		}
+		
+		rl::math::Matrix X;
+		rl::math::Matrix J;
+		rl::math::Matrix Tau;
+		
+		// single state
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < samples; ++i)
+		{
+			dynamic->setPosition(Q.col(i));
+			dynamic->forwardPosition();
+		}
+		
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << "forward position (single): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / samples << " us" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < samples; ++i)
+		{
+			dynamic->setPosition(Q.col(i));
+			dynamic->calculateJacobian();
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "Jacobian (single): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / samples << " us" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < samples; ++i)
+		{
+			dynamic->setPosition(Q.col(i));
+			dynamic->setVelocity(Qd.col(i));
+			dynamic->setAcceleration(Qdd.col(i));
+			dynamic->inverseDynamics();
+			Tau = dynamic->getTorque();
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "inverse dynamics (single): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / samples << " us" << std::endl;
+		
+		// batch
+		
+		for (std::size_t n = 1; n <= 2; ++n)
+		{
+			rl::mdl::BatchEvaluator batch(dynamic.get(), 1 == n ? 1 : threads);
+			
+			start = std::chrono::steady_clock::now();
+			batch.forwardPosition(Q, X);
+			stop = std::chrono::steady_clock::now();
+			
+			std::cout << "forward position (batch, " << batch.getThreads() << " threads): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / samples << " us" << std::endl;
+			
+			start = std::chrono::steady_clock::now();
+			batch.calculateJacobian(Q, J);
+			stop = std::chrono::steady_clock::now();
+			
+			std::cout << "Jacobian (batch, " << batch.getThreads() << " threads): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / samples << " us" << std::endl;
+			
+			start = std::chrono::steady_clock::now();
+			batch.inverseDynamics(Q, Qd, Qdd, Tau);
+			stop = std::chrono::steady_clock::now();
+			
+			std::cout << "inverse dynamics (batch, " << batch.getThreads() << " threads): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / samples << " us" << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/CacheFactory.h>
+#include <rl/mdl/Model.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+double
+measure(rl::mdl::Factory* factory, const std::string& filename, const std::size_t& loops)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	
+	for (std::size_t i = 0; i < loops; ++i)
+	{
+		factory->create(filename);
+	}
+	
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	
+	return std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 / loops;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlCacheFactoryDemo MODELFILE [LOOPS] [CACHEDIRECTORY]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::size_t loops = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 100;
+		std::string directory = argc > 3 ? argv[3] : "";
+		
+		std::shared_ptr<rl::mdl::Factory> factory;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			factory = std::make_shared<rl::mdl::UrdfFactory>();
+		}
+		else
+		{
+			factory = std::make_shared<rl::mdl::XmlFactory>();
+		}
+		
+		rl::mdl::CacheFactory cache(factory.get(), directory);
+		std::remove(cache.getCacheFilename(filename).c_str());
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::shared_ptr<rl::mdl::Model> model = cache.create(filename);
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << model->getManufacturer() << " " << model->getName() << ": ";
+		std::cout << model->getFrames() << " frames, " << model->getTransforms() << " transforms, " << model->getDof() << " dof" << std::endl;
+		std::cout << "cache " << cache.getCacheFilename(filename) << " written in ";
+		std::cout << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 << " ms" << std::endl;
+		
+		double source = measure(factory.get(), filename, loops);
+		double cached = measure(&cache, filename, loops);
+		
+		std::cout << "source: " << source << " ms per model" << std::endl;
+		std::cout << "cache: " << cached << " ms per model" << (cache.isHit() ? "" : " (not used)") << std::endl;
+		std::cout << "speedup: " << source / cached << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/XmlFactory.h>
+
+#include "UnimationPuma560.h"
+
+double
+measure(const std::function<void(const std::size_t&)>& function, const std::size_t& calls)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	
+	for (std::size_t i = 0; i < calls; ++i)
+	{
+		function(i);
+	}
+	
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	
+	return std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1.0e6 / calls;
+}
+
+int
+main(int argc, char** argv)
+{
+	try
+	{
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(MODELFILE));
+		
+		std::size_t calls = argc > 1 ? boost::lexical_cast<std::size_t>(argv[1]) : 100000;
+		
+		// identical random states for both implementations
+		
+		dynamic->seed(0);
+		
+		std::vector<UnimationPuma560::JointVector> q(1000);
+		std::vector<UnimationPuma560::JointVector> qd(q.size());
+		std::vector<UnimationPuma560::JointVector> qdd(q.size());
+		std::vector<UnimationPuma560::JointVector> tau(q.size());
+		
+		for (std::size_t i = 0; i < q.size(); ++i)
+		{
+			q[i] = dynamic->generatePositionUniform();
+			qd[i].setRandom();
+			qdd[i].setRandom();
+			tau[i].setRandom();
+		}
+		
+		rl::math::Matrix J(6 * dynamic->getOperationalDof(), dynamic->getDof());
+		rl::math::Matrix M(dynamic->getDof(), dynamic->getDof());
+		
+		UnimationPuma560::JacobianMatrix J2;
+		UnimationPuma560::MassMatrix M2;
+		UnimationPuma560::JointVector qdd2;
+		UnimationPuma560::JointVector tau2;
+		UnimationPuma560::OperationalPositions x2;
+		
+		std::vector<std::pair<std::string, std::pair<std::function<void(const std::size_t&)>, std::function<void(const std::size_t&)>>>> functions = {
+			{
+				"forward position",
+				{
+					[&](const std::size_t& i) { dynamic->setPosition(q[i % q.size()]); dynamic->forwardPosition(); },
+					[&](const std::size_t& i) { UnimationPuma560::forwardPosition(q[i % q.size()], x2); }
+				}
+			},
+			{
+				"jacobian",
+				{
+					[&](const std::size_t& i) { dynamic->setPosition(q[i % q.size()]); dynamic->calculateJacobian(J); },
+					[&](const std::size_t& i) { UnimationPuma560::calculateJacobian(q[i % q.size()], J2); }
+				}
+			},
+			{
+				"inverse dynamics",
+				{
+					[&](const std::size_t& i) { dynamic->setPosition(q[i % q.size()]); dynamic->setVelocity(qd[i % q.size()]); dynamic->setAcceleration(qdd[i % q.size()]); dynamic->inverseDynamics(); },
+					[&](const std::size_t& i) { UnimationPuma560::inverseDynamics(q[i % q.size()], qd[i % q.size()], qdd[i % q.size()], tau2); }
+				}
+			},
+			{
+				"mass matrix",
+				{
+					[&](const std::size_t& i) { dynamic->setPosition(q[i % q.size()]); dynamic->calculateMassMatrix(M); },
+					[&](const std::size_t& i) { UnimationPuma560::calculateMassMatrix(q[i % q.size()], M2); }
+				}
+			},
+			{
+				"forward dynamics",
+				{
+					[&](const std::size_t& i) { dynamic->setPosition(q[i % q.size()]); dynamic->setVelocity(qd[i % q.size()]); dynamic->setTorque(tau[i % q.size()]); dynamic->forwardDynamics(); },
+					[&](const std::size_t& i) { UnimationPuma560::forwardDynamics(q[i % q.size()], qd[i % q.size()], tau[i % q.size()], qdd2); }
+				}
+			}
+		};
+		
+		for (std::size_t i = 0; i < functions.size(); ++i)
+		{
+			double interpreted = measure(functions[i].second.first, calls);
+			double generated = measure(functions[i].second.second, calls);
+			
+			std::cout << functions[i].first << ": ";
+			std::cout << "rl::mdl::Dynamic " << interpreted << " us, ";
+			std::cout << "generated " << generated << " us, ";
+			std::cout << "speedup " << interpreted / generated << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,289 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+void
+centralDifferences(rl::mdl::Dynamic* dynamic, const rl::math::Vector& q, const rl::math::Vector& qd, const rl::math::Vector& qdd, rl::math::Matrix& dtaudq, rl::math::Matrix& dtaudqd)
+{
+	rl::math::Real h = static_cast<rl::math::Real>(1.0e-6);
+	rl::math::Vector dq = rl::math::Vector::Zero(dynamic->getDof());
+	rl::math::Vector q1(dynamic->getDofPosition());
+	rl::math::Vector q2(dynamic->getDofPosition());
+	rl::math::Vector qd1(dynamic->getDof());
+	rl::math::Vector qd2(dynamic->getDof());
+	
+	for (std::size_t i = 0; i < dynamic->getDof(); ++i)
+	{
+		dq(i) = h;
+		dynamic->step(q, dq, q2);
+		dynamic->step(q, -dq, q1);
+		dq(i) = 0;
+		
+		dynamic->setPosition(q2);
+		dynamic->setVelocity(qd);
+		dynamic->setAcceleration(qdd);
+		dynamic->inverseDynamics();
+		dtaudq.col(i) = dynamic->getTorque();
+		
+		dynamic->setPosition(q1);
+		dynamic->inverseDynamics();
+		dtaudq.col(i) = (dtaudq.col(i) - dynamic->getTorque()) / (2 * h);
+		
+		qd2 = qd;
+		qd2(i) += h;
+		qd1 = qd;
+		qd1(i) -= h;
+		
+		dynamic->setPosition(q);
+		dynamic->setVelocity(qd2);
+		dynamic->inverseDynamics();
+		dtaudqd.col(i) = dynamic->getTorque();
+		
+		dynamic->setVelocity(qd1);
+		dynamic->inverseDynamics();
+		dtaudqd.col(i) = (dtaudqd.col(i) - dynamic->getTorque()) / (2 * h);
+	}
+}
+
+void
+centralDifferences(rl::mdl::Dynamic* dynamic, const rl::math::Vector& q, const rl::math::Vector& qd, const rl::math::Vector& tau, rl::math::Matrix& dqdddq, rl::math::Matrix& dqdddqd, rl::math::Matrix& dqdddtau)
+{
+	rl::math::Real h = static_cast<rl::math::Real>(1.0e-6);
+	rl::math::Vector dq = rl::math::Vector::Zero(dynamic->getDof());
+	rl::math::Vector q1(dynamic->getDofPosition());
+	rl::math::Vector q2(dynamic->getDofPosition());
+	rl::math::Vector qd1(dynamic->getDof());
+	rl::math::Vector qd2(dynamic->getDof());
+	rl::math::Vector tau1(dynamic->getDof());
+	rl::math::Vector tau2(dynamic->getDof());
+	
+	for (std::size_t i = 0; i < dynamic->getDof(); ++i)
+	{
+		dq(i) = h;
+		dynamic->step(q, dq, q2);
+		dynamic->step(q, -dq, q1);
+		dq(i) = 0;
+		
+		dynamic->setPosition(q2);
+		dynamic->setVelocity(qd);
+		dynamic->setTorque(tau);
+		dynamic->forwardDynamics();
+		dqdddq.col(i) = dynamic->getAcceleration();
+		
+		dynamic->setPosition(q1);
+		dynamic->forwardDynamics();
+		dqdddq.col(i) = (dqdddq.col(i) - dynamic->getAcceleration()) / (2 * h);
+		
+		qd2 = qd;
+		qd2(i) += h;
+		qd1 = qd;
+		qd1(i) -= h;
+		
+		dynamic->setPosition(q);
+		dynamic->setVelocity(qd2);
+		dynamic->forwardDynamics();
+		dqdddqd.col(i) = dynamic->getAcceleration();
+		
+		dynamic->setVelocity(qd1);
+		dynamic->forwardDynamics();
+		dqdddqd.col(i) = (dqdddqd.col(i) - dynamic->getAcceleration()) / (2 * h);
+		
+		tau2 = tau;
+		tau2(i) += h;
+		tau1 = tau;
+		tau1(i) -= h;
+		
+		dynamic->setVelocity(qd);
+		dynamic->setTorque(tau2);
+		dynamic->forwardDynamics();
+		dqdddtau.col(i) = dynamic->getAcceleration();
+		
+		dynamic->setTorque(tau1);
+		dynamic->forwardDynamics();
+		dqdddtau.col(i) = (dqdddtau.col(i) - dynamic->getAcceleration()) / (2 * h);
+	}
+}
+
+rl::math::Real
+error(const rl::math::Matrix& analytical, const rl::math::Matrix& numerical)
+{
+	return (analytical - numerical).cwiseAbs().maxCoeff() / std::max(static_cast<rl::math::Real>(1), analytical.cwiseAbs().maxCoeff());
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlDynamicsDerivativesDemo MODELFILE [ITERATIONS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Dynamic> dynamic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		
+		std::size_t iterations = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 1000;
+		
+		std::vector<rl::math::Vector> q(iterations);
+		std::vector<rl::math::Vector> qd(iterations);
+		std::vector<rl::math::Vector> qdd(iterations);
+		std::vector<rl::math::Vector> tau(iterations);
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			q[i] = dynamic->generatePositionUniform();
+			qd[i] = rl::math::Vector::Random(dynamic->getDof());
+			qdd[i] = rl::math::Vector::Random(dynamic->getDof());
+			tau[i] = rl::math::Vector::Random(dynamic->getDof());
+		}
+		
+		rl::math::Matrix dtaudq(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix dtaudqd(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix dqdddq(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix dqdddqd(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix dqdddtau(dynamic->getDof(), dynamic->getDof());
+		
+		// inverse dynamics (central differences)
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			centralDifferences(dynamic.get(), q[i], qd[i], qdd[i], dtaudq, dtaudqd);
+		}
+		
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << "inverse dynamics (central differences): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		// inverse dynamics (analytical)
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->setVelocity(qd[i]);
+			dynamic->setAcceleration(qdd[i]);
+			dynamic->calculateInverseDynamicsDerivatives(dtaudq, dtaudqd);
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "inverse dynamics (analytical): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		// forward dynamics (central differences)
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			centralDifferences(dynamic.get(), q[i], qd[i], tau[i], dqdddq, dqdddqd, dqdddtau);
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "forward dynamics (central differences): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		// forward dynamics (analytical)
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->setVelocity(qd[i]);
+			dynamic->setTorque(tau[i]);
+			dynamic->calculateForwardDynamicsDerivatives(dqdddq, dqdddqd, dqdddtau);
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "forward dynamics (analytical): " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		rl::math::Real errorInverse = 0;
+		rl::math::Real errorForward = 0;
+		rl::math::Matrix dtaudq2(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix dtaudqd2(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix dqdddq2(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix dqdddqd2(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix dqdddtau2(dynamic->getDof(), dynamic->getDof());
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			centralDifferences(dynamic.get(), q[i], qd[i], qdd[i], dtaudq2, dtaudqd2);
+			
+			dynamic->setPosition(q[i]);
+			dynamic->setVelocity(qd[i]);
+			dynamic->setAcceleration(qdd[i]);
+			dynamic->calculateInverseDynamicsDerivatives(dtaudq, dtaudqd);
+			
+			errorInverse = std::max(errorInverse, std::max(error(dtaudq, dtaudq2), error(dtaudqd, dtaudqd2)));
+			
+			centralDifferences(dynamic.get(), q[i], qd[i], tau[i], dqdddq2, dqdddqd2, dqdddtau2);
+			
+			dynamic->setPosition(q[i]);
+			dynamic->setVelocity(qd[i]);
+			dynamic->setTorque(tau[i]);
+			dynamic->calculateForwardDynamicsDerivatives(dqdddq, dqdddqd, dqdddtau);
+			
+			errorForward = std::max(errorForward, std::max(error(dqdddq, dqdddq2), std::max(error(dqdddqd, dqdddqd2), error(dqdddtau, dqdddtau2))));
+		}
+		
+		std::cout << "max relative error inverse dynamics: " << errorInverse << std::endl;
+		std::cout << "max relative error forward dynamics: " << errorForward << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/DormandPrinceIntegrator.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/EulerCauchyIntegrator.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
+#include <rl/mdl/SymplecticEulerIntegrator.h>
+#include <rl/mdl/XmlFactory.h>
+
+rl::math::Real
+energy(rl::mdl::Dynamic* dynamic)
+{
+	rl::math::Vector qd = dynamic->getVelocity();
+	dynamic->calculateMassMatrix();
+	rl::math::Real energy = qd.dot(dynamic->getMassMatrix() * qd) / 2;
+	
+	dynamic->forwardPosition();
+	
+	for (std::size_t i = 0; i < dynamic->getBodies(); ++i)
+	{
+		energy += dynamic->getBody(i)->m * dynamic->getWorldGravity().dot(dynamic->getBodyFrame(i) * dynamic->getBody(i)->cm);
+	}
+	
+	return energy;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlIntegratorDemo MODELFILE [DURATION] [DT]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[1]));
+		
+		rl::math::Real duration = argc > 2 ? boost::lexical_cast<rl::math::Real>(argv[2]) : 10;
+		rl::math::Real dt = argc > 3 ? boost::lexical_cast<rl::math::Real>(argv[3]) : static_cast<rl::math::Real>(0.001);
+		std::size_t steps = static_cast<std::size_t>(std::round(duration / dt));
+		
+		// motion without torque conserves kinetic and potential energy
+		
+		dynamic->seed(0);
+		rl::math::Vector q = dynamic->generatePositionUniform();
+		rl::math::Vector qd = rl::math::Vector::Ones(dynamic->getDof());
+		
+		std::shared_ptr<rl::mdl::DormandPrinceIntegrator> dormandPrince6 = std::make_shared<rl::mdl::DormandPrinceIntegrator>(dynamic.get());
+		
+		std::shared_ptr<rl::mdl::DormandPrinceIntegrator> dormandPrince9 = std::make_shared<rl::mdl::DormandPrinceIntegrator>(dynamic.get());
+		dormandPrince9->setAbsoluteTolerance(static_cast<rl::math::Real>(1.0e-9));
+		dormandPrince9->setRelativeTolerance(static_cast<rl::math::Real>(1.0e-9));
+		
+		std::vector<std::pair<std::shared_ptr<rl::mdl::Integrator>, std::string>> integrators = {
+			{std::make_shared<rl::mdl::EulerCauchyIntegrator>(dynamic.get()), "Euler-Cauchy"},
+			{std::make_shared<rl::mdl::SymplecticEulerIntegrator>(dynamic.get()), "symplectic Euler"},
+			{std::make_shared<rl::mdl::RungeKuttaNystromIntegrator>(dynamic.get()), "Runge-Kutta-Nystrom"},
+			{dormandPrince6, "Dormand-Prince 1e-6"},
+			{dormandPrince9, "Dormand-Prince 1e-9"}
+		};
+		
+		for (std::size_t i = 0; i < integrators.size(); ++i)
+		{
+			rl::mdl::DormandPrinceIntegrator* dormandPrince = dynamic_cast<rl::mdl::DormandPrinceIntegrator*>(integrators[i].first.get());
+			
+			// adaptive integrators choose their own steps within each interval
+			std::size_t interval = nullptr != dormandPrince ? 100 : 1;
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(rl::math::Vector::Zero(dynamic->getDof()));
+			
+			rl::math::Real energy0 = energy(dynamic.get());
+			rl::math::Real drift = 0;
+			
+			std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::duration::zero();
+			
+			for (std::size_t j = 0; j < steps; j += interval)
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				integrators[i].first->integrate(interval * dt);
+				elapsed += std::chrono::steady_clock::now() - start;
+				
+				if (0 == (j + interval) % 100)
+				{
+					drift = std::max(drift, std::abs(energy(dynamic.get()) - energy0) / std::abs(energy0));
+				}
+			}
+			
+			double seconds = std::chrono::duration<double>(elapsed).count();
+			
+			std::cout << integrators[i].second << ": ";
+			std::cout << (nullptr != dormandPrince ? dormandPrince->getAcceptedSteps() : steps) / seconds << " steps/s, ";
+			std::cout << duration / seconds << " x real time, ";
+			std::cout << "max energy drift " << drift * 100 << " %";
+			
+			if (nullptr != dormandPrince)
+			{
+				std::cout << ", " << dormandPrince->getAcceptedSteps() << " accepted, ";
+				std::cout << dormandPrince->getRejectedSteps() << " rejected, ";
+				std::cout << dormandPrince->getEvaluations() << " evaluations";
+			}
+			
+			std::cout << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/Fixed.h>
+#include <rl/mdl/Frame.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/Revolute.h>
+#include <rl/mdl/World.h>
+#include <rl/mdl/XmlFactory.h>
+
+std::shared_ptr<rl::mdl::Kinematic>
+createChain(const std::size_t& dof)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = std::make_shared<rl::mdl::Kinematic>();
+	kinematic->setName("chain" + std::to_string(dof));
+	
+	std::shared_ptr<rl::mdl::World> world = std::make_shared<rl::mdl::World>();
+	kinematic->add(world);
+	
+	rl::mdl::Frame* frame = world.get();
+	
+	// alternating axes z and y with links along z
+	
+	for (std::size_t i = 0; i < dof; ++i)
+	{
+		std::shared_ptr<rl::mdl::Body> body = std::make_shared<rl::mdl::Body>();
+		kinematic->add(body);
+		
+		std::shared_ptr<rl::mdl::Revolute> joint = std::make_shared<rl::mdl::Revolute>();
+		joint->S.setZero();
+		joint->S(i % 2 > 0 ? 1 : 2, 0) = 1;
+		joint->setMaximum(rl::math::Vector::Constant(1, 170 * rl::math::constants::deg2rad));
+		joint->setMinimum(rl::math::Vector::Constant(1, -170 * rl::math::constants::deg2rad));
+		kinematic->add(joint, frame, body.get());
+		
+		std::shared_ptr<rl::mdl::Frame> next = std::make_shared<rl::mdl::Frame>();
+		kinematic->add(next);
+		
+		std::shared_ptr<rl::mdl::Fixed> fixed = std::make_shared<rl::mdl::Fixed>();
+		fixed->setTransform(rl::math::Transform(rl::math::Translation(rl::math::Vector3(0, 0, static_cast<rl::math::Real>(0.8) / dof))));
+		kinematic->add(fixed, body.get(), next.get());
+		
+		frame = next.get();
+	}
+	
+	kinematic->update();
+	
+	return kinematic;
+}
+
+int
+main(int argc, char** argv)
+{
+	try
+	{
+		std::vector<std::shared_ptr<rl::mdl::Kinematic>> kinematics;
+		
+		if (argc > 1)
+		{
+			rl::mdl::XmlFactory factory;
+			kinematics.push_back(std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(argv[1])));
+		}
+		
+		kinematics.push_back(createChain(6));
+		kinematics.push_back(createChain(7));
+		kinematics.push_back(createChain(12));
+		
+		std::vector<std::pair<rl::mdl::Kinematic::JacobianInverseMethod, std::string>> methods = {
+			{rl::mdl::Kinematic::JacobianInverseMethod::svd, "svd"},
+			{rl::mdl::Kinematic::JacobianInverseMethod::bdcSvd, "bdcSvd"},
+			{rl::mdl::Kinematic::JacobianInverseMethod::ldlt, "ldlt"},
+			{rl::mdl::Kinematic::JacobianInverseMethod::llt, "llt"},
+			{rl::mdl::Kinematic::JacobianInverseMethod::cod, "cod"}
+		};
+		
+		std::size_t samples = 1000;
+		rl::math::Real lambda = static_cast<rl::math::Real>(0.01);
+		
+		for (std::size_t i = 0; i < kinematics.size(); ++i)
+		{
+			std::shared_ptr<rl::mdl::Kinematic> kinematic = kinematics[i];
+			kinematic->seed(0);
+			
+			std::vector<rl::math::Vector> q(samples);
+			
+			for (std::size_t j = 0; j < samples; ++j)
+			{
+				q[j] = kinematic->generatePositionUniform();
+			}
+			
+			rl::math::Matrix invJ(kinematic->getDof(), 6 * kinematic->getOperationalDof());
+			rl::math::Vector dx = rl::math::Vector::Ones(6 * kinematic->getOperationalDof());
+			rl::math::Vector dq(kinematic->getDof());
+			
+			std::cout << kinematic->getName() << " (" << kinematic->getDof() << " dof)" << std::endl;
+			
+			std::chrono::steady_clock::duration reference = std::chrono::steady_clock::duration::zero();
+			
+			for (std::size_t j = 0; j < samples; ++j)
+			{
+				kinematic->setPosition(q[j]);
+				kinematic->calculateJacobian();
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				kinematic->calculateJacobianInverse(kinematic->getJacobian(), invJ, lambda, true);
+				reference += std::chrono::steady_clock::now() - start;
+			}
+			
+			std::cout << "  calculateJacobianInverse(J, invJ): " << std::chrono::duration<double, std::micro>(reference).count() / samples << " us" << std::endl;
+			
+			for (std::size_t k = 0; k < methods.size(); ++k)
+			{
+				std::chrono::steady_clock::duration inverse = std::chrono::steady_clock::duration::zero();
+				std::chrono::steady_clock::duration solve = std::chrono::steady_clock::duration::zero();
+				
+				for (std::size_t j = 0; j < samples; ++j)
+				{
+					kinematic->setPosition(q[j]);
+					kinematic->calculateJacobian();
+					
+					std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+					kinematic->calculateJacobianInverse(lambda, methods[k].first);
+					std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+					kinematic->solveJacobianInverse(dx, dq, lambda, methods[k].first);
+					solve += std::chrono::steady_clock::now() - stop;
+					inverse += stop - start;
+				}
+				
+				std::cout << "  " << methods[k].second << ": ";
+				std::cout << "inverse " << std::chrono::duration<double, std::micro>(inverse).count() / samples << " us, ";
+				std::cout << "solve " << std::chrono::duration<double, std::micro>(solve).count() / samples << " us" << std::endl;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
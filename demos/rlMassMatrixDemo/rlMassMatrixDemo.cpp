@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlMassMatrixDemo MODELFILE [ITERATIONS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Dynamic> dynamic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		
+		std::size_t iterations = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 10000;
+		
+		std::vector<rl::math::Vector> q(iterations);
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			q[i] = dynamic->generatePositionUniform();
+		}
+		
+		rl::math::Matrix M(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix M2(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix invM(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix invM2(dynamic->getDof(), dynamic->getDof());
+		rl::math::Vector tmp(dynamic->getDof());
+		rl::math::Real error = 0;
+		rl::math::Real errorInverse = 0;
+		rl::math::Real errorFactorization = 0;
+		
+		// one inverse dynamics sweep per column
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			rl::math::Vector3 g = dynamic->getWorldGravity();
+			dynamic->setPosition(q[i]);
+			dynamic->setVelocity(rl::math::Vector::Zero(dynamic->getDof()));
+			dynamic->setWorldGravity(rl::math::Vector3::Zero());
+			
+			for (std::size_t j = 0; j < dynamic->getDof(); ++j)
+			{
+				tmp.setZero();
+				tmp(j) = 1;
+				dynamic->setAcceleration(tmp);
+				dynamic->inverseDynamics();
+				M2.col(j) = dynamic->getTorque();
+			}
+			
+			dynamic->setWorldGravity(g);
+		}
+		
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << "inverse dynamics: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		// composite-rigid-body algorithm
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->calculateMassMatrix(M);
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "composite-rigid-body: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		// one forward dynamics sweep per column
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			rl::math::Vector3 g = dynamic->getWorldGravity();
+			dynamic->setPosition(q[i]);
+			dynamic->setVelocity(rl::math::Vector::Zero(dynamic->getDof()));
+			dynamic->setWorldGravity(rl::math::Vector3::Zero());
+			
+			for (std::size_t j = 0; j < dynamic->getDof(); ++j)
+			{
+				tmp.setZero();
+				tmp(j) = 1;
+				dynamic->setTorque(tmp);
+				dynamic->forwardDynamics();
+				invM2.col(j) = dynamic->getAcceleration();
+			}
+			
+			dynamic->setWorldGravity(g);
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "forward dynamics: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		// direct inverse
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->calculateMassMatrixInverse(invM);
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "direct inverse: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		// composite-rigid-body algorithm and sparse factorization
+		
+		rl::math::Matrix L(dynamic->getDof(), dynamic->getDof());
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->calculateMassMatrix(M);
+			dynamic->calculateMassMatrixFactorization(M, L);
+			tmp.setOnes();
+			dynamic->solveMassMatrix(L, tmp);
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "composite-rigid-body and factorization: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000 / iterations << " us" << std::endl;
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			rl::math::Vector3 g = dynamic->getWorldGravity();
+			dynamic->setPosition(q[i]);
+			dynamic->setVelocity(rl::math::Vector::Zero(dynamic->getDof()));
+			dynamic->setWorldGravity(rl::math::Vector3::Zero());
+			
+			for (std::size_t j = 0; j < dynamic->getDof(); ++j)
+			{
+				tmp.setZero();
+				tmp(j) = 1;
+				dynamic->setAcceleration(tmp);
+				dynamic->inverseDynamics();
+				M2.col(j) = dynamic->getTorque();
+			}
+			
+			dynamic->setWorldGravity(g);
+			dynamic->calculateMassMatrix(M);
+			error = std::max(error, (M - M2).cwiseAbs().maxCoeff());
+			
+			dynamic->calculateMassMatrixInverse(invM);
+			errorInverse = std::max(errorInverse, (invM * M - rl::math::Matrix::Identity(dynamic->getDof(), dynamic->getDof())).cwiseAbs().maxCoeff());
+			
+			dynamic->calculateMassMatrixFactorization(M, L);
+			invM2.setIdentity();
+			dynamic->solveMassMatrix(L, invM2);
+			errorFactorization = std::max(errorFactorization, (invM2 - invM).cwiseAbs().maxCoeff() / invM.cwiseAbs().maxCoeff());
+		}
+		
+		std::cout << "max error: " << error << std::endl;
+		std::cout << "max error inverse: " << errorInverse << std::endl;
+		std::cout << "max relative error factorization: " << errorFactorization << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
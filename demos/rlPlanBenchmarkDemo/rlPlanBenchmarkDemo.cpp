@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/Prm.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/RrtConCon.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/UrdfFactory.h>
+#include <rl/sg/XmlFactory.h>
+
+#if defined(RL_SG_SOLID)
+#include <rl/sg/solid/Model.h>
+#include <rl/sg/solid/Scene.h>
+#elif defined(RL_SG_BULLET)
+#include <rl/sg/bullet/Model.h>
+#include <rl/sg/bullet/Scene.h>
+#elif defined(RL_SG_ODE)
+#include <rl/sg/ode/Model.h>
+#include <rl/sg/ode/Scene.h>
+#endif
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlPlanBenchmarkDemo SCENEFILE KINEMATICSFILE RUNS START1 ... STARTn GOAL1 ... GOALn" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string scenefile(argv[1]);
+#if defined(RL_SG_SOLID)
+		rl::sg::solid::Scene scene;
+#elif defined(RL_SG_BULLET)
+		rl::sg::bullet::Scene scene;
+#elif defined(RL_SG_ODE)
+		rl::sg::ode::Scene scene;
+#endif
+		
+		if ("urdf" == scenefile.substr(scenefile.length() - 4, 4))
+		{
+			rl::sg::UrdfFactory factory;
+			factory.load(scenefile, &scene);
+		}
+		else
+		{
+			rl::sg::XmlFactory factory;
+			factory.load(scenefile, &scene);
+		}
+		
+		std::string kinematicsfile(argv[2]);
+		std::shared_ptr<rl::mdl::Kinematic> kinematic;
+		
+		if ("urdf" == kinematicsfile.substr(kinematicsfile.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(kinematicsfile));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(kinematicsfile));
+		}
+		
+		std::size_t runs = boost::lexical_cast<std::size_t>(argv[3]);
+		
+		rl::plan::SimpleModel model;
+		model.mdl = kinematic.get();
+		model.model = scene.getModel(0);
+		model.scene = &scene;
+		
+		rl::math::Vector start(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < start.size(); ++i)
+		{
+			start(i) = boost::lexical_cast<rl::math::Real>(argv[i + 4]) * rl::math::constants::deg2rad;
+		}
+		
+		rl::math::Vector goal(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < goal.size(); ++i)
+		{
+			goal(i) = boost::lexical_cast<rl::math::Real>(argv[start.size() + i + 4]) * rl::math::constants::deg2rad;
+		}
+		
+		std::cout << "sizeof(rl::math::Real): " << sizeof(rl::math::Real) << std::endl;
+		
+		for (std::size_t lazy = 0; lazy < 2; ++lazy)
+		{
+			std::size_t prmSolved = 0;
+			std::size_t prmVertices = 0;
+			std::size_t prmEdges = 0;
+			std::size_t prmQueries = 0;
+			double prmTime = 0;
+			
+			for (std::size_t i = 0; i < runs; ++i)
+			{
+				rl::plan::KdtreeNearestNeighbors nearestNeighbors(&model);
+				rl::plan::Prm planner;
+				rl::plan::UniformSampler sampler;
+				rl::plan::RecursiveVerifier verifier;
+				
+				planner.model = &model;
+				planner.setEvaluation(lazy > 0 ? rl::plan::Prm::Evaluation::lazy : rl::plan::Prm::Evaluation::eager);
+				planner.setNearestNeighbors(&nearestNeighbors);
+				planner.setSampler(&sampler);
+				planner.setVerifier(&verifier);
+				planner.setStart(&start);
+				planner.setGoal(&goal);
+				
+				sampler.setModel(&model);
+				sampler.seed(i);
+				
+				verifier.setDelta(1 * rl::math::constants::deg2rad);
+				verifier.setModel(&model);
+				
+				model.reset();
+				
+				std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+				prmSolved += planner.solve() ? 1 : 0;
+				std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+				
+				prmTime += std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count();
+				prmVertices += planner.getNumVertices();
+				prmEdges += planner.getNumEdges();
+				prmQueries += model.getTotalQueries();
+			}
+			
+			std::cout << (lazy > 0 ? "Lazy PRM: " : "PRM: ") << prmSolved << "/" << runs << " solved, " << prmTime / runs * 1000 << " ms/run, " << prmVertices / prmTime << " vertices/s, " << prmEdges / runs << " edges/run, " << prmQueries / runs << " collision queries/run" << std::endl;
+		}
+		
+		std::size_t rrtSolved = 0;
+		std::size_t rrtVertices = 0;
+		double rrtTime = 0;
+		
+		for (std::size_t i = 0; i < runs; ++i)
+		{
+			rl::plan::KdtreeNearestNeighbors nearestNeighbors0(&model);
+			rl::plan::KdtreeNearestNeighbors nearestNeighbors1(&model);
+			rl::plan::RrtConCon planner;
+			rl::plan::UniformSampler sampler;
+			
+			planner.model = &model;
+			planner.setNearestNeighbors(&nearestNeighbors0, 0);
+			planner.setNearestNeighbors(&nearestNeighbors1, 1);
+			planner.setSampler(&sampler);
+			planner.setDelta(1 * rl::math::constants::deg2rad);
+			planner.setStart(&start);
+			planner.setGoal(&goal);
+			
+			sampler.setModel(&model);
+			sampler.seed(i);
+			
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			rrtSolved += planner.solve() ? 1 : 0;
+			std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+			
+			rrtTime += std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count();
+			rrtVertices += planner.getNumVertices();
+		}
+		
+		std::cout << "RRT-ConCon: " << rrtSolved << "/" << runs << " solved, " << rrtTime / runs * 1000 << " ms/run, " << rrtVertices / rrtTime << " vertices/s" << std::endl;
+		
+		return EXIT_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
@@ -1496,6 +1496,11 @@ MainWindow::load(const QString& filename)
 				prm->setSearch(rl::plan::Prm::Search::dijkstra);
 			}
 			
+			if (path.eval("count(lazy) > 0").getValue<bool>())
+			{
+				prm->setEvaluation(rl::plan::Prm::Evaluation::lazy);
+			}
+			
 			prm->setMaxNeighbors(path.eval("number(k)").getValue<std::size_t>(30));
 			rl::math::Real radius = path.eval("number(radius)").getValue<rl::math::Real>(std::numeric_limits<rl::math::Real>::max());
 			
@@ -1519,6 +1524,11 @@ MainWindow::load(const QString& filename)
 				prmUtilityGuided->setSearch(rl::plan::Prm::Search::dijkstra);
 			}
 			
+			if (path.eval("count(lazy) > 0").getValue<bool>())
+			{
+				prmUtilityGuided->setEvaluation(rl::plan::Prm::Evaluation::lazy);
+			}
+			
 			prmUtilityGuided->setMaxNeighbors(path.eval("number(k)").getValue<std::size_t>(30));
 			rl::math::Real radius = path.eval("number(radius)").getValue<rl::math::Real>(std::numeric_limits<rl::math::Real>::max());
 			
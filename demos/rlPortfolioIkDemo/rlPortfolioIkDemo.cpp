@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/JacobianInverseKinematics.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/PortfolioInverseKinematics.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlPortfolioIkDemo MODELFILE [GOALS] [THREADS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Kinematic> kinematic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(filename));
+		}
+		
+		std::size_t goals = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 1000;
+		std::size_t threads = argc > 3 ? boost::lexical_cast<std::size_t>(argv[3]) : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		
+		// reachable goals and unrelated start positions, identical for all solvers
+		
+		kinematic->seed(0);
+		
+		std::vector<rl::math::Transform> x(goals);
+		std::vector<rl::math::Vector> q(goals);
+		
+		for (std::size_t i = 0; i < goals; ++i)
+		{
+			kinematic->setPosition(kinematic->generatePositionUniform());
+			kinematic->forwardPosition();
+			x[i] = kinematic->getOperationalPosition(0);
+			q[i] = kinematic->generatePositionUniform();
+		}
+		
+		std::vector<std::pair<std::shared_ptr<rl::mdl::IterativeInverseKinematics>, std::string>> ik;
+		
+		std::shared_ptr<rl::mdl::JacobianInverseKinematics> jacobian = std::make_shared<rl::mdl::JacobianInverseKinematics>(kinematic.get());
+		jacobian->seed(0);
+		ik.push_back(std::make_pair(jacobian, "sequential svd"));
+		
+		for (std::size_t n = 1; n <= threads; n *= 2)
+		{
+			std::shared_ptr<rl::mdl::PortfolioInverseKinematics> portfolio = std::make_shared<rl::mdl::PortfolioInverseKinematics>(kinematic.get(), n);
+			portfolio->seed(0);
+			ik.push_back(std::make_pair(portfolio, "portfolio svd " + std::to_string(n) + " threads"));
+			
+			if (n > 1)
+			{
+				portfolio = std::make_shared<rl::mdl::PortfolioInverseKinematics>(kinematic.get(), n);
+				portfolio->seed(0);
+				portfolio->setMethods({rl::mdl::PortfolioInverseKinematics::Method::svd, rl::mdl::PortfolioInverseKinematics::Method::dls});
+				ik.push_back(std::make_pair(portfolio, "portfolio svd/dls " + std::to_string(n) + " threads"));
+			}
+		}
+		
+		for (std::size_t i = 0; i < ik.size(); ++i)
+		{
+			ik[i].first->setDuration(std::chrono::milliseconds(100));
+			
+			std::vector<double> latency;
+			latency.reserve(goals);
+			std::size_t solved = 0;
+			
+			for (std::size_t j = 0; j < goals; ++j)
+			{
+				kinematic->setPosition(q[j]);
+				ik[i].first->clearGoals();
+				ik[i].first->addGoal(x[j], 0);
+				
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				
+				if (ik[i].first->solve())
+				{
+					++solved;
+				}
+				
+				std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+				
+				latency.push_back(std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000);
+			}
+			
+			std::sort(latency.begin(), latency.end());
+			
+			std::cout << ik[i].second << ": ";
+			std::cout << 100.0 * solved / goals << " % solved, ";
+			std::cout << "p50 " << latency[latency.size() * 50 / 100] << " ms, ";
+			std::cout << "p90 " << latency[latency.size() * 90 / 100] << " ms, ";
+			std::cout << "p99 " << latency[latency.size() * 99 / 100] << " ms, ";
+			std::cout << "max " << latency.back() << " ms" << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
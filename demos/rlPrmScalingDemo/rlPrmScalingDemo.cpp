@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/Prm.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/XmlFactory.h>
+
+#if defined(RL_SG_SOLID)
+#include <rl/sg/solid/Model.h>
+#include <rl/sg/solid/Scene.h>
+#elif defined(RL_SG_BULLET)
+#include <rl/sg/bullet/Model.h>
+#include <rl/sg/bullet/Scene.h>
+#elif defined(RL_SG_ODE)
+#include <rl/sg/ode/Model.h>
+#include <rl/sg/ode/Scene.h>
+#endif
+
+#if defined(RL_SG_SOLID)
+typedef rl::sg::solid::Scene Scene;
+#elif defined(RL_SG_BULLET)
+typedef rl::sg::bullet::Scene Scene;
+#elif defined(RL_SG_ODE)
+typedef rl::sg::ode::Scene Scene;
+#endif
+
+struct Worker
+{
+	Worker(const std::string& scenefile, const rl::mdl::Kinematic* kinematic, const std::size_t& seed) :
+		kinematic(static_cast<rl::mdl::Kinematic*>(kinematic->clone())),
+		model(),
+		sampler(),
+		scene(),
+		verifier()
+	{
+		rl::sg::XmlFactory factory;
+		factory.load(scenefile, &this->scene);
+		
+		this->model.mdl = this->kinematic.get();
+		this->model.model = this->scene.getModel(0);
+		this->model.scene = &this->scene;
+		
+		this->sampler.setModel(&this->model);
+		this->sampler.seed(seed);
+		
+		this->verifier.setDelta(1 * rl::math::constants::deg2rad);
+		this->verifier.setModel(&this->model);
+	}
+	
+	std::unique_ptr<rl::mdl::Kinematic> kinematic;
+	
+	rl::plan::SimpleModel model;
+	
+	rl::plan::UniformSampler sampler;
+	
+	Scene scene;
+	
+	rl::plan::RecursiveVerifier verifier;
+};
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlPrmScalingDemo SCENEFILE KINEMATICSFILE VERTICES [MAXTHREADS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(argv[2]));
+		
+		std::size_t vertices = boost::lexical_cast<std::size_t>(argv[3]);
+		std::size_t maxThreads = argc > 4 ? boost::lexical_cast<std::size_t>(argv[4]) : 32;
+		
+		double time1 = 0;
+		
+		for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+		{
+			std::vector<std::unique_ptr<Worker>> workers;
+			std::vector<rl::plan::Sampler*> samplers;
+			std::vector<rl::plan::Verifier*> verifiers;
+			
+			for (std::size_t i = 0; i < threads; ++i)
+			{
+				workers.emplace_back(new Worker(argv[1], kinematic.get(), i + 1));
+				samplers.push_back(&workers.back()->sampler);
+				verifiers.push_back(&workers.back()->verifier);
+			}
+			
+			rl::plan::KdtreeNearestNeighbors nearestNeighbors(&workers.front()->model);
+			rl::plan::Prm planner;
+			
+			planner.model = &workers.front()->model;
+			planner.setNearestNeighbors(&nearestNeighbors);
+			planner.setSampler(&workers.front()->sampler);
+			planner.setVerifier(&workers.front()->verifier);
+			planner.setWorkers(samplers, verifiers);
+			
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			planner.construct(vertices);
+			std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+			
+			double time = std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count();
+			
+			if (1 == threads)
+			{
+				time1 = time;
+			}
+			
+			std::cout << "threads: " << threads;
+			std::cout << " vertices: " << planner.getNumVertices();
+			std::cout << " edges: " << planner.getNumEdges();
+			std::cout << " time: " << time * 1000 << " ms";
+			std::cout << " vertices/s: " << planner.getNumVertices() / time;
+			std::cout << " speedup: " << time1 / time << std::endl;
+		}
+		
+		return EXIT_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
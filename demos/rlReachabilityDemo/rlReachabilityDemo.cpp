@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/JacobianInverseKinematics.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/ReachabilityMap.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlReachabilityDemo MODELFILE [SAMPLES] [MAPFILE] [GOALS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Kinematic> kinematic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(filename));
+		}
+		
+		std::size_t samples = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 1000000;
+		std::string mapFilename = argc > 3 ? argv[3] : "reachability.bin";
+		std::size_t goals = argc > 4 ? boost::lexical_cast<std::size_t>(argv[4]) : 1000;
+		
+		// build and save
+		
+		rl::mdl::ReachabilityMap reachability(kinematic.get());
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		reachability.build(samples);
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << "build " << samples << " samples with " << std::max<std::size_t>(std::thread::hardware_concurrency(), 1) << " threads: ";
+		std::cout << std::chrono::duration<double>(stop - start).count() << " s, " << reachability.getCells() << " cells" << std::endl;
+		
+		reachability.save(mapFilename);
+		
+		// load via memory mapping
+		
+		rl::mdl::ReachabilityMap mapped(kinematic.get());
+		
+		start = std::chrono::steady_clock::now();
+		mapped.load(mapFilename);
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "load " << mapFilename << ": " << std::chrono::duration<double, std::micro>(stop - start).count() << " us" << std::endl;
+		
+		// reachable goals and goals displaced by up to 1 m, identical for both solvers
+		
+		kinematic->seed(0);
+		
+		std::vector<rl::math::Transform> x(goals);
+		std::vector<rl::math::Vector> q(goals);
+		
+		for (std::size_t i = 0; i < goals; ++i)
+		{
+			kinematic->setPosition(kinematic->generatePositionUniform());
+			kinematic->forwardPosition();
+			x[i] = kinematic->getOperationalPosition(0);
+			
+			if (1 == i % 2)
+			{
+				x[i].translation() += rl::math::Vector3::Random();
+			}
+			
+			q[i] = kinematic->generatePositionUniform();
+		}
+		
+		std::size_t rejected = 0;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < goals; ++i)
+		{
+			if (!mapped.isReachable(x[i]))
+			{
+				++rejected;
+			}
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "query: " << std::chrono::duration<double, std::micro>(stop - start).count() / goals << " us, ";
+		std::cout << 100.0 * rejected / goals << " % rejected" << std::endl;
+		
+		for (std::size_t n = 0; n < 2; ++n)
+		{
+			rl::mdl::JacobianInverseKinematics ik(kinematic.get());
+			ik.seed(0);
+			ik.setDuration(std::chrono::milliseconds(100));
+			ik.setReachabilityMap(1 == n ? &mapped : nullptr);
+			
+			std::size_t solved = 0;
+			
+			start = std::chrono::steady_clock::now();
+			
+			for (std::size_t i = 0; i < goals; ++i)
+			{
+				kinematic->setPosition(q[i]);
+				ik.clearGoals();
+				ik.addGoal(x[i], 0);
+				
+				if (ik.solve())
+				{
+					++solved;
+				}
+			}
+			
+			stop = std::chrono::steady_clock::now();
+			
+			std::cout << (1 == n ? "with" : "without") << " reachability map: ";
+			std::cout << 100.0 * solved / goals << " % solved, ";
+			std::cout << std::chrono::duration<double, std::milli>(stop - start).count() / goals << " ms per goal" << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
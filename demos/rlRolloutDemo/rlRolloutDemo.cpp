@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/RolloutEvaluator.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlRolloutDemo MODELFILE [ROLLOUTS] [STEPS] [THREADS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Dynamic> dynamic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		
+		std::size_t rollouts = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 1000;
+		std::size_t steps = argc > 3 ? boost::lexical_cast<std::size_t>(argv[3]) : 100;
+		std::size_t threads = argc > 4 ? boost::lexical_cast<std::size_t>(argv[4]) : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		rl::math::Real dt = static_cast<rl::math::Real>(0.001);
+		
+		dynamic->seed(0);
+		rl::math::Vector q = dynamic->generatePositionUniform();
+		rl::math::Vector qd = rl::math::Vector::Zero(dynamic->getDof());
+		
+		// gravity compensation with random perturbations
+		
+		dynamic->setPosition(q);
+		dynamic->calculateGravity();
+		rl::math::Matrix Tau = dynamic->getGravity().replicate(1, rollouts * steps) + rl::math::Matrix::Random(dynamic->getDof(), rollouts * steps);
+		
+		rl::math::Matrix Q;
+		rl::math::Matrix Qd;
+		std::vector<std::size_t> lengths;
+		
+		// single model
+		
+		rl::mdl::RungeKuttaNystromIntegrator integrator(dynamic.get());
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < rollouts; ++i)
+		{
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			
+			for (std::size_t j = 0; j < steps; ++j)
+			{
+				dynamic->setTorque(Tau.col(i * steps + j));
+				integrator.integrate(dt);
+			}
+		}
+		
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << "single: " << rollouts * steps / std::chrono::duration<double>(stop - start).count() << " steps/s" << std::endl;
+		
+		// rollouts
+		
+		for (std::size_t n = 1; n <= threads; n *= 2)
+		{
+			rl::mdl::RolloutEvaluator evaluator(dynamic.get(), n);
+			
+			start = std::chrono::steady_clock::now();
+			evaluator.rollout(q, qd, Tau, steps, dt, Q, Qd, lengths);
+			stop = std::chrono::steady_clock::now();
+			
+			std::cout << "rollout " << n << " threads: " << rollouts * steps / std::chrono::duration<double>(stop - start).count() << " steps/s" << std::endl;
+		}
+		
+		// early termination once a joint velocity exceeds 5 rad/s
+		
+		rl::mdl::RolloutEvaluator evaluator(dynamic.get(), threads);
+		
+		start = std::chrono::steady_clock::now();
+		evaluator.rollout(q, qd, Tau, steps, dt, Q, Qd, lengths, [](const rl::math::ConstVectorRef&, const rl::math::ConstVectorRef& qd, const std::size_t&, const std::size_t&) {
+			return qd.cwiseAbs().maxCoeff() > 5;
+		});
+		stop = std::chrono::steady_clock::now();
+		
+		std::size_t simulated = 0;
+		
+		for (std::size_t i = 0; i < lengths.size(); ++i)
+		{
+			simulated += lengths[i];
+		}
+		
+		std::cout << "rollout " << threads << " threads with termination: " << simulated / std::chrono::duration<double>(stop - start).count() << " steps/s, ";
+		std::cout << 100.0 * simulated / (rollouts * steps) << " % simulated" << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/Rrt.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/XmlFactory.h>
+
+#if defined(RL_SG_SOLID)
+#include <rl/sg/solid/Model.h>
+#include <rl/sg/solid/Scene.h>
+#elif defined(RL_SG_BULLET)
+#include <rl/sg/bullet/Model.h>
+#include <rl/sg/bullet/Scene.h>
+#elif defined(RL_SG_ODE)
+#include <rl/sg/ode/Model.h>
+#include <rl/sg/ode/Scene.h>
+#endif
+
+/**
+ * Resident set size of the process in bytes, zero if not available.
+ */
+std::size_t
+residentSetSize()
+{
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	
+	while (std::getline(status, line))
+	{
+		if (0 == line.compare(0, 6, "VmRSS:"))
+		{
+			std::size_t size = 0;
+			std::istringstream(line.substr(6)) >> size;
+			return size * 1024;
+		}
+	}
+	
+	return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlRrtTreeDemo SCENEFILE KINEMATICSFILE DURATION START1 ... STARTn" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+#if defined(RL_SG_SOLID)
+		rl::sg::solid::Scene scene;
+#elif defined(RL_SG_BULLET)
+		rl::sg::bullet::Scene scene;
+#elif defined(RL_SG_ODE)
+		rl::sg::ode::Scene scene;
+#endif
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[1], &scene);
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[2]));
+		
+		rl::plan::SimpleModel model;
+		model.mdl = kinematic.get();
+		model.model = scene.getModel(0);
+		model.scene = &scene;
+		
+		rl::plan::KdtreeNearestNeighbors nearestNeighbors(&model);
+		rl::plan::Rrt planner;
+		rl::plan::UniformSampler sampler;
+		
+		planner.model = &model;
+		planner.setNearestNeighbors(&nearestNeighbors, 0);
+		planner.setSampler(&sampler);
+		
+		sampler.setModel(&model);
+		sampler.seed(1);
+		
+		planner.setDelta(1 * rl::math::constants::deg2rad);
+		planner.setDuration(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(boost::lexical_cast<double>(argv[3]))));
+		
+		rl::math::Vector start(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < start.size(); ++i)
+		{
+			start(i) = boost::lexical_cast<rl::math::Real>(argv[i + 4]) * rl::math::constants::deg2rad;
+		}
+		
+		// goal outside of the joint limits, so the tree grows for the whole duration
+		rl::math::Vector goal = kinematic->getMaximum() + rl::math::Vector::Ones(start.size());
+		
+		planner.setStart(&start);
+		planner.setGoal(&goal);
+		
+		std::size_t residentSetSize1 = residentSetSize();
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		planner.solve();
+		std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+		std::size_t residentSetSize2 = residentSetSize();
+		
+		double time = std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count();
+		
+		std::cout << "vertices: " << planner.getNumVertices();
+		std::cout << " edges: " << planner.getNumEdges();
+		std::cout << " time: " << time * 1000 << " ms";
+		std::cout << " vertices/s: " << planner.getNumVertices() / time;
+		
+		if (residentSetSize1 > 0 && residentSetSize2 > residentSetSize1)
+		{
+			std::cout << " bytes/vertex: " << static_cast<double>(residentSetSize2 - residentSetSize1) / planner.getNumVertices();
+		}
+		
+		std::cout << std::endl;
+		
+		return EXIT_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
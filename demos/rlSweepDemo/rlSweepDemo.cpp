@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlSweepDemo MODELFILE [ITERATIONS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Dynamic> dynamic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		
+		std::size_t iterations = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 1000000;
+		
+		dynamic->setPosition(dynamic->generatePositionUniform());
+		dynamic->setVelocity(rl::math::Vector::Random(dynamic->getDof()));
+		dynamic->setAcceleration(rl::math::Vector::Random(dynamic->getDof()));
+		dynamic->setTorque(rl::math::Vector::Random(dynamic->getDof()));
+		
+		// sweeps only, joint positions and velocities are set once
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->forwardPosition();
+		}
+		
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << "forward position: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000000 / iterations << " ns" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->forwardVelocity();
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "forward velocity: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000000 / iterations << " ns" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->forwardAcceleration();
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "forward acceleration: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000000 / iterations << " ns" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->inverseDynamics();
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "inverse dynamics: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000000 / iterations << " ns" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			dynamic->forwardDynamics();
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "forward dynamics: " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000000000 / iterations << " ns" << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/TrackingInverseKinematics.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlTrackingInverseKinematicsDemo KINEMATICSFILE [CYCLES] [BUDGET_US]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Kinematic> kinematics = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(argv[1]));
+		
+		std::size_t cycles = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 10000;
+		
+		rl::mdl::TrackingInverseKinematics ik(kinematics.get());
+		
+		if (argc > 3)
+		{
+			ik.setDuration(std::chrono::microseconds(boost::lexical_cast<std::size_t>(argv[3])));
+		}
+		
+		// smooth joint trajectory sampled every millisecond
+		
+		rl::math::Vector minimum = kinematics->getMinimum();
+		rl::math::Vector maximum = kinematics->getMaximum();
+		
+		std::vector<rl::math::Vector> q(cycles);
+		std::vector<rl::math::Transform> t(cycles);
+		
+		for (std::size_t i = 0; i < cycles; ++i)
+		{
+			q[i].resize(kinematics->getDofPosition());
+			
+			for (std::ptrdiff_t j = 0; j < q[i].size(); ++j)
+			{
+				q[i](j) = (minimum(j) + maximum(j)) / 2 + (maximum(j) - minimum(j)) / 4 * std::sin(2 * rl::math::constants::pi * (j + 1) * i / 10000 + j);
+			}
+			
+			kinematics->setPosition(q[i]);
+			kinematics->forwardPosition();
+			t[i] = kinematics->getOperationalPosition(0);
+		}
+		
+		kinematics->setPosition(q[0]);
+		
+		std::array<double, 9> buckets = {10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+		std::array<std::size_t, 10> histogram = {};
+		std::vector<double> latency;
+		latency.reserve(cycles);
+		std::size_t misses = 0;
+		
+		for (std::size_t i = 0; i < cycles; ++i)
+		{
+			ik.clearGoals();
+			ik.addGoal(t[i], 0);
+			
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			bool solved = ik.solve();
+			std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+			
+			latency.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+			++histogram[std::upper_bound(buckets.begin(), buckets.end(), latency.back()) - buckets.begin()];
+			
+			if (!solved)
+			{
+				++misses;
+			}
+		}
+		
+		std::sort(latency.begin(), latency.end());
+		
+		std::cout << "cycles: " << cycles << ", budget: " << std::chrono::duration<double, std::micro>(ik.getDuration()).count() << " us" << std::endl;
+		std::cout << "latency [us]: p50 " << latency[latency.size() * 50 / 100] << ", p99 " << latency[latency.size() * 99 / 100] << ", max " << latency.back() << std::endl;
+		std::cout << "unsolved: " << misses << std::endl;
+		
+		for (std::size_t i = 0; i < histogram.size(); ++i)
+		{
+			std::cout << (i < buckets.size() ? "< " + std::to_string(static_cast<int>(buckets[i])) : ">= " + std::to_string(static_cast<int>(buckets.back()))) << " us: " << histogram[i] << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -80,7 +80,7 @@ namespace rl
 			 * @param[in] q1 \f$\vec{q}_{1}\f$
 			 * @param[in] q2 \f$\vec{q}_{2}\f$
 			 */
-			virtual ::rl::math::Real distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const;
+			virtual ::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			/**
 			 * Get forward position kinematics.
@@ -283,7 +283,7 @@ namespace rl
 			
 			virtual ::rl::math::Real transformedDistance(const ::rl::math::Real& d) const;
 			
-			virtual ::rl::math::Real transformedDistance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const;
+			virtual ::rl::math::Real transformedDistance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			virtual ::rl::math::Real transformedDistance(const ::rl::math::Real& q1, const ::rl::math::Real& q2, const ::std::size_t& i) const;
 			
@@ -28,6 +28,8 @@
 #define RL_MATH_LINEARNEARESTNEIGHBORS_H
 
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace rl
@@ -36,6 +38,11 @@ namespace rl
 	{
 		/**
 		 * Linear nearest neighbor search.
+		 *
+		 * If the metric provides an operator with signature
+		 * void(const Value&, const Value*, const Value*, Distance*) and the
+		 * container stores its values contiguously, the distances to all
+		 * values are calculated in one call, e.g., to vectorize over values.
 		 */
 		template<typename MetricT, typename ContainerT = ::std::vector<typename MetricT::Value>>
 		class LinearNearestNeighbors
@@ -244,7 +251,61 @@ namespace rl
 				}
 			};
 			
+			template<typename M, typename C>
+			static auto isBatch(int) -> decltype(::std::declval<const M&>()(::std::declval<const Value&>(), ::std::declval<const C&>().data(), ::std::declval<const C&>().data(), ::std::declval<Distance*>()), ::std::true_type());
+			
+			template<typename M, typename C>
+			static ::std::false_type isBatch(...);
+			
 			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+			{
+				return this->search(query, k, radius, sorted, decltype(isBatch<Metric, Container>(0))());
+			}
+			
+			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted, ::std::true_type) const
+			{
+				::std::vector<Neighbor> neighbors;
+				
+				if (this->empty())
+				{
+					return neighbors;
+				}
+				
+				if (nullptr != k)
+				{
+					neighbors.reserve(::std::min(*k, this->size()));
+				}
+				
+				::std::vector<Distance> distances(this->container.size());
+				this->metric(query, this->container.data(), this->container.data() + this->container.size(), distances.data());
+				
+				for (::std::size_t i = 0; i < distances.size(); ++i)
+				{
+					if (nullptr == k || neighbors.size() < *k || distances[i] < neighbors.front().first)
+					{
+						if (nullptr == radius || distances[i] < *radius)
+						{
+							if (nullptr != k && *k == neighbors.size())
+							{
+								::std::pop_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+								neighbors.pop_back();
+							}
+							
+							neighbors.emplace_back(distances[i], this->container[i]);
+							::std::push_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+						}
+					}
+				}
+				
+				if (sorted)
+				{
+					::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+				}
+				
+				return neighbors;
+			}
+			
+			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted, ::std::false_type) const
 			{
 				::std::vector<Neighbor> neighbors;
 				
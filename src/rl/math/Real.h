@@ -37,7 +37,18 @@ namespace rl
 	 */
 	namespace math
 	{
+		/**
+		 * Scalar type of all components, selected with the CMake variable
+		 * RL_MATH_REAL.
+		 *
+		 * The same type is used throughout, there is no mixed-precision mode
+		 * with, e.g., float nearest-neighbor indices next to double dynamics.
+		 */
+#ifdef RL_MATH_REAL_FLOAT
+		typedef float Real;
+#else // RL_MATH_REAL_FLOAT
 		typedef double Real;
+#endif // RL_MATH_REAL_FLOAT
 	}
 }
 
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cstddef>
+#include <Eigen/Core>
+
+#include "AllocationGuard.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		namespace
+		{
+			thread_local ::std::size_t depth = 0;
+		}
+		
+		AllocationGuard::AllocationGuard() :
+			allowed(true)
+		{
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+			this->allowed = ::Eigen::internal::is_malloc_allowed();
+			::Eigen::internal::set_is_malloc_allowed(false);
+#endif // EIGEN_RUNTIME_NO_MALLOC
+			++depth;
+		}
+		
+		AllocationGuard::~AllocationGuard()
+		{
+			--depth;
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+			::Eigen::internal::set_is_malloc_allowed(this->allowed);
+#endif // EIGEN_RUNTIME_NO_MALLOC
+		}
+		
+		bool
+		AllocationGuard::isActive()
+		{
+			return depth > 0;
+		}
+	}
+}
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_ALLOCATIONGUARD_H
+#define RL_MDL_ALLOCATIONGUARD_H
+
+#include <rl/mdl/export.h>
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Marks a region of code that must not allocate heap memory.
+		 * 
+		 * Intended for real-time control loops that evaluate a model with
+		 * preallocated vectors and matrices, e.g., Model::setPosition(),
+		 * Dynamic::forwardDynamics() and Model::getAcceleration(::rl::math::VectorRef) const.
+		 * 
+		 * If the library is built with RL_BUILD_MDL_NO_MALLOC and assertions,
+		 * it is compiled with EIGEN_RUNTIME_NO_MALLOC and any Eigen
+		 * allocation of the library inside the guarded region triggers an
+		 * assertion. Targets linking to the library are not affected.
+		 * Otherwise, the guard only tracks the nesting depth, which can be
+		 * queried via isActive() to check allocators, e.g., in replacements
+		 * of malloc or the global operator new.
+		 * 
+		 * Eigen's allocation flag is global to the process. Only use the
+		 * guard while no other thread is allocating Eigen objects within
+		 * the library.
+		 */
+		class RL_MDL_EXPORT AllocationGuard
+		{
+		public:
+			AllocationGuard();
+			
+			AllocationGuard(const AllocationGuard&) = delete;
+			
+			virtual ~AllocationGuard();
+			
+			/**
+			 * Check if the calling thread is inside a guarded region.
+			 */
+			static bool isActive();
+			
+			AllocationGuard& operator=(const AllocationGuard&) = delete;
+			
+		protected:
+			
+		private:
+			bool allowed;
+		};
+	}
+}
+
+#endif // RL_MDL_ALLOCATIONGUARD_H
@@ -24,7 +24,10 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <limits>
+
 #include "AnalyticalInverseKinematics.h"
+#include "Kinematic.h"
 
 namespace rl
 {
@@ -40,10 +43,59 @@ namespace rl
 		{
 		}
 		
+		void
+		AnalyticalInverseKinematics::addSolution(::rl::math::Vector q)
+		{
+			this->kinematic->normalize(q);
+			
+			if (!this->kinematic->isValid(q))
+			{
+				return;
+			}
+			
+			for (::std::size_t i = 0; i < this->solutions.size(); ++i)
+			{
+				if ((this->solutions[i] - q).squaredNorm() < ::std::numeric_limits<::rl::math::Real>::epsilon())
+				{
+					return;
+				}
+			}
+			
+			this->solutions.push_back(q);
+		}
+		
 		const ::std::vector<::rl::math::Vector>&
 		AnalyticalInverseKinematics::getSolutions() const
 		{
 			return this->solutions;
 		}
+		
+		bool
+		AnalyticalInverseKinematics::setClosestSolution()
+		{
+			if (this->solutions.empty())
+			{
+				return false;
+			}
+			
+			::rl::math::Vector q = this->kinematic->getPosition();
+			::std::size_t closest = 0;
+			::rl::math::Real closestDistance = ::std::numeric_limits<::rl::math::Real>::infinity();
+			
+			for (::std::size_t i = 0; i < this->solutions.size(); ++i)
+			{
+				::rl::math::Real distance = this->kinematic->distance(q, this->solutions[i]);
+				
+				if (distance < closestDistance)
+				{
+					closest = i;
+					closestDistance = distance;
+				}
+			}
+			
+			this->kinematic->setPosition(this->solutions[closest]);
+			
+			return true;
+		}
 	}
 }
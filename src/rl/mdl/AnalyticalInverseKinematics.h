@@ -43,6 +43,19 @@ namespace rl
 			const ::std::vector<::rl::math::Vector>& getSolutions() const;
 			
 		protected:
+			/**
+			 * Normalize joint position and add it to solutions if it is
+			 * within joint limits and not yet present.
+			 */
+			void addSolution(::rl::math::Vector q);
+			
+			/**
+			 * Set joint position to the solution closest to the current one.
+			 *
+			 * @return False if there are no solutions
+			 */
+			bool setClosestSolution();
+			
 			::std::vector<::rl::math::Vector> solutions;
 			
 		private:
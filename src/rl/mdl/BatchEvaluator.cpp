@@ -0,0 +1,395 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cassert>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+#include "BatchEvaluator.h"
+#include "Dynamic.h"
+#include "Exception.h"
+#include "Kinematic.h"
+#include "Prismatic.h"
+#include "Revolute.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		BatchEvaluator::BatchEvaluator(Kinematic* kinematic, const ::std::size_t& threads) :
+			copies(),
+			kinematic(kinematic),
+			links(),
+			operationals(),
+			pool(threads),
+			vectorized(false),
+			world()
+		{
+			this->update();
+		}
+		
+		BatchEvaluator::~BatchEvaluator()
+		{
+		}
+		
+		void
+		BatchEvaluator::calculateJacobian(const ::rl::math::Matrix& Q, ::rl::math::Matrix& J, const bool& inWorldFrame)
+		{
+			assert(Q.rows() == this->kinematic->getDofPosition());
+			
+			::std::size_t dof = this->kinematic->getDof();
+			J.resize(6 * this->kinematic->getOperationalDof(), dof * Q.cols());
+			
+			this->run(Q.cols(), [&](Kinematic* kinematic, const ::std::size_t& begin, const ::std::size_t& end) {
+				::rl::math::Vector q(Q.rows());
+				
+				for (::std::size_t k = begin; k < end; ++k)
+				{
+					q = Q.col(k);
+					kinematic->setPosition(q);
+					kinematic->calculateJacobian(J.middleCols(k * dof, dof), inWorldFrame);
+				}
+			});
+		}
+		
+		void
+		BatchEvaluator::forwardPosition(const ::rl::math::Matrix& Q, ::rl::math::Matrix& X)
+		{
+			assert(Q.rows() == this->kinematic->getDofPosition());
+			
+			X.resize(16 * this->kinematic->getOperationalDof(), Q.cols());
+			
+			if (this->vectorized)
+			{
+				this->run(Q.cols(), [&](Kinematic*, const ::std::size_t& begin, const ::std::size_t& end) {
+					this->forwardPositionVectorized(Q, begin, end, X);
+				});
+				return;
+			}
+			
+			this->run(Q.cols(), [&](Kinematic* kinematic, const ::std::size_t& begin, const ::std::size_t& end) {
+				::rl::math::Vector q(Q.rows());
+				
+				for (::std::size_t k = begin; k < end; ++k)
+				{
+					q = Q.col(k);
+					kinematic->setPosition(q);
+					kinematic->forwardPosition();
+					
+					for (::std::size_t i = 0; i < kinematic->getOperationalDof(); ++i)
+					{
+						::Eigen::Map<::rl::math::Matrix44>(X.col(k).data() + 16 * i) = kinematic->getOperationalPosition(i).matrix();
+					}
+				}
+			});
+		}
+		
+		void
+		BatchEvaluator::forwardPositionVectorized(const ::rl::math::Matrix& Q, const ::std::size_t& begin, const ::std::size_t& end, ::rl::math::Matrix& X) const
+		{
+			::std::size_t world = this->links.size();
+			
+			Coefficients positions;
+			Coefficients transform(12, blockSize);
+			Coefficients x(12, blockSize);
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> angle(blockSize);
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> c(blockSize);
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> s(blockSize);
+			
+			for (::std::size_t k = begin; k < end; k += blockSize)
+			{
+				::std::size_t n = ::std::min(blockSize, end - k);
+				
+				positions.resize(12 * (this->links.size() + 1), n);
+				transform.resize(12, n);
+				x.resize(12, n);
+				angle.resize(n);
+				c.resize(n);
+				s.resize(n);
+				
+				for (::std::ptrdiff_t row = 0; row < 3; ++row)
+				{
+					for (::std::ptrdiff_t col = 0; col < 3; ++col)
+					{
+						positions.row(12 * world + 3 * row + col).setConstant(this->world.linear()(row, col));
+					}
+					
+					positions.row(12 * world + 9 + row).setConstant(this->world.translation()(row));
+				}
+				
+				for (::std::size_t i = 0; i < this->links.size(); ++i)
+				{
+					const Link& link = this->links[i];
+					
+					angle = Q.row(i).segment(k, n).array() + link.offset;
+					
+					if (link.revolute)
+					{
+						// R * (a * a^T + cos * (1 - a * a^T) + sin * a x)
+						
+						c = angle.cos();
+						s = angle.sin();
+						
+						for (::std::ptrdiff_t row = 0; row < 3; ++row)
+						{
+							for (::std::ptrdiff_t col = 0; col < 3; ++col)
+							{
+								transform.row(3 * row + col) = link.constant(row, col) + link.cosine(row, col) * c + link.sine(row, col) * s;
+							}
+							
+							transform.row(9 + row).setConstant(link.translation(row));
+						}
+					}
+					else
+					{
+						// t + R * d * (q + offset)
+						
+						for (::std::ptrdiff_t row = 0; row < 3; ++row)
+						{
+							for (::std::ptrdiff_t col = 0; col < 3; ++col)
+							{
+								transform.row(3 * row + col).setConstant(link.constant(row, col));
+							}
+							
+							transform.row(9 + row) = link.translation(row) + link.direction(row) * angle;
+						}
+					}
+					
+					multiply(positions, link.parent, transform, 0, positions, i);
+				}
+				
+				for (::std::size_t i = 0; i < this->operationals.size(); ++i)
+				{
+					const Operational& operational = this->operationals[i];
+					
+					for (::std::ptrdiff_t row = 0; row < 3; ++row)
+					{
+						for (::std::ptrdiff_t col = 0; col < 3; ++col)
+						{
+							transform.row(3 * row + col).setConstant(operational.transform.linear()(row, col));
+						}
+						
+						transform.row(9 + row).setConstant(operational.transform.translation()(row));
+					}
+					
+					multiply(positions, operational.parent, transform, 0, x, 0);
+					
+					for (::std::ptrdiff_t col = 0; col < 4; ++col)
+					{
+						for (::std::ptrdiff_t row = 0; row < 3; ++row)
+						{
+							X.row(16 * i + 4 * col + row).segment(k, n) = x.row(col < 3 ? 3 * row + col : 9 + row).matrix();
+						}
+						
+						X.row(16 * i + 4 * col + 3).segment(k, n).setConstant(col < 3 ? 0 : 1);
+					}
+				}
+			}
+		}
+		
+		Kinematic*
+		BatchEvaluator::getKinematic() const
+		{
+			return this->kinematic;
+		}
+		
+		::std::size_t
+		BatchEvaluator::getThreads() const
+		{
+			return this->pool.size();
+		}
+		
+		void
+		BatchEvaluator::inverseDynamics(const ::rl::math::Matrix& Q, const ::rl::math::Matrix& Qd, const ::rl::math::Matrix& Qdd, ::rl::math::Matrix& Tau)
+		{
+			assert(Q.rows() == this->kinematic->getDofPosition());
+			assert(Qd.rows() == this->kinematic->getDof());
+			assert(Qdd.rows() == this->kinematic->getDof());
+			assert(Qd.cols() == Q.cols());
+			assert(Qdd.cols() == Q.cols());
+			
+			if (nullptr == dynamic_cast<Dynamic*>(this->kinematic))
+			{
+				throw Exception("rl::mdl::BatchEvaluator::inverseDynamics() - Model is not an instance of rl::mdl::Dynamic");
+			}
+			
+			Tau.resize(this->kinematic->getDof(), Q.cols());
+			
+			this->run(Q.cols(), [&](Kinematic* kinematic, const ::std::size_t& begin, const ::std::size_t& end) {
+				Dynamic* dynamic = static_cast<Dynamic*>(kinematic);
+				::rl::math::Vector q(Q.rows());
+				::rl::math::Vector qd(Qd.rows());
+				::rl::math::Vector qdd(Qdd.rows());
+				
+				for (::std::size_t k = begin; k < end; ++k)
+				{
+					q = Q.col(k);
+					qd = Qd.col(k);
+					qdd = Qdd.col(k);
+					dynamic->setPosition(q);
+					dynamic->setVelocity(qd);
+					dynamic->setAcceleration(qdd);
+					dynamic->inverseDynamics();
+					dynamic->getTorque(Tau.col(k));
+				}
+			});
+		}
+		
+		void
+		BatchEvaluator::multiply(const Coefficients& a, const ::std::size_t& i, const Coefficients& b, const ::std::size_t& j, Coefficients& c, const ::std::size_t& k)
+		{
+			for (::std::ptrdiff_t row = 0; row < 3; ++row)
+			{
+				for (::std::ptrdiff_t col = 0; col < 3; ++col)
+				{
+					c.row(12 * k + 3 * row + col) =
+						a.row(12 * i + 3 * row) * b.row(12 * j + col) +
+						a.row(12 * i + 3 * row + 1) * b.row(12 * j + 3 + col) +
+						a.row(12 * i + 3 * row + 2) * b.row(12 * j + 6 + col);
+				}
+				
+				c.row(12 * k + 9 + row) =
+					a.row(12 * i + 3 * row) * b.row(12 * j + 9) +
+					a.row(12 * i + 3 * row + 1) * b.row(12 * j + 10) +
+					a.row(12 * i + 3 * row + 2) * b.row(12 * j + 11) +
+					a.row(12 * i + 9 + row);
+			}
+		}
+		
+		void
+		BatchEvaluator::run(const ::std::size_t& n, const ::std::function<void(Kinematic*, const ::std::size_t&, const ::std::size_t&)>& function)
+		{
+			::std::size_t threads = ::std::max<::std::size_t>(::std::min(this->pool.size(), n), 1);
+			
+			this->pool.run(threads, [&](const ::std::size_t& i) {
+				function(this->copies[i].get(), i * n / threads, (i + 1) * n / threads);
+			});
+		}
+		
+		void
+		BatchEvaluator::update()
+		{
+			this->copies.clear();
+			this->copies.reserve(this->pool.size());
+			
+			for (::std::size_t i = 0; i < this->pool.size(); ++i)
+			{
+				this->copies.emplace_back(static_cast<Kinematic*>(this->kinematic->clone()));
+			}
+			
+			this->links.clear();
+			this->operationals.clear();
+			this->vectorized = false;
+			
+			if (!this->kinematic->getGammaPosition().isIdentity())
+			{
+				return;
+			}
+			
+			for (::std::size_t i = 0; i < this->kinematic->getJoints(); ++i)
+			{
+				Joint* joint = this->kinematic->getJoint(i);
+				
+				if (typeid(*joint) != typeid(Revolute) && typeid(*joint) != typeid(Prismatic))
+				{
+					return;
+				}
+			}
+			
+			// link of each frame and transform to it, links are numbered like
+			// joints and the number of joints denotes the world
+			
+			::std::unordered_map<const Frame*, ::std::pair<::std::size_t, ::std::size_t>> frames;
+			::std::vector<::rl::math::Transform, ::Eigen::aligned_allocator<::rl::math::Transform>> transforms(this->kinematic->getFrames(), ::rl::math::Transform::Identity());
+			
+			for (::std::size_t i = 0; i < this->kinematic->getFrames(); ++i)
+			{
+				frames[this->kinematic->getFrame(i)] = ::std::make_pair(this->kinematic->getJoints(), i);
+			}
+			
+			for (::std::size_t i = 0; i < this->kinematic->getTransforms(); ++i)
+			{
+				Transform* transform = this->kinematic->getTransform(i);
+				::std::pair<::std::size_t, ::std::size_t>& in = frames.at(transform->in);
+				::std::pair<::std::size_t, ::std::size_t>& out = frames.at(transform->out);
+				
+				if (Joint* joint = dynamic_cast<Joint*>(transform))
+				{
+					const ::rl::math::Transform& t = transforms[in.second];
+					
+					Link link;
+					link.offset = joint->getOffset()(0);
+					link.parent = in.first;
+					link.revolute = typeid(*joint) == typeid(Revolute);
+					link.translation = t.translation();
+					
+					if (link.revolute)
+					{
+						::rl::math::Vector3 axis = joint->S.block<3, 1>(0, 0);
+						link.constant = t.linear() * axis * axis.transpose();
+						link.cosine = t.linear() * (::rl::math::Matrix33::Identity() - axis * axis.transpose());
+						link.direction.setZero();
+						link.sine = t.linear() * axis.cross33();
+					}
+					else
+					{
+						link.constant = t.linear();
+						link.cosine.setZero();
+						link.direction = t.linear() * joint->S.block<3, 1>(3, 0);
+						link.sine.setZero();
+					}
+					
+					out.first = this->links.size();
+					transforms[out.second].setIdentity();
+					
+					this->links.push_back(link);
+				}
+				else
+				{
+					out.first = in.first;
+					transforms[out.second] = transforms[in.second] * transform->x.transform();
+				}
+			}
+			
+			for (::std::size_t i = 0; i < this->kinematic->getOperationalDof(); ++i)
+			{
+				const ::std::pair<::std::size_t, ::std::size_t>& frame = frames.at(this->kinematic->getOperationalFrame(i));
+				
+				Operational operational;
+				operational.parent = frame.first;
+				operational.transform = transforms[frame.second];
+				
+				this->operationals.push_back(operational);
+			}
+			
+			this->world = this->kinematic->world();
+			this->vectorized = true;
+		}
+	}
+}
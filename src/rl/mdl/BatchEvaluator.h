@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_BATCHEVALUATOR_H
+#define RL_MDL_BATCHEVALUATOR_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <rl/math/Matrix.h>
+#include <rl/math/Transform.h>
+#include <rl/math/Vector.h>
+#include <rl/mdl/export.h>
+#include <rl/util/ThreadPool.h>
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Kinematic;
+		
+		/**
+		 * Evaluate kinematics and dynamics for a batch of configurations.
+		 *
+		 * Configurations are given as columns of column-major matrices. The batch
+		 * is split into contiguous ranges of columns, each range is evaluated in
+		 * a separate thread of a pool that is kept alive between calls on its
+		 * own copy of the model. The original model is not modified.
+		 *
+		 * For models with uncoupled revolute and prismatic joints, forward
+		 * position is evaluated across samples: joint transforms and their
+		 * products are stored as one array of samples per matrix coefficient,
+		 * so every operation is vectorized over a block of samples. Jacobians,
+		 * inverse dynamics, and forward position of other models evaluate one
+		 * sample after another with the recursive algorithms of the model.
+		 */
+		class RL_MDL_EXPORT BatchEvaluator
+		{
+		public:
+			EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+			
+			/**
+			 * @param[in] kinematic Model copied for each thread
+			 * @param[in] threads Number of threads, hardware concurrency if zero
+			 */
+			BatchEvaluator(Kinematic* kinematic, const ::std::size_t& threads = 0);
+			
+			virtual ~BatchEvaluator();
+			
+			/**
+			 * Calculate Jacobian matrices for a batch of configurations.
+			 *
+			 * @param[in] Q Joint positions, one column per sample
+			 * @param[out] J Jacobian matrices with getOperationalDof() * 6 rows,
+			 * sample k in columns [k * getDof(), (k + 1) * getDof())
+			 * @param[in] inWorldFrame Calculate in world or tool frame
+			 *
+			 * @see Kinematic::calculateJacobian(::rl::math::MatrixRef, const bool&)
+			 */
+			void calculateJacobian(const ::rl::math::Matrix& Q, ::rl::math::Matrix& J, const bool& inWorldFrame = true);
+			
+			/**
+			 * Calculate operational positions for a batch of configurations.
+			 *
+			 * @param[in] Q Joint positions, one column per sample
+			 * @param[out] X Column-major homogeneous 4x4 matrices of all
+			 * operational frames, 16 * getOperationalDof() rows per sample
+			 *
+			 * @see Kinematic::forwardPosition()
+			 */
+			void forwardPosition(const ::rl::math::Matrix& Q, ::rl::math::Matrix& X);
+			
+			Kinematic* getKinematic() const;
+			
+			::std::size_t getThreads() const;
+			
+			/**
+			 * Calculate joint torques for a batch of states.
+			 *
+			 * @param[in] Q Joint positions, one column per sample
+			 * @param[in] Qd Joint velocities, one column per sample
+			 * @param[in] Qdd Joint accelerations, one column per sample
+			 * @param[out] Tau Joint torques, one column per sample
+			 *
+			 * @pre Model is an instance of Dynamic
+			 *
+			 * @see Dynamic::inverseDynamics()
+			 */
+			void inverseDynamics(const ::rl::math::Matrix& Q, const ::rl::math::Matrix& Qd, const ::rl::math::Matrix& Qdd, ::rl::math::Matrix& Tau);
+			
+			/**
+			 * Update copies of model and extracted joints after it has been
+			 * modified.
+			 */
+			void update();
+			
+		protected:
+			
+		private:
+			/** Coefficients of a matrix, one row of samples per coefficient. */
+			typedef ::Eigen::Array<::rl::math::Real, ::Eigen::Dynamic, ::Eigen::Dynamic, ::Eigen::RowMajor> Coefficients;
+			
+			struct Link
+			{
+				EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+				
+				/** Rotation independent of joint position. */
+				::rl::math::Matrix33 constant;
+				
+				/** Rotation proportional to cosine of revolute joint position. */
+				::rl::math::Matrix33 cosine;
+				
+				/** Translation proportional to prismatic joint position. */
+				::rl::math::Vector3 direction;
+				
+				/** Joint offset. */
+				::rl::math::Real offset;
+				
+				/** Index of parent link, number of links for world. */
+				::std::size_t parent;
+				
+				bool revolute;
+				
+				/** Rotation proportional to sine of revolute joint position. */
+				::rl::math::Matrix33 sine;
+				
+				/** Translation independent of joint position. */
+				::rl::math::Vector3 translation;
+			};
+			
+			struct Operational
+			{
+				EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+				
+				/** Index of parent link, number of links for world. */
+				::std::size_t parent;
+				
+				/** Transform from parent link to operational frame. */
+				::rl::math::Transform transform;
+			};
+			
+			/**
+			 * Multiply transforms of a block of samples.
+			 *
+			 * Transforms use rows [12 * i, 12 * i + 12) with the row-major
+			 * rotation followed by the translation.
+			 */
+			static void multiply(const Coefficients& a, const ::std::size_t& i, const Coefficients& b, const ::std::size_t& j, Coefficients& c, const ::std::size_t& k);
+			
+			void forwardPositionVectorized(const ::rl::math::Matrix& Q, const ::std::size_t& begin, const ::std::size_t& end, ::rl::math::Matrix& X) const;
+			
+			void run(const ::std::size_t& n, const ::std::function<void(Kinematic*, const ::std::size_t&, const ::std::size_t&)>& function);
+			
+			/** Number of samples evaluated together in one vectorized block. */
+			static constexpr ::std::size_t blockSize = 64;
+			
+			::std::vector<::std::unique_ptr<Kinematic>> copies;
+			
+			Kinematic* kinematic;
+			
+			::std::vector<Link, ::Eigen::aligned_allocator<Link>> links;
+			
+			::std::vector<Operational, ::Eigen::aligned_allocator<Operational>> operationals;
+			
+			::rl::util::ThreadPool pool;
+			
+			/** Forward position can be evaluated across samples. */
+			bool vectorized;
+			
+			::rl::math::Transform world;
+		};
+	}
+}
+
+#endif // RL_MDL_BATCHEVALUATOR_H
@@ -47,6 +47,19 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Frame>
+		Body::clone() const
+		{
+			return ::std::make_shared<Body>(*this);
+		}
+		
+		void
+		Body::compositeRigidBody1()
+		{
+			// X_0^* * I * X_0
+			this->iC = this->x / this->i;
+		}
+		
 		void
 		Body::forwardAcceleration()
 		{
@@ -105,6 +118,26 @@ namespace rl
 		{
 		}
 		
+		void
+		Body::inverseDynamicsDerivatives1()
+		{
+			this->inverseDynamics1();
+			
+			// X_0^* * I * X_0
+			this->iC = this->x / this->i;
+			// X_0^-1 * v
+			::rl::math::MotionVector v = this->x / this->v;
+			// I * v
+			::rl::math::ForceVector h = this->iC * v;
+			// I * a + v x I * v
+			this->fC = this->iC * (this->x / this->a) + v.cross(h);
+			// v x* I - I * v x + (x* h)
+			this->bC = v.cross66Force() * this->iC.matrix() - this->iC.matrix() * v.cross66Motion();
+			this->bC.topLeftCorner<3, 3>() -= h.moment().cross33();
+			this->bC.topRightCorner<3, 3>() -= h.force().cross33();
+			this->bC.bottomLeftCorner<3, 3>() -= h.force().cross33();
+		}
+		
 		void
 		Body::setCenterOfMass(const ::rl::math::Real& x, const ::rl::math::Real& y, const ::rl::math::Real& z)
 		{
@@ -42,6 +42,10 @@ namespace rl
 			
 			virtual ~Body();
 			
+			::std::shared_ptr<Frame> clone() const;
+			
+			void compositeRigidBody1();
+			
 			void forwardAcceleration();
 			
 			void forwardDynamics1();
@@ -62,6 +66,8 @@ namespace rl
 			
 			void inverseDynamics2();
 			
+			void inverseDynamicsDerivatives1();
+			
 			void setCenterOfMass(const ::rl::math::Real& x, const ::rl::math::Real& y, const ::rl::math::Real& z);
 			
 			void setCollision(const bool& collision);
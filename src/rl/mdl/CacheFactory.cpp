@@ -0,0 +1,794 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <rl/xml/Document.h>
+#include <rl/xml/DomParser.h>
+#include <rl/xml/Exception.h>
+#include <rl/xml/Namespace.h>
+#include <rl/xml/Node.h>
+
+#include "Body.h"
+#include "CacheFactory.h"
+#include "Cylindrical.h"
+#include "Exception.h"
+#include "Fixed.h"
+#include "Helical.h"
+#include "Model.h"
+#include "Prismatic.h"
+#include "Revolute.h"
+#include "SixDof.h"
+#include "Spherical.h"
+#include "World.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		namespace
+		{
+			const char magic[8] = {'r', 'l', 'm', 'd', 'l', 'c', 'h', '2'};
+			
+			enum class FrameType : ::std::uint8_t
+			{
+				body,
+				frame,
+				world
+			};
+			
+			enum class TransformType : ::std::uint8_t
+			{
+				cylindrical,
+				fixed,
+				helical,
+				prismatic,
+				revolute,
+				sixDof,
+				spherical,
+				transform
+			};
+			
+			struct Header
+			{
+				char magic[8];
+				
+				::std::uint64_t size;
+			};
+			
+			class Reader
+			{
+			public:
+				Reader(const char* begin, const char* end) :
+					begin(begin),
+					end(end)
+				{
+				}
+				
+				bool atEnd() const
+				{
+					return this->begin == this->end;
+				}
+				
+				template<typename Derived>
+				void getMatrix(::Eigen::PlainObjectBase<Derived>& matrix, const bool& resize)
+				{
+					::std::uint64_t rows = this->getValue<::std::uint64_t>();
+					::std::uint64_t cols = this->getValue<::std::uint64_t>();
+					
+					if (resize)
+					{
+						if (rows * cols * sizeof(double) > static_cast<::std::uint64_t>(this->end - this->begin))
+						{
+							throw Exception("rl::mdl::CacheFactory::read() - Invalid matrix size");
+						}
+						
+						matrix.resize(rows, cols);
+					}
+					else if (rows != static_cast<::std::uint64_t>(matrix.rows()) || cols != static_cast<::std::uint64_t>(matrix.cols()))
+					{
+						throw Exception("rl::mdl::CacheFactory::read() - Invalid matrix size");
+					}
+					
+					for (::std::ptrdiff_t j = 0; j < matrix.cols(); ++j)
+					{
+						for (::std::ptrdiff_t i = 0; i < matrix.rows(); ++i)
+						{
+							matrix(i, j) = static_cast<typename Derived::Scalar>(this->getValue<double>());
+						}
+					}
+				}
+				
+				::std::string getString()
+				{
+					::std::uint64_t size = this->getValue<::std::uint64_t>();
+					
+					if (size > static_cast<::std::uint64_t>(this->end - this->begin))
+					{
+						throw Exception("rl::mdl::CacheFactory::read() - Invalid string size");
+					}
+					
+					::std::string value(this->begin, size);
+					this->begin += size;
+					return value;
+				}
+				
+				template<typename T>
+				T getValue()
+				{
+					if (sizeof(T) > static_cast<::std::size_t>(this->end - this->begin))
+					{
+						throw Exception("rl::mdl::CacheFactory::read() - Unexpected end of file");
+					}
+					
+					T value;
+					::std::memcpy(&value, this->begin, sizeof(T));
+					this->begin += sizeof(T);
+					return value;
+				}
+				
+			private:
+				const char* begin;
+				
+				const char* end;
+			};
+			
+			class Writer
+			{
+			public:
+				Writer() :
+					buffer()
+				{
+				}
+				
+				const ::std::string& getBuffer() const
+				{
+					return this->buffer;
+				}
+				
+				template<typename Derived>
+				void putMatrix(const ::Eigen::DenseBase<Derived>& matrix)
+				{
+					this->putValue<::std::uint64_t>(matrix.rows());
+					this->putValue<::std::uint64_t>(matrix.cols());
+					
+					for (::std::ptrdiff_t j = 0; j < matrix.cols(); ++j)
+					{
+						for (::std::ptrdiff_t i = 0; i < matrix.rows(); ++i)
+						{
+							this->putValue<double>(matrix(i, j));
+						}
+					}
+				}
+				
+				void putString(const ::std::string& value)
+				{
+					this->putValue<::std::uint64_t>(value.size());
+					this->buffer.append(value);
+				}
+				
+				template<typename T>
+				void putValue(const T& value)
+				{
+					this->buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+				}
+				
+			private:
+				::std::string buffer;
+			};
+			
+			::std::shared_ptr<Transform>
+			createTransform(const TransformType& type)
+			{
+				switch (type)
+				{
+				case TransformType::cylindrical:
+					return ::std::make_shared<Cylindrical>();
+				case TransformType::fixed:
+					return ::std::make_shared<Fixed>();
+				case TransformType::helical:
+					return ::std::make_shared<Helical>();
+				case TransformType::prismatic:
+					return ::std::make_shared<Prismatic>();
+				case TransformType::revolute:
+					return ::std::make_shared<Revolute>();
+				case TransformType::sixDof:
+					return ::std::make_shared<SixDof>();
+				case TransformType::spherical:
+					return ::std::make_shared<Spherical>();
+				case TransformType::transform:
+					return ::std::make_shared<Transform>();
+				default:
+					throw Exception("rl::mdl::CacheFactory::read() - Invalid transform type");
+				}
+			}
+			
+			TransformType
+			getTransformType(const Transform* transform)
+			{
+				if (typeid(*transform) == typeid(Cylindrical))
+				{
+					return TransformType::cylindrical;
+				}
+				else if (typeid(*transform) == typeid(Fixed))
+				{
+					return TransformType::fixed;
+				}
+				else if (typeid(*transform) == typeid(Helical))
+				{
+					return TransformType::helical;
+				}
+				else if (typeid(*transform) == typeid(Prismatic))
+				{
+					return TransformType::prismatic;
+				}
+				else if (typeid(*transform) == typeid(Revolute))
+				{
+					return TransformType::revolute;
+				}
+				else if (typeid(*transform) == typeid(SixDof))
+				{
+					return TransformType::sixDof;
+				}
+				else if (typeid(*transform) == typeid(Spherical))
+				{
+					return TransformType::spherical;
+				}
+				else if (typeid(*transform) == typeid(Transform))
+				{
+					return TransformType::transform;
+				}
+				
+				throw Exception("rl::mdl::CacheFactory::write() - Unsupported transform type of " + transform->getName());
+			}
+			
+			void collectDependencies(const ::std::string& filename, const bool& xml, ::std::vector<::std::pair<::std::string, ::std::uint64_t>>& dependencies);
+			
+			void collectDependencies(const ::rl::xml::Node& node, ::std::vector<::std::pair<::std::string, ::std::uint64_t>>& dependencies)
+			{
+				if (
+					node.hasNamespace() &&
+					("http://www.w3.org/2001/XInclude" == node.getNamespace().getHref() || "http://www.w3.org/2003/XInclude" == node.getNamespace().getHref()) &&
+					"include" == node.getName()
+				)
+				{
+					::std::string href = node.getProperty("href");
+					
+					if (!href.empty())
+					{
+						collectDependencies(node.getLocalPath(href), "text" != node.getProperty("parse"), dependencies);
+					}
+					
+					return;
+				}
+				
+				for (::rl::xml::Node child = node.getFirstChild(); nullptr != child.get(); child = child.getNext())
+				{
+					collectDependencies(child, dependencies);
+				}
+			}
+			
+			void collectDependencies(const ::std::string& filename, const bool& xml, ::std::vector<::std::pair<::std::string, ::std::uint64_t>>& dependencies)
+			{
+				for (::std::size_t i = 0; i < dependencies.size(); ++i)
+				{
+					if (filename == dependencies[i].first)
+					{
+						return;
+					}
+				}
+				
+				dependencies.push_back(::std::make_pair(filename, CacheFactory::hash(filename)));
+				
+				if (!xml)
+				{
+					return;
+				}
+				
+				try
+				{
+					::rl::xml::DomParser parser;
+					::rl::xml::Document document = parser.readFile(filename, "", XML_PARSE_NOENT);
+					collectDependencies(document.getRootElement(), dependencies);
+				}
+				catch (const ::rl::xml::Exception& e)
+				{
+					throw Exception("rl::mdl::CacheFactory::getDependencies() - Could not read file " + filename + ": " + e.what());
+				}
+			}
+		}
+		
+		CacheFactory::CacheFactory(Factory* factory, const ::std::string& directory) :
+			Factory(),
+			directory(directory),
+			factory(factory),
+			hit(false)
+		{
+		}
+		
+		CacheFactory::~CacheFactory()
+		{
+		}
+		
+		::std::string
+		CacheFactory::getCacheFilename(const ::std::string& filename) const
+		{
+			if (this->directory.empty())
+			{
+				return filename + ".cache";
+			}
+			
+			::std::string::size_type separator = filename.find_last_of("/\\");
+			
+			return this->directory + "/" + (::std::string::npos == separator ? filename : filename.substr(separator + 1)) + ".cache";
+		}
+		
+		const ::std::string&
+		CacheFactory::getDirectory() const
+		{
+			return this->directory;
+		}
+		
+		Factory*
+		CacheFactory::getFactory() const
+		{
+			return this->factory;
+		}
+		
+		::std::vector<::std::pair<::std::string, ::std::uint64_t>>
+		CacheFactory::getDependencies(const ::std::string& filename)
+		{
+			::std::vector<::std::pair<::std::string, ::std::uint64_t>> dependencies;
+			collectDependencies(filename, true, dependencies);
+			return dependencies;
+		}
+		
+		::std::uint64_t
+		CacheFactory::hash(const ::std::string& filename)
+		{
+			::std::ifstream file(filename.c_str(), ::std::ios::binary);
+			
+			if (!file)
+			{
+				throw Exception("rl::mdl::CacheFactory::hash() - Could not read file " + filename);
+			}
+			
+			::std::uint64_t hash = 14695981039346656037ULL;
+			char buffer[4096];
+			
+			do
+			{
+				file.read(buffer, sizeof(buffer));
+				
+				for (::std::streamsize i = 0; i < file.gcount(); ++i)
+				{
+					hash ^= static_cast<unsigned char>(buffer[i]);
+					hash *= 1099511628211ULL;
+				}
+			}
+			while (file);
+			
+			if (!file.eof())
+			{
+				throw Exception("rl::mdl::CacheFactory::hash() - Could not read file " + filename);
+			}
+			
+			return hash;
+		}
+		
+		bool
+		CacheFactory::isHit() const
+		{
+			return this->hit;
+		}
+		
+		void
+		CacheFactory::load(const ::std::string& filename, Model* model)
+		{
+			::std::string cache = this->getCacheFilename(filename);
+			
+			this->hit = this->read(cache, filename, model);
+			
+			if (this->hit)
+			{
+				return;
+			}
+			
+			// hash before loading, a file modified in between is then
+			// detected on the next call
+			::std::vector<::std::pair<::std::string, ::std::uint64_t>> dependencies = CacheFactory::getDependencies(filename);
+			
+			this->factory->load(filename, model);
+			
+			try
+			{
+				this->write(cache, dependencies, model);
+			}
+			catch (const Exception&)
+			{
+			}
+		}
+		
+		bool
+		CacheFactory::read(const ::std::string& filename, const ::std::string& source, Model* model) const
+		{
+			::std::shared_ptr<::boost::interprocess::mapped_region> region;
+			
+			try
+			{
+				::boost::interprocess::file_mapping file(filename.c_str(), ::boost::interprocess::read_only);
+				region = ::std::make_shared<::boost::interprocess::mapped_region>(file, ::boost::interprocess::read_only);
+			}
+			catch (const ::boost::interprocess::interprocess_exception&)
+			{
+				return false;
+			}
+			
+			const char* image = static_cast<const char*>(region->get_address());
+			
+			if (region->get_size() < sizeof(Header))
+			{
+				return false;
+			}
+			
+			Header header;
+			::std::memcpy(&header, image, sizeof(Header));
+			
+			if (0 != ::std::memcmp(header.magic, magic, sizeof(magic)) || header.size != region->get_size() - sizeof(Header))
+			{
+				return false;
+			}
+			
+			Reader reader(image + sizeof(Header), image + region->get_size());
+			
+			::std::string manufacturer;
+			::std::string name;
+			::std::vector<::std::shared_ptr<Frame>> frames;
+			::std::vector<::std::pair<::std::size_t, ::std::size_t>> selfcollision;
+			::std::vector<::std::shared_ptr<Transform>> transforms;
+			::std::vector<::std::pair<::std::size_t, ::std::size_t>> endpoints;
+			::rl::math::Vector home;
+			::rl::math::Matrix gammaPosition;
+			::rl::math::Matrix gammaVelocity;
+			
+			try
+			{
+				::std::uint64_t dependencies = reader.getValue<::std::uint64_t>();
+				
+				for (::std::uint64_t i = 0; i < dependencies; ++i)
+				{
+					::std::string dependency = reader.getString();
+					::std::uint64_t hash = reader.getValue<::std::uint64_t>();
+					
+					if ((0 == i && dependency != source) || CacheFactory::hash(dependency) != hash)
+					{
+						return false;
+					}
+				}
+				
+				if (0 == dependencies)
+				{
+					return false;
+				}
+				
+				manufacturer = reader.getString();
+				name = reader.getString();
+				
+				frames.resize(reader.getValue<::std::uint64_t>());
+				
+				for (::std::size_t i = 0; i < frames.size(); ++i)
+				{
+					FrameType type = static_cast<FrameType>(reader.getValue<::std::uint8_t>());
+					
+					switch (type)
+					{
+					case FrameType::body:
+						frames[i] = ::std::make_shared<Body>();
+						break;
+					case FrameType::frame:
+						frames[i] = ::std::make_shared<Frame>();
+						break;
+					case FrameType::world:
+						frames[i] = ::std::make_shared<World>();
+						break;
+					default:
+						return false;
+					}
+					
+					frames[i]->setName(reader.getString());
+					reader.getMatrix(frames[i]->x.transform().matrix(), false);
+					
+					if (Body* body = dynamic_cast<Body*>(frames[i].get()))
+					{
+						reader.getMatrix(body->cm, false);
+						body->setCollision(0 != reader.getValue<::std::uint8_t>());
+						reader.getMatrix(body->ic, false);
+						body->setMass(static_cast<::rl::math::Real>(reader.getValue<double>()));
+					}
+					else if (World* world = dynamic_cast<World*>(frames[i].get()))
+					{
+						::rl::math::Vector3 gravity;
+						reader.getMatrix(gravity, false);
+						world->setGravity(gravity);
+					}
+				}
+				
+				selfcollision.resize(reader.getValue<::std::uint64_t>());
+				
+				for (::std::size_t i = 0; i < selfcollision.size(); ++i)
+				{
+					selfcollision[i].first = reader.getValue<::std::uint64_t>();
+					selfcollision[i].second = reader.getValue<::std::uint64_t>();
+					
+					if (
+						selfcollision[i].first >= frames.size() || selfcollision[i].second >= frames.size() ||
+						nullptr == dynamic_cast<Body*>(frames[selfcollision[i].first].get()) ||
+						nullptr == dynamic_cast<Body*>(frames[selfcollision[i].second].get())
+					)
+					{
+						return false;
+					}
+				}
+				
+				transforms.resize(reader.getValue<::std::uint64_t>());
+				endpoints.resize(transforms.size());
+				
+				for (::std::size_t i = 0; i < transforms.size(); ++i)
+				{
+					transforms[i] = createTransform(static_cast<TransformType>(reader.getValue<::std::uint8_t>()));
+					transforms[i]->setName(reader.getString());
+					endpoints[i].first = reader.getValue<::std::uint64_t>();
+					endpoints[i].second = reader.getValue<::std::uint64_t>();
+					
+					if (endpoints[i].first >= frames.size() || endpoints[i].second >= frames.size())
+					{
+						return false;
+					}
+					
+					reader.getMatrix(transforms[i]->x.transform().matrix(), false);
+					
+					if (Joint* joint = dynamic_cast<Joint*>(transforms[i].get()))
+					{
+						reader.getMatrix(joint->S, false);
+						reader.getMatrix(joint->max, false);
+						reader.getMatrix(joint->min, false);
+						reader.getMatrix(joint->offset, false);
+						reader.getMatrix(joint->speed, false);
+						reader.getMatrix(joint->wraparound, false);
+						
+						if (Helical* helical = dynamic_cast<Helical*>(joint))
+						{
+							helical->setPitch(static_cast<::rl::math::Real>(reader.getValue<double>()));
+						}
+					}
+				}
+				
+				reader.getMatrix(home, true);
+				reader.getMatrix(gammaPosition, true);
+				reader.getMatrix(gammaVelocity, true);
+			}
+			catch (const Exception&)
+			{
+				return false;
+			}
+			
+			if (!reader.atEnd())
+			{
+				return false;
+			}
+			
+			model->setManufacturer(manufacturer);
+			model->setName(name);
+			
+			for (::std::size_t i = 0; i < frames.size(); ++i)
+			{
+				model->add(frames[i]);
+			}
+			
+			for (::std::size_t i = 0; i < transforms.size(); ++i)
+			{
+				model->add(transforms[i], frames[endpoints[i].first].get(), frames[endpoints[i].second].get());
+			}
+			
+			for (::std::size_t i = 0; i < selfcollision.size(); ++i)
+			{
+				static_cast<Body*>(frames[selfcollision[i].first].get())->setCollision(static_cast<Body*>(frames[selfcollision[i].second].get()), false);
+			}
+			
+			model->update();
+			
+			model->setGammaPosition(gammaPosition);
+			model->setGammaVelocity(gammaVelocity);
+			model->setHomePosition(home);
+			
+			return true;
+		}
+		
+		void
+		CacheFactory::setDirectory(const ::std::string& directory)
+		{
+			this->directory = directory;
+		}
+		
+		void
+		CacheFactory::write(const ::std::string& filename, const ::std::vector<::std::pair<::std::string, ::std::uint64_t>>& dependencies, const Model* model) const
+		{
+			Writer writer;
+			
+			writer.putValue<::std::uint64_t>(dependencies.size());
+			
+			for (::std::size_t i = 0; i < dependencies.size(); ++i)
+			{
+				writer.putString(dependencies[i].first);
+				writer.putValue<::std::uint64_t>(dependencies[i].second);
+			}
+			
+			writer.putString(model->getManufacturer());
+			writer.putString(model->getName());
+			
+			::std::unordered_map<const Frame*, ::std::size_t> indices;
+			::std::vector<::std::pair<::std::size_t, ::std::size_t>> selfcollision;
+			
+			writer.putValue<::std::uint64_t>(model->getFrames());
+			
+			for (::std::size_t i = 0; i < model->getFrames(); ++i)
+			{
+				Frame* frame = model->getFrame(i);
+				indices[frame] = i;
+				
+				if (typeid(*frame) == typeid(Body))
+				{
+					writer.putValue(FrameType::body);
+				}
+				else if (typeid(*frame) == typeid(Frame))
+				{
+					writer.putValue(FrameType::frame);
+				}
+				else if (typeid(*frame) == typeid(World))
+				{
+					writer.putValue(FrameType::world);
+				}
+				else
+				{
+					throw Exception("rl::mdl::CacheFactory::write() - Unsupported frame type of " + frame->getName());
+				}
+				
+				writer.putString(frame->getName());
+				writer.putMatrix(frame->x.transform().matrix());
+				
+				if (Body* body = dynamic_cast<Body*>(frame))
+				{
+					writer.putMatrix(body->cm);
+					writer.putValue<::std::uint8_t>(body->getCollision() ? 1 : 0);
+					writer.putMatrix(body->ic);
+					writer.putValue<double>(body->m);
+				}
+				else if (World* world = dynamic_cast<World*>(frame))
+				{
+					writer.putMatrix(world->getGravity());
+				}
+			}
+			
+			for (::std::size_t i = 0; i < model->getBodies(); ++i)
+			{
+				Body* body = model->getBody(i);
+				
+				for (::std::unordered_set<Body*>::const_iterator j = body->selfcollision.begin(); j != body->selfcollision.end(); ++j)
+				{
+					if (indices.count(*j) > 0)
+					{
+						selfcollision.push_back(::std::make_pair(indices[body], indices[*j]));
+					}
+				}
+			}
+			
+			writer.putValue<::std::uint64_t>(selfcollision.size());
+			
+			for (::std::size_t i = 0; i < selfcollision.size(); ++i)
+			{
+				writer.putValue<::std::uint64_t>(selfcollision[i].first);
+				writer.putValue<::std::uint64_t>(selfcollision[i].second);
+			}
+			
+			writer.putValue<::std::uint64_t>(model->getTransforms());
+			
+			for (::std::size_t i = 0; i < model->getTransforms(); ++i)
+			{
+				Transform* transform = model->getTransform(i);
+				
+				writer.putValue(getTransformType(transform));
+				writer.putString(transform->getName());
+				writer.putValue<::std::uint64_t>(indices.at(transform->in));
+				writer.putValue<::std::uint64_t>(indices.at(transform->out));
+				writer.putMatrix(transform->x.transform().matrix());
+				
+				if (Joint* joint = dynamic_cast<Joint*>(transform))
+				{
+					writer.putMatrix(joint->S);
+					writer.putMatrix(joint->max);
+					writer.putMatrix(joint->min);
+					writer.putMatrix(joint->offset);
+					writer.putMatrix(joint->speed);
+					writer.putMatrix(joint->wraparound);
+					
+					if (Helical* helical = dynamic_cast<Helical*>(joint))
+					{
+						writer.putValue<double>(helical->getPitch());
+					}
+				}
+			}
+			
+			writer.putMatrix(model->getHomePosition());
+			writer.putMatrix(model->getGammaPosition());
+			writer.putMatrix(model->getGammaVelocity());
+			
+			Header header;
+			::std::memcpy(header.magic, magic, sizeof(magic));
+			header.size = writer.getBuffer().size();
+			
+			// replace cache via temporary file in same directory, as processes
+			// mapping the previous cache would fail on a truncated file
+			
+			::std::string temporary = filename + "." + ::std::to_string(::std::random_device()()) + ".tmp";
+			
+			::std::ofstream file(temporary.c_str(), ::std::ios::binary | ::std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			file.write(writer.getBuffer().data(), writer.getBuffer().size());
+			file.close();
+			
+			if (!file)
+			{
+				::std::remove(temporary.c_str());
+				throw Exception("rl::mdl::CacheFactory::write() - Could not write file " + filename);
+			}
+			
+			if (0 != ::std::rename(temporary.c_str(), filename.c_str()))
+			{
+				// some platforms do not replace existing files
+				::std::remove(filename.c_str());
+				
+				if (0 != ::std::rename(temporary.c_str(), filename.c_str()))
+				{
+					::std::remove(temporary.c_str());
+					throw Exception("rl::mdl::CacheFactory::write() - Could not write file " + filename);
+				}
+			}
+		}
+	}
+}
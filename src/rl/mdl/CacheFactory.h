@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_CACHEFACTORY_H
+#define RL_MDL_CACHEFACTORY_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Factory.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Binary cache in front of another factory.
+		 *
+		 * load() first tries a cache file written by a previous call. If it is
+		 * missing, invalid, written by a different version, or stale, the
+		 * wrapped factory parses the source file and the result is written to
+		 * the cache for the next start.
+		 *
+		 * The cache stores frames, bodies with inertia and self-collision
+		 * settings, transforms, joints with limits, speeds, offsets, and
+		 * wraparounds, tool transforms, home position, and coupling matrices.
+		 * It is mapped into memory with a single call and decoded without any
+		 * XML processing. Values are stored in double precision and the byte
+		 * order of the machine that created the file.
+		 *
+		 * The cache records the source file and all files included via
+		 * XInclude together with a 64-bit FNV-1a hash of their content. A
+		 * cache is stale if one of these hashes changed, which is checked
+		 * without parsing any XML. Files only referenced by external entities
+		 * or stylesheets are not recorded.
+		 *
+		 * The cache is written to a temporary file in the same directory,
+		 * which then replaces the previous cache. Processes still mapping the
+		 * previous cache keep its content.
+		 */
+		class RL_MDL_EXPORT CacheFactory : public Factory
+		{
+		public:
+			/**
+			 * @param[in] factory Factory for source files
+			 * @param[in] directory Directory of cache files, directory of the
+			 * source file if empty
+			 */
+			CacheFactory(Factory* factory, const ::std::string& directory = "");
+			
+			virtual ~CacheFactory();
+			
+			/**
+			 * @return Name of the cache file of a source file
+			 */
+			::std::string getCacheFilename(const ::std::string& filename) const;
+			
+			const ::std::string& getDirectory() const;
+			
+			Factory* getFactory() const;
+			
+			/**
+			 * @return Source file followed by all files included via XInclude,
+			 * each with the hash of its content
+			 * @throws Exception if a file cannot be read or parsed
+			 */
+			static ::std::vector<::std::pair<::std::string, ::std::uint64_t>> getDependencies(const ::std::string& filename);
+			
+			/**
+			 * @return 64-bit FNV-1a hash of the content of a file
+			 * @throws Exception if the file cannot be read
+			 */
+			static ::std::uint64_t hash(const ::std::string& filename);
+			
+			/**
+			 * @return True if the last call of load() used the cache
+			 */
+			bool isHit() const;
+			
+			/**
+			 * Load a model from its cache or from its source file.
+			 *
+			 * Errors while writing the cache are ignored, e.g., for a source
+			 * file in a read-only directory.
+			 */
+			void load(const ::std::string& filename, Model* model);
+			
+			/**
+			 * Load a model from a cache file.
+			 *
+			 * @param[in] filename Cache file
+			 * @param[in] source Source file the cache was written for
+			 * @param[out] model Empty model, unchanged on failure
+			 * @return False if the file is missing, invalid, written for a
+			 * different source file, or stale
+			 */
+			bool read(const ::std::string& filename, const ::std::string& source, Model* model) const;
+			
+			void setDirectory(const ::std::string& directory);
+			
+			/**
+			 * Write a model to a cache file.
+			 *
+			 * @param[in] filename Cache file
+			 * @param[in] dependencies Source file and included files with
+			 * hashes, see getDependencies()
+			 * @param[in] model Model with all frames connected to its world
+			 * @throws Exception if the file cannot be written or the model
+			 * contains unsupported elements
+			 */
+			void write(const ::std::string& filename, const ::std::vector<::std::pair<::std::string, ::std::uint64_t>>& dependencies, const Model* model) const;
+			
+		protected:
+			
+		private:
+			::std::string directory;
+			
+			Factory* factory;
+			
+			bool hit;
+		};
+	}
+}
+
+#endif // RL_MDL_CACHEFACTORY_H
@@ -0,0 +1,746 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <ostream>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+#include "Body.h"
+#include "CodeGenerator.h"
+#include "Exception.h"
+#include "Joint.h"
+#include "Model.h"
+#include "Prismatic.h"
+#include "Revolute.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		namespace
+		{
+			/** Magnitude below which coefficients are considered zero or one. */
+			constexpr ::rl::math::Real tolerance = static_cast<::rl::math::Real>(1.0e-12);
+			
+			::std::string literal(const ::rl::math::Real& x)
+			{
+				::std::ostringstream stream;
+				stream.imbue(::std::locale::classic());
+				stream << ::std::setprecision(::std::numeric_limits<::rl::math::Real>::max_digits10) << x;
+				::std::string s = stream.str();
+				return ::std::string::npos == s.find_first_of(".e") ? s + ".0" : s;
+			}
+			
+			/**
+			 * Comma-separated coefficients of a matrix in row-major order for
+			 * the comma initializer.
+			 */
+			template<typename T>
+			::std::string list(const T& x)
+			{
+				::std::string s;
+				
+				for (::std::ptrdiff_t i = 0; i < x.rows(); ++i)
+				{
+					for (::std::ptrdiff_t j = 0; j < x.cols(); ++j)
+					{
+						s += (0 == i && 0 == j ? "" : ", ") + literal(x(i, j));
+					}
+				}
+				
+				return s;
+			}
+			
+			/**
+			 * Linear combination of expressions with constant coefficients,
+			 * an empty expression denotes a constant term.
+			 */
+			::std::string sum(const ::std::vector<::std::pair<::std::string, ::rl::math::Real>>& terms)
+			{
+				::std::string s;
+				
+				for (::std::size_t i = 0; i < terms.size(); ++i)
+				{
+					if (0 == terms[i].second)
+					{
+						continue;
+					}
+					
+					s += s.empty() ? (terms[i].second < 0 ? "-" : "") : (terms[i].second < 0 ? " - " : " + ");
+					
+					if (terms[i].first.empty())
+					{
+						s += literal(::std::abs(terms[i].second));
+					}
+					else if (1 == ::std::abs(terms[i].second))
+					{
+						s += terms[i].first;
+					}
+					else
+					{
+						s += literal(::std::abs(terms[i].second)) + " * " + terms[i].first;
+					}
+				}
+				
+				return s.empty() ? "0" : s;
+			}
+			
+			/**
+			 * Round coefficients close to 0 or 1 to avoid rounding errors of
+			 * the model description in the generated code.
+			 */
+			template<typename T>
+			void snap(T& x)
+			{
+				for (::std::ptrdiff_t i = 0; i < x.size(); ++i)
+				{
+					if (::std::abs(x.data()[i]) < tolerance)
+					{
+						x.data()[i] = 0;
+					}
+					else if (::std::abs(::std::abs(x.data()[i]) - 1) < tolerance)
+					{
+						x.data()[i] = x.data()[i] < 0 ? -1 : 1;
+					}
+				}
+			}
+			
+			void transform(::std::ostream& stream, const ::std::string& indent, const ::std::string& name, ::rl::math::Transform x)
+			{
+				snap(x.matrix());
+				stream << indent << "::rl::math::Transform " << name << ";" << ::std::endl;
+				stream << indent << name << ".linear() << " << list(x.linear()) << ";" << ::std::endl;
+				stream << indent << name << ".translation() << " << list(x.translation()) << ";" << ::std::endl;
+				stream << indent << name << ".makeAffine();" << ::std::endl;
+			}
+		}
+		
+		CodeGenerator::CodeGenerator(Model* model) :
+			gravity(),
+			links(),
+			model(model),
+			operationals(),
+			world()
+		{
+			this->update();
+		}
+		
+		CodeGenerator::~CodeGenerator()
+		{
+		}
+		
+		void
+		CodeGenerator::generate(::std::ostream& stream, const ::std::string& name) const
+		{
+			::std::string guard = name;
+			::std::transform(guard.begin(), guard.end(), guard.begin(), [](char c){ return ::std::toupper(c, ::std::locale::classic()); });
+			
+			::std::string n = ::std::to_string(this->links.size());
+			::std::string m = ::std::to_string(this->operationals.size());
+			
+			stream << "// Generated by rl::mdl::CodeGenerator::generate()";
+			stream << (this->model->getName().empty() ? "" : " for " + this->model->getName()) << "." << ::std::endl;
+			stream << ::std::endl;
+			stream << "#ifndef " << guard << "_H" << ::std::endl;
+			stream << "#define " << guard << "_H" << ::std::endl;
+			stream << ::std::endl;
+			stream << "#include <array>" << ::std::endl;
+			stream << "#include <cmath>" << ::std::endl;
+			stream << "#include <rl/math/Matrix.h>" << ::std::endl;
+			stream << "#include <rl/math/Spatial.h>" << ::std::endl;
+			stream << "#include <rl/math/Transform.h>" << ::std::endl;
+			stream << "#include <rl/math/Vector.h>" << ::std::endl;
+			stream << ::std::endl;
+			stream << "class " << name << ::std::endl;
+			stream << "{" << ::std::endl;
+			stream << "public:" << ::std::endl;
+			stream << "\ttypedef ::Eigen::Matrix<::rl::math::Real, " << 6 * this->operationals.size() << ", " << n << "> JacobianMatrix;" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "\ttypedef ::Eigen::Matrix<::rl::math::Real, " << n << ", 1> JointVector;" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "\ttypedef ::Eigen::Matrix<::rl::math::Real, " << n << ", " << n << "> MassMatrix;" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "\ttypedef ::std::array<::rl::math::Transform, " << m << "> OperationalPositions;" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			
+			this->generateJacobian(stream);
+			this->generateMassMatrix(stream);
+			this->generateForwardDynamics(stream);
+			this->generateForwardPosition(stream);
+			this->generateInverseDynamics(stream);
+			
+			stream << "private:" << ::std::endl;
+			
+			this->generatePrivate(stream);
+			
+			stream << "};" << ::std::endl;
+			stream << ::std::endl;
+			stream << "#endif // " << guard << "_H" << ::std::endl;
+		}
+		
+		void
+		CodeGenerator::generateForwardDynamics(::std::ostream& stream) const
+		{
+			::std::string n = ::std::to_string(this->links.size());
+			
+			stream << "\t/**" << ::std::endl;
+			stream << "\t * Articulated body algorithm." << ::std::endl;
+			stream << "\t */" << ::std::endl;
+			stream << "\tstatic void forwardDynamics(const JointVector& q, const JointVector& qd, const JointVector& tau, JointVector& qdd)" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t\t::rl::math::PlueckerTransform X[" << n << "];" << ::std::endl;
+			stream << "\t\ttransforms(q, X);" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector S[" << n << "];" << ::std::endl;
+			stream << "\t\tsubspaces(S);" << ::std::endl;
+			stream << "\t\t::rl::math::RigidBodyInertia I[" << n << "];" << ::std::endl;
+			stream << "\t\tinertias(I);" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector a0;" << ::std::endl;
+			stream << "\t\ta0.angular().setZero();" << ::std::endl;
+			stream << "\t\ta0.linear() << " << list(this->gravity) << ";" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector a[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector c[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::Real D[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::ArticulatedBodyInertia IA[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::ForceVector pA[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::Real u[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::ForceVector U[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector v[" << n << "];" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				::std::string k = ::std::to_string(i);
+				
+				if (this->links[i].parent < this->links.size())
+				{
+					::std::string p = ::std::to_string(this->links[i].parent);
+					stream << "\t\tv[" << k << "] = X[" << k << "] * v[" << p << "] + S[" << k << "] * qd(" << k << ");" << ::std::endl;
+					stream << "\t\tc[" << k << "] = v[" << k << "].cross(S[" << k << "] * qd(" << k << "));" << ::std::endl;
+				}
+				else
+				{
+					stream << "\t\tv[" << k << "] = S[" << k << "] * qd(" << k << ");" << ::std::endl;
+					stream << "\t\tc[" << k << "].setZero();" << ::std::endl;
+				}
+				
+				stream << "\t\tIA[" << k << "] = I[" << k << "];" << ::std::endl;
+				stream << "\t\tpA[" << k << "] = v[" << k << "].cross(I[" << k << "] * v[" << k << "]);" << ::std::endl;
+			}
+			
+			stream << "\t\t" << ::std::endl;
+			
+			for (::std::size_t i = this->links.size(); i-- > 0;)
+			{
+				::std::string k = ::std::to_string(i);
+				
+				stream << "\t\tU[" << k << "] = IA[" << k << "] * S[" << k << "];" << ::std::endl;
+				stream << "\t\tD[" << k << "] = S[" << k << "].dot(U[" << k << "]);" << ::std::endl;
+				stream << "\t\tu[" << k << "] = tau(" << k << ") - S[" << k << "].dot(pA[" << k << "]);" << ::std::endl;
+				
+				if (this->links[i].parent < this->links.size())
+				{
+					::std::string p = ::std::to_string(this->links[i].parent);
+					stream << "\t\t{" << ::std::endl;
+					stream << "\t\t\t::rl::math::ArticulatedBodyInertia ia(IA[" << k << "] - ::rl::math::ArticulatedBodyInertia(U[" << k << "].matrix() * U[" << k << "].matrix().transpose() / D[" << k << "]));" << ::std::endl;
+					stream << "\t\t\t::rl::math::ForceVector pa(pA[" << k << "] + ia * c[" << k << "] + U[" << k << "] * (u[" << k << "] / D[" << k << "]));" << ::std::endl;
+					stream << "\t\t\tIA[" << p << "] = IA[" << p << "] + X[" << k << "] / ia;" << ::std::endl;
+					stream << "\t\t\tpA[" << p << "] = pA[" << p << "] + X[" << k << "] / pa;" << ::std::endl;
+					stream << "\t\t}" << ::std::endl;
+				}
+			}
+			
+			stream << "\t\t" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				::std::string k = ::std::to_string(i);
+				
+				if (this->links[i].parent < this->links.size())
+				{
+					stream << "\t\ta[" << k << "] = X[" << k << "] * a[" << this->links[i].parent << "] + c[" << k << "];" << ::std::endl;
+				}
+				else
+				{
+					stream << "\t\ta[" << k << "] = X[" << k << "] * a0;" << ::std::endl;
+				}
+				
+				stream << "\t\tqdd(" << k << ") = (u[" << k << "] - U[" << k << "].dot(a[" << k << "])) / D[" << k << "];" << ::std::endl;
+				stream << "\t\ta[" << k << "] += S[" << k << "] * qdd(" << k << ");" << ::std::endl;
+			}
+			
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+		}
+		
+		void
+		CodeGenerator::generateForwardPosition(::std::ostream& stream) const
+		{
+			::std::string n = ::std::to_string(this->links.size());
+			
+			stream << "\tstatic void forwardPosition(const JointVector& q, OperationalPositions& x)" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t\t::rl::math::PlueckerTransform X[" << n << "];" << ::std::endl;
+			stream << "\t\ttransforms(q, X);" << ::std::endl;
+			stream << "\t\t::rl::math::PlueckerTransform X0[" << n << "];" << ::std::endl;
+			stream << "\t\tpositions(X, X0);" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->operationals.size(); ++i)
+			{
+				::std::string k = ::std::to_string(i);
+				
+				stream << "\t\t" << ::std::endl;
+				
+				if (this->operationals[i].parent < this->links.size())
+				{
+					if (this->operationals[i].transform.matrix().isIdentity(tolerance))
+					{
+						stream << "\t\tx[" << k << "] = X0[" << this->operationals[i].parent << "].transform();" << ::std::endl;
+					}
+					else
+					{
+						transform(stream, "\t\t", "T" + k, this->operationals[i].transform);
+						stream << "\t\tx[" << k << "] = X0[" << this->operationals[i].parent << "].transform() * T" << k << ";" << ::std::endl;
+					}
+				}
+				else
+				{
+					transform(stream, "\t\t", "T" + k, this->world * this->operationals[i].transform);
+					stream << "\t\tx[" << k << "] = T" << k << ";" << ::std::endl;
+				}
+			}
+			
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+		}
+		
+		void
+		CodeGenerator::generateInverseDynamics(::std::ostream& stream) const
+		{
+			::std::string n = ::std::to_string(this->links.size());
+			
+			stream << "\t/**" << ::std::endl;
+			stream << "\t * Recursive Newton-Euler algorithm." << ::std::endl;
+			stream << "\t */" << ::std::endl;
+			stream << "\tstatic void inverseDynamics(const JointVector& q, const JointVector& qd, const JointVector& qdd, JointVector& tau)" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t\t::rl::math::PlueckerTransform X[" << n << "];" << ::std::endl;
+			stream << "\t\ttransforms(q, X);" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector S[" << n << "];" << ::std::endl;
+			stream << "\t\tsubspaces(S);" << ::std::endl;
+			stream << "\t\t::rl::math::RigidBodyInertia I[" << n << "];" << ::std::endl;
+			stream << "\t\tinertias(I);" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector a0;" << ::std::endl;
+			stream << "\t\ta0.angular().setZero();" << ::std::endl;
+			stream << "\t\ta0.linear() << " << list(this->gravity) << ";" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector a[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::ForceVector f[" << n << "];" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector v[" << n << "];" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				::std::string k = ::std::to_string(i);
+				
+				if (this->links[i].parent < this->links.size())
+				{
+					::std::string p = ::std::to_string(this->links[i].parent);
+					stream << "\t\tv[" << k << "] = X[" << k << "] * v[" << p << "] + S[" << k << "] * qd(" << k << ");" << ::std::endl;
+					stream << "\t\ta[" << k << "] = X[" << k << "] * a[" << p << "] + S[" << k << "] * qdd(" << k << ") + v[" << k << "].cross(S[" << k << "] * qd(" << k << "));" << ::std::endl;
+				}
+				else
+				{
+					stream << "\t\tv[" << k << "] = S[" << k << "] * qd(" << k << ");" << ::std::endl;
+					stream << "\t\ta[" << k << "] = X[" << k << "] * a0 + S[" << k << "] * qdd(" << k << ");" << ::std::endl;
+				}
+				
+				stream << "\t\tf[" << k << "] = I[" << k << "] * a[" << k << "] + v[" << k << "].cross(I[" << k << "] * v[" << k << "]);" << ::std::endl;
+			}
+			
+			stream << "\t\t" << ::std::endl;
+			
+			for (::std::size_t i = this->links.size(); i-- > 0;)
+			{
+				::std::string k = ::std::to_string(i);
+				
+				stream << "\t\ttau(" << k << ") = S[" << k << "].dot(f[" << k << "]);" << ::std::endl;
+				
+				if (this->links[i].parent < this->links.size())
+				{
+					stream << "\t\tf[" << this->links[i].parent << "] += X[" << k << "] / f[" << k << "];" << ::std::endl;
+				}
+			}
+			
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+		}
+		
+		void
+		CodeGenerator::generateJacobian(::std::ostream& stream) const
+		{
+			::std::string n = ::std::to_string(this->links.size());
+			
+			stream << "\t/**" << ::std::endl;
+			stream << "\t * Jacobian of all operational frames in world frame." << ::std::endl;
+			stream << "\t */" << ::std::endl;
+			stream << "\tstatic void calculateJacobian(const JointVector& q, JacobianMatrix& J)" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t\t::rl::math::PlueckerTransform X[" << n << "];" << ::std::endl;
+			stream << "\t\ttransforms(q, X);" << ::std::endl;
+			stream << "\t\t::rl::math::PlueckerTransform X0[" << n << "];" << ::std::endl;
+			stream << "\t\tpositions(X, X0);" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector S[" << n << "];" << ::std::endl;
+			stream << "\t\tsubspaces(S);" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				stream << "\t\tS[" << i << "] = X0[" << i << "] / S[" << i << "];" << ::std::endl;
+			}
+			
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\tJ.setZero();" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->operationals.size(); ++i)
+			{
+				::std::string k = ::std::to_string(i);
+				
+				if (this->operationals[i].parent >= this->links.size())
+				{
+					continue;
+				}
+				
+				::rl::math::Vector3 p = this->operationals[i].transform.translation();
+				snap(p);
+				
+				stream << "\t\t" << ::std::endl;
+				stream << "\t\t{" << ::std::endl;
+				stream << "\t\t\t::rl::math::Vector3 p = X0[" << this->operationals[i].parent << "].transform() * ::rl::math::Vector3(" << list(p) << ");" << ::std::endl;
+				
+				for (::std::size_t j = this->operationals[i].parent; j < this->links.size(); j = this->links[j].parent)
+				{
+					stream << "\t\t\tJ.block<3, 1>(" << 6 * i << ", " << j << ") = S[" << j << "].linear() + S[" << j << "].angular().cross(p);" << ::std::endl;
+					stream << "\t\t\tJ.block<3, 1>(" << 6 * i + 3 << ", " << j << ") = S[" << j << "].angular();" << ::std::endl;
+				}
+				
+				stream << "\t\t}" << ::std::endl;
+			}
+			
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+		}
+		
+		void
+		CodeGenerator::generateMassMatrix(::std::ostream& stream) const
+		{
+			::std::string n = ::std::to_string(this->links.size());
+			
+			stream << "\t/**" << ::std::endl;
+			stream << "\t * Composite rigid body algorithm." << ::std::endl;
+			stream << "\t */" << ::std::endl;
+			stream << "\tstatic void calculateMassMatrix(const JointVector& q, MassMatrix& M)" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t\t::rl::math::PlueckerTransform X[" << n << "];" << ::std::endl;
+			stream << "\t\ttransforms(q, X);" << ::std::endl;
+			stream << "\t\t::rl::math::MotionVector S[" << n << "];" << ::std::endl;
+			stream << "\t\tsubspaces(S);" << ::std::endl;
+			stream << "\t\t::rl::math::RigidBodyInertia I[" << n << "];" << ::std::endl;
+			stream << "\t\tinertias(I);" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			
+			for (::std::size_t i = this->links.size(); i-- > 0;)
+			{
+				if (this->links[i].parent < this->links.size())
+				{
+					::std::string p = ::std::to_string(this->links[i].parent);
+					stream << "\t\tI[" << p << "] = I[" << p << "] + X[" << i << "] / I[" << i << "];" << ::std::endl;
+				}
+			}
+			
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\tM.setZero();" << ::std::endl;
+			stream << "\t\t::rl::math::ForceVector F;" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				stream << "\t\t" << ::std::endl;
+				stream << "\t\tF = I[" << i << "] * S[" << i << "];" << ::std::endl;
+				stream << "\t\tM(" << i << ", " << i << ") = S[" << i << "].dot(F);" << ::std::endl;
+				
+				for (::std::size_t j = i; this->links[j].parent < this->links.size(); j = this->links[j].parent)
+				{
+					::std::size_t p = this->links[j].parent;
+					stream << "\t\tF = X[" << j << "] / F;" << ::std::endl;
+					stream << "\t\tM(" << i << ", " << p << ") = M(" << p << ", " << i << ") = S[" << p << "].dot(F);" << ::std::endl;
+				}
+			}
+			
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+		}
+		
+		void
+		CodeGenerator::generatePrivate(::std::ostream& stream) const
+		{
+			::std::string n = ::std::to_string(this->links.size());
+			
+			stream << "\tstatic void inertias(::rl::math::RigidBodyInertia (&I)[" << n << "])" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				stream << "\t\tI[" << i << "].cog() << " << list(this->links[i].inertia.cog()) << ";" << ::std::endl;
+				stream << "\t\tI[" << i << "].inertia() << " << list(this->links[i].inertia.inertia()) << ";" << ::std::endl;
+				stream << "\t\tI[" << i << "].mass() = " << literal(this->links[i].inertia.mass()) << ";" << ::std::endl;
+			}
+			
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "\tstatic void positions(const ::rl::math::PlueckerTransform (&X)[" << n << "], ::rl::math::PlueckerTransform (&X0)[" << n << "])" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			
+			bool world = this->world.matrix().isIdentity(tolerance);
+			
+			if (!world)
+			{
+				transform(stream, "\t\t", "W", this->world);
+				stream << "\t\t" << ::std::endl;
+			}
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				if (this->links[i].parent < this->links.size())
+				{
+					stream << "\t\tX0[" << i << "] = X0[" << this->links[i].parent << "] * X[" << i << "];" << ::std::endl;
+				}
+				else if (world)
+				{
+					stream << "\t\tX0[" << i << "] = X[" << i << "];" << ::std::endl;
+				}
+				else
+				{
+					stream << "\t\tX0[" << i << "] = W * X[" << i << "].transform();" << ::std::endl;
+				}
+			}
+			
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "\tstatic void subspaces(::rl::math::MotionVector (&S)[" << n << "])" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				stream << "\t\tS[" << i << "].angular() << " << list(this->links[i].subspace.head<3>()) << ";" << ::std::endl;
+				stream << "\t\tS[" << i << "].linear() << " << list(this->links[i].subspace.tail<3>()) << ";" << ::std::endl;
+			}
+			
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "\tstatic void transforms(const JointVector& q, ::rl::math::PlueckerTransform (&X)[" << n << "])" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			
+			for (::std::size_t i = 0; i < this->links.size(); ++i)
+			{
+				const Link& link = this->links[i];
+				::std::string k = ::std::to_string(i);
+				::std::string q = "q(" + k + ")";
+				
+				::rl::math::Matrix33 rotation = link.transform.linear();
+				::rl::math::Vector3 translation = link.transform.translation();
+				
+				if (i > 0)
+				{
+					stream << "\t\t" << ::std::endl;
+				}
+				
+				if (link.revolute)
+				{
+					// R * (a * a^T + cos * (1 - a * a^T) + sin * a x)
+					
+					::rl::math::Vector3 axis = link.subspace.head<3>();
+					::rl::math::Matrix33 constant = rotation * axis * axis.transpose();
+					::rl::math::Matrix33 cosine = rotation * (::rl::math::Matrix33::Identity() - axis * axis.transpose());
+					::rl::math::Matrix33 sine = rotation * axis.cross33();
+					snap(constant);
+					snap(cosine);
+					snap(sine);
+					snap(translation);
+					
+					::std::string angle = sum({{q, 1}, {"", link.offset}});
+					
+					stream << "\t\t::rl::math::Real c" << k << " = ::std::cos(" << angle << ");" << ::std::endl;
+					stream << "\t\t::rl::math::Real s" << k << " = ::std::sin(" << angle << ");" << ::std::endl;
+					stream << "\t\tX[" << i << "].linear() <<" << ::std::endl;
+					
+					for (::std::ptrdiff_t r = 0; r < 3; ++r)
+					{
+						stream << "\t\t\t";
+						
+						for (::std::ptrdiff_t c = 0; c < 3; ++c)
+						{
+							stream << sum({{"", constant(r, c)}, {"c" + k, cosine(r, c)}, {"s" + k, sine(r, c)}});
+							stream << (2 == c ? (2 == r ? ";" : ",") : ", ");
+						}
+						
+						stream << ::std::endl;
+					}
+					
+					stream << "\t\tX[" << i << "].translation() << " << list(translation) << ";" << ::std::endl;
+				}
+				else
+				{
+					// t + R * d * (q + offset)
+					
+					::rl::math::Vector3 direction = rotation * link.subspace.tail<3>();
+					snap(rotation);
+					snap(direction);
+					translation += direction * link.offset;
+					snap(translation);
+					
+					stream << "\t\tX[" << i << "].linear() << " << list(rotation) << ";" << ::std::endl;
+					stream << "\t\tX[" << i << "].translation() << ";
+					
+					for (::std::ptrdiff_t r = 0; r < 3; ++r)
+					{
+						stream << sum({{"", translation(r)}, {q, direction(r)}}) << (2 == r ? ";" : ", ");
+					}
+					
+					stream << ::std::endl;
+				}
+				
+				stream << "\t\tX[" << i << "].transform().makeAffine();" << ::std::endl;
+			}
+			
+			stream << "\t}" << ::std::endl;
+		}
+		
+		Model*
+		CodeGenerator::getModel() const
+		{
+			return this->model;
+		}
+		
+		void
+		CodeGenerator::update()
+		{
+			if (!this->model->getGammaPosition().isIdentity() || !this->model->getGammaVelocity().isIdentity())
+			{
+				throw Exception("rl::mdl::CodeGenerator::update() - Coupled joints are not supported");
+			}
+			
+			if (0 == this->model->getJoints())
+			{
+				throw Exception("rl::mdl::CodeGenerator::update() - Model does not have joints");
+			}
+			
+			this->links.clear();
+			this->operationals.clear();
+			
+			// link of each frame and its index, links are numbered like joints
+			// and the number of joints denotes the world
+			
+			::std::unordered_map<const Frame*, ::std::pair<::std::size_t, ::std::size_t>> frames;
+			::std::vector<::rl::math::Transform, ::Eigen::aligned_allocator<::rl::math::Transform>> transforms;
+			
+			for (::std::size_t i = 0; i < this->model->getFrames(); ++i)
+			{
+				frames[this->model->getFrame(i)] = ::std::make_pair(this->model->getJoints(), i);
+			}
+			
+			transforms.assign(this->model->getFrames(), ::rl::math::Transform::Identity());
+			
+			for (::std::size_t i = 0; i < this->model->getTransforms(); ++i)
+			{
+				Transform* transform = this->model->getTransform(i);
+				::std::pair<::std::size_t, ::std::size_t>& in = frames.at(transform->in);
+				::std::pair<::std::size_t, ::std::size_t>& out = frames.at(transform->out);
+				
+				if (Joint* joint = dynamic_cast<Joint*>(transform))
+				{
+					if (typeid(*joint) != typeid(Revolute) && typeid(*joint) != typeid(Prismatic))
+					{
+						throw Exception("rl::mdl::CodeGenerator::update() - Joint " + joint->getName() + " is neither revolute nor prismatic");
+					}
+					
+					Link link;
+					link.inertia = ::rl::math::RigidBodyInertia::Zero();
+					link.offset = joint->getOffset()(0);
+					link.parent = in.first;
+					link.revolute = typeid(*joint) == typeid(Revolute);
+					link.subspace = joint->S.col(0);
+					snap(link.subspace);
+					link.transform = transforms[in.second];
+					
+					out.first = this->links.size();
+					transforms[out.second].setIdentity();
+					
+					this->links.push_back(link);
+				}
+				else
+				{
+					out.first = in.first;
+					transforms[out.second] = transforms[in.second] * transform->x.transform();
+				}
+			}
+			
+			for (::std::size_t i = 0; i < this->model->getBodies(); ++i)
+			{
+				Body* body = this->model->getBody(i);
+				const ::std::pair<::std::size_t, ::std::size_t>& frame = frames.at(body);
+				
+				if (frame.first < this->links.size())
+				{
+					this->links[frame.first].inertia = this->links[frame.first].inertia + ::rl::math::PlueckerTransform(transforms[frame.second]) / body->i;
+				}
+			}
+			
+			for (::std::size_t i = 0; i < this->model->getOperationalDof(); ++i)
+			{
+				const ::std::pair<::std::size_t, ::std::size_t>& frame = frames.at(this->model->getOperationalFrame(i));
+				
+				Operational operational;
+				operational.parent = frame.first;
+				operational.transform = transforms[frame.second];
+				
+				this->operationals.push_back(operational);
+			}
+			
+			this->gravity = this->model->getWorldGravity();
+			this->world = this->model->world();
+		}
+	}
+}
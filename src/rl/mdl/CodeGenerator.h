@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_CODEGENERATOR_H
+#define RL_MDL_CODEGENERATOR_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <rl/math/Spatial.h>
+#include <rl/math/Transform.h>
+#include <rl/math/Vector.h>
+#include <rl/mdl/export.h>
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Model;
+		
+		/**
+		 * Generator of specialized kinematics and dynamics for a fixed model.
+		 *
+		 * The generated class provides forward position, Jacobian in world
+		 * frame, recursive Newton-Euler inverse dynamics, composite rigid
+		 * body mass matrix, and articulated body forward dynamics with the
+		 * same conventions as Kinematic and Dynamic. All loops over the tree
+		 * are unrolled and all vectors and matrices have fixed size. Fixed
+		 * transforms between joints are merged into constant transforms,
+		 * bodies are merged into the constant inertia of their joint, and
+		 * joint rotations use precomputed coefficients of their axis.
+		 *
+		 * Roy Featherstone. Rigid Body Dynamics Algorithms. Springer, 2008.
+		 */
+		class RL_MDL_EXPORT CodeGenerator
+		{
+		public:
+			EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+			
+			CodeGenerator(Model* model);
+			
+			virtual ~CodeGenerator();
+			
+			/**
+			 * Write a header with a class of static functions for the current
+			 * geometry and inertia.
+			 *
+			 * External forces on bodies are not considered.
+			 *
+			 * @param[in] name Name of generated class
+			 */
+			void generate(::std::ostream& stream, const ::std::string& name) const;
+			
+			Model* getModel() const;
+			
+			/**
+			 * Extract joints, constant transforms, and inertias from model,
+			 * required after changes to its geometry.
+			 *
+			 * @throws Exception If model contains joints other than revolute
+			 * and prismatic joints or coupled joints
+			 */
+			void update();
+			
+		protected:
+			
+		private:
+			struct Link
+			{
+				EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+				
+				/** Inertia of all bodies rigidly attached to joint. */
+				::rl::math::RigidBodyInertia inertia;
+				
+				/** Joint offset. */
+				::rl::math::Real offset;
+				
+				/** Index of parent link, number of links for world. */
+				::std::size_t parent;
+				
+				bool revolute;
+				
+				/** Motion subspace of joint. */
+				::rl::math::Vector6 subspace;
+				
+				/** Transform from parent link to joint. */
+				::rl::math::Transform transform;
+			};
+			
+			struct Operational
+			{
+				EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+				
+				/** Index of parent link, number of links for world. */
+				::std::size_t parent;
+				
+				/** Transform from parent link to operational frame. */
+				::rl::math::Transform transform;
+			};
+			
+			void generateForwardDynamics(::std::ostream& stream) const;
+			
+			void generateForwardPosition(::std::ostream& stream) const;
+			
+			void generateInverseDynamics(::std::ostream& stream) const;
+			
+			void generateJacobian(::std::ostream& stream) const;
+			
+			void generateMassMatrix(::std::ostream& stream) const;
+			
+			void generatePrivate(::std::ostream& stream) const;
+			
+			::rl::math::Vector3 gravity;
+			
+			::std::vector<Link, ::Eigen::aligned_allocator<Link>> links;
+			
+			Model* model;
+			
+			::std::vector<Operational, ::Eigen::aligned_allocator<Operational>> operationals;
+			
+			::rl::math::Transform world;
+		};
+	}
+}
+
+#endif // RL_MDL_CODEGENERATOR_H
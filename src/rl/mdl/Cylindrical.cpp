@@ -53,6 +53,12 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Transform>
+		Cylindrical::clone() const
+		{
+			return ::std::make_shared<Cylindrical>(*this);
+		}
+		
 		void
 		Cylindrical::setPosition(const ::rl::math::ConstVectorRef& q)
 		{
@@ -0,0 +1,321 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "DormandPrinceIntegrator.h"
+#include "Dynamic.h"
+#include "Exception.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		namespace
+		{
+			/** Stage coefficients, the last row are the weights of the fifth order solution. */
+			const ::rl::math::Real coefficients[7][6] = {
+				{0, 0, 0, 0, 0, 0},
+				{static_cast<::rl::math::Real>(1.0 / 5.0), 0, 0, 0, 0, 0},
+				{static_cast<::rl::math::Real>(3.0 / 40.0), static_cast<::rl::math::Real>(9.0 / 40.0), 0, 0, 0, 0},
+				{static_cast<::rl::math::Real>(44.0 / 45.0), static_cast<::rl::math::Real>(-56.0 / 15.0), static_cast<::rl::math::Real>(32.0 / 9.0), 0, 0, 0},
+				{static_cast<::rl::math::Real>(19372.0 / 6561.0), static_cast<::rl::math::Real>(-25360.0 / 2187.0), static_cast<::rl::math::Real>(64448.0 / 6561.0), static_cast<::rl::math::Real>(-212.0 / 729.0), 0, 0},
+				{static_cast<::rl::math::Real>(9017.0 / 3168.0), static_cast<::rl::math::Real>(-355.0 / 33.0), static_cast<::rl::math::Real>(46732.0 / 5247.0), static_cast<::rl::math::Real>(49.0 / 176.0), static_cast<::rl::math::Real>(-5103.0 / 18656.0), 0},
+				{static_cast<::rl::math::Real>(35.0 / 384.0), 0, static_cast<::rl::math::Real>(500.0 / 1113.0), static_cast<::rl::math::Real>(125.0 / 192.0), static_cast<::rl::math::Real>(-2187.0 / 6784.0), static_cast<::rl::math::Real>(11.0 / 84.0)}
+			};
+			
+			/** Difference between fifth and fourth order weights. */
+			const ::rl::math::Real errorCoefficients[7] = {
+				static_cast<::rl::math::Real>(71.0 / 57600.0),
+				0,
+				static_cast<::rl::math::Real>(-71.0 / 16695.0),
+				static_cast<::rl::math::Real>(71.0 / 1920.0),
+				static_cast<::rl::math::Real>(-17253.0 / 339200.0),
+				static_cast<::rl::math::Real>(22.0 / 525.0),
+				static_cast<::rl::math::Real>(-1.0 / 40.0)
+			};
+		}
+		
+		DormandPrinceIntegrator::DormandPrinceIntegrator(Dynamic* dynamic) :
+			Integrator(dynamic),
+			absoluteTolerance(static_cast<::rl::math::Real>(1.0e-6)),
+			acceptedSteps(0),
+			cached(false),
+			de(),
+			dk(),
+			dy(),
+			dy0(),
+			e(),
+			evaluations(0),
+			k(),
+			minimumStepSize(static_cast<::rl::math::Real>(1.0e-12)),
+			rejectedSteps(0),
+			relativeTolerance(static_cast<::rl::math::Real>(1.0e-6)),
+			stepSize(0),
+			tau(),
+			tau0(),
+			y(),
+			y0()
+		{
+			this->resize();
+		}
+		
+		DormandPrinceIntegrator::~DormandPrinceIntegrator()
+		{
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getAbsoluteTolerance() const
+		{
+			return this->absoluteTolerance;
+		}
+		
+		const ::std::size_t&
+		DormandPrinceIntegrator::getAcceptedSteps() const
+		{
+			return this->acceptedSteps;
+		}
+		
+		const ::std::size_t&
+		DormandPrinceIntegrator::getEvaluations() const
+		{
+			return this->evaluations;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getMinimumStepSize() const
+		{
+			return this->minimumStepSize;
+		}
+		
+		const ::std::size_t&
+		DormandPrinceIntegrator::getRejectedSteps() const
+		{
+			return this->rejectedSteps;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getRelativeTolerance() const
+		{
+			return this->relativeTolerance;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getStepSize() const
+		{
+			return this->stepSize;
+		}
+		
+		void
+		DormandPrinceIntegrator::integrate(const ::rl::math::Real& dt)
+		{
+			assert(dt >= 0);
+			
+			this->resize();
+			
+			this->dynamic->getPosition(this->y);
+			this->dynamic->getVelocity(this->dy);
+			this->dynamic->getTorque(this->tau);
+			
+			// first stage, reused from last stage of previous accepted step
+			// and of previous call if its final state and torque are unchanged
+			
+			if (!this->cached || this->y != this->y0 || this->dy != this->dy0 || this->tau != this->tau0)
+			{
+				this->y0 = this->y;
+				this->dy0 = this->dy;
+				this->tau0 = this->tau;
+				this->dynamic->forwardDynamics();
+				++this->evaluations;
+				this->dynamic->getAcceleration(this->dk.col(0));
+			}
+			
+			this->cached = false;
+			this->k.col(0) = this->dy0;
+			
+			if (this->stepSize <= 0)
+			{
+				this->stepSize = dt;
+			}
+			
+			::rl::math::Real t = 0;
+			
+			while (t < dt)
+			{
+				// avoid a tiny last step by slightly stretching the current one
+				bool last = t + static_cast<::rl::math::Real>(1.01) * this->stepSize >= dt;
+				::rl::math::Real h = last ? dt - t : this->stepSize;
+				
+				for (::std::size_t i = 1; i < 7; ++i)
+				{
+					this->y = this->y0;
+					this->dy = this->dy0;
+					
+					for (::std::size_t j = 0; j < i; ++j)
+					{
+						if (0 != coefficients[i][j])
+						{
+							this->y += h * coefficients[i][j] * this->k.col(j);
+							this->dy += h * coefficients[i][j] * this->dk.col(j);
+						}
+					}
+					
+					this->dynamic->setPosition(this->y);
+					this->dynamic->setVelocity(this->dy);
+					this->dynamic->forwardDynamics();
+					++this->evaluations;
+					this->k.col(i) = this->dy;
+					this->dynamic->getAcceleration(this->dk.col(i));
+				}
+				
+				// difference to embedded fourth order solution
+				
+				this->e.setZero();
+				this->de.setZero();
+				
+				for (::std::size_t i = 0; i < 7; ++i)
+				{
+					if (0 != errorCoefficients[i])
+					{
+						this->e += h * errorCoefficients[i] * this->k.col(i);
+						this->de += h * errorCoefficients[i] * this->dk.col(i);
+					}
+				}
+				
+				::rl::math::Real error = ::std::sqrt(
+					(
+						(this->e.array() / (this->absoluteTolerance + this->relativeTolerance * this->y0.array().abs().max(this->y.array().abs()))).square().sum() +
+						(this->de.array() / (this->absoluteTolerance + this->relativeTolerance * this->dy0.array().abs().max(this->dy.array().abs()))).square().sum()
+					) / (this->e.size() + this->de.size())
+				);
+				
+				bool accepted = error <= 1;
+				
+				::rl::math::Real factor;
+				
+				if (!::std::isfinite(error))
+				{
+					factor = static_cast<::rl::math::Real>(0.2);
+				}
+				else if (error > 0)
+				{
+					factor = static_cast<::rl::math::Real>(0.9) * ::std::pow(error, static_cast<::rl::math::Real>(-0.2));
+					factor = ::std::max(static_cast<::rl::math::Real>(0.2), ::std::min(accepted ? static_cast<::rl::math::Real>(5) : 1, factor));
+				}
+				else
+				{
+					factor = 5;
+				}
+				
+				if (accepted)
+				{
+					++this->acceptedSteps;
+					t = last ? dt : t + h;
+					this->y0 = this->y;
+					this->dy0 = this->dy;
+					this->k.col(0) = this->k.col(6);
+					this->dk.col(0) = this->dk.col(6);
+					// a shortened last step should not shrink the next one
+					this->stepSize = last ? ::std::max(this->stepSize, h * factor) : h * factor;
+				}
+				else
+				{
+					++this->rejectedSteps;
+					this->stepSize = h * factor;
+					
+					if (this->stepSize < this->minimumStepSize)
+					{
+						this->dynamic->setPosition(this->y0);
+						this->dynamic->setVelocity(this->dy0);
+						this->dynamic->setAcceleration(this->dk.col(0));
+						throw Exception("rl::mdl::DormandPrinceIntegrator::integrate() - Step size below minimum");
+					}
+				}
+			}
+			
+			this->dynamic->setPosition(this->y0);
+			this->dynamic->setVelocity(this->dy0);
+			this->dynamic->setAcceleration(this->dk.col(0));
+			this->cached = true;
+		}
+		
+		void
+		DormandPrinceIntegrator::resetStatistics()
+		{
+			this->acceptedSteps = 0;
+			this->evaluations = 0;
+			this->rejectedSteps = 0;
+		}
+		
+		void
+		DormandPrinceIntegrator::resize()
+		{
+			if (static_cast<::std::size_t>(this->y0.size()) != this->dynamic->getDofPosition() || static_cast<::std::size_t>(this->dy0.size()) != this->dynamic->getDof())
+			{
+				this->cached = false;
+			}
+			
+			this->de.resize(this->dynamic->getDof());
+			this->dk.resize(this->dynamic->getDof(), 7);
+			this->dy.resize(this->dynamic->getDof());
+			this->dy0.resize(this->dynamic->getDof());
+			this->e.resize(this->dynamic->getDofPosition());
+			this->k.resize(this->dynamic->getDof(), 7);
+			this->tau.resize(this->dynamic->getDof());
+			this->tau0.resize(this->dynamic->getDof());
+			this->y.resize(this->dynamic->getDofPosition());
+			this->y0.resize(this->dynamic->getDofPosition());
+		}
+		
+		void
+		DormandPrinceIntegrator::setAbsoluteTolerance(const ::rl::math::Real& absoluteTolerance)
+		{
+			this->absoluteTolerance = absoluteTolerance;
+		}
+		
+		void
+		DormandPrinceIntegrator::setMinimumStepSize(const ::rl::math::Real& minimumStepSize)
+		{
+			this->minimumStepSize = minimumStepSize;
+		}
+		
+		void
+		DormandPrinceIntegrator::setRelativeTolerance(const ::rl::math::Real& relativeTolerance)
+		{
+			this->relativeTolerance = relativeTolerance;
+		}
+		
+		void
+		DormandPrinceIntegrator::setStepSize(const ::rl::math::Real& stepSize)
+		{
+			this->cached = false;
+			this->stepSize = stepSize;
+		}
+	}
+}
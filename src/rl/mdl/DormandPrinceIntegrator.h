@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_DORMANDPRINCEINTEGRATOR_H
+#define RL_MDL_DORMANDPRINCEINTEGRATOR_H
+
+#include <cstddef>
+#include <rl/math/Matrix.h>
+#include <rl/math/Vector.h>
+
+#include "Integrator.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Adaptive integration via the embedded Runge-Kutta 5(4) pair of
+		 * Dormand and Prince.
+		 *
+		 * The interval \f$\Delta t\f$ given to integrate() is covered by as
+		 * many internal steps \f$h\f$ as needed to keep the estimated local
+		 * error of position and velocity below
+		 * \f$\epsilon_{\mathrm{abs}} + \epsilon_{\mathrm{rel}} \, |y|\f$ in
+		 * the root mean square norm. The step size is adapted via
+		 * \f$h_{\mathrm{new}} = 0.9 \, h \, \mathrm{err}^{-1/5}\f$ and
+		 * carried over to the next call. Each step requires six evaluations of
+		 * the forward dynamics, as the last stage of an accepted step is reused
+		 * as the first stage of the next one. This includes the first step of
+		 * the next call if position, velocity, and torque were not modified in
+		 * between, otherwise the first stage is evaluated again. The torque is
+		 * held constant over the interval.
+		 *
+		 * All temporaries are allocated on construction.
+		 *
+		 * J. R. Dormand and P. J. Prince. A family of embedded Runge-Kutta
+		 * formulae. Journal of Computational and Applied Mathematics,
+		 * 6(1):19-26, 1980.
+		 *
+		 * @pre Dynamic::setPosition()
+		 * @pre Dynamic::setVelocity()
+		 * @pre Dynamic::setTorque()
+		 * @post Dynamic::getPosition()
+		 * @post Dynamic::getVelocity()
+		 * @post Dynamic::getAcceleration()
+		 *
+		 * @see Dynamic::forwardDynamics()
+		 */
+		class RL_MDL_EXPORT DormandPrinceIntegrator : public Integrator
+		{
+		public:
+			DormandPrinceIntegrator(Dynamic* dynamic);
+			
+			virtual ~DormandPrinceIntegrator();
+			
+			const ::rl::math::Real& getAbsoluteTolerance() const;
+			
+			/**
+			 * @return Number of accepted steps since last call of resetStatistics()
+			 */
+			const ::std::size_t& getAcceptedSteps() const;
+			
+			/**
+			 * @return Number of forward dynamics evaluations since last call of
+			 * resetStatistics()
+			 */
+			const ::std::size_t& getEvaluations() const;
+			
+			const ::rl::math::Real& getMinimumStepSize() const;
+			
+			/**
+			 * @return Number of rejected steps since last call of resetStatistics()
+			 */
+			const ::std::size_t& getRejectedSteps() const;
+			
+			const ::rl::math::Real& getRelativeTolerance() const;
+			
+			/**
+			 * @return Step size proposed for the next step, zero before the
+			 * first call of integrate()
+			 */
+			const ::rl::math::Real& getStepSize() const;
+			
+			/**
+			 * @throws Exception if the step size required for the tolerances
+			 * falls below getMinimumStepSize()
+			 */
+			void integrate(const ::rl::math::Real& dt);
+			
+			void resetStatistics();
+			
+			void setAbsoluteTolerance(const ::rl::math::Real& absoluteTolerance);
+			
+			void setMinimumStepSize(const ::rl::math::Real& minimumStepSize);
+			
+			void setRelativeTolerance(const ::rl::math::Real& relativeTolerance);
+			
+			/**
+			 * Set initial step size and discard the last stage of the previous
+			 * call, e.g., before an unrelated integration or after modifying
+			 * the model other than its state and torque.
+			 *
+			 * @param[in] stepSize Initial step size for the next call of
+			 * integrate(), zero for using its interval
+			 */
+			void setStepSize(const ::rl::math::Real& stepSize);
+			
+		protected:
+			
+		private:
+			void resize();
+			
+			::rl::math::Real absoluteTolerance;
+			
+			::std::size_t acceptedSteps;
+			
+			/** First stage is valid for final state and torque of previous call. */
+			bool cached;
+			
+			/** Velocity error estimate. */
+			::rl::math::Vector de;
+			
+			/** Velocity derivatives of all stages. */
+			::rl::math::Matrix dk;
+			
+			::rl::math::Vector dy;
+			
+			::rl::math::Vector dy0;
+			
+			/** Position error estimate. */
+			::rl::math::Vector e;
+			
+			::std::size_t evaluations;
+			
+			/** Position derivatives of all stages. */
+			::rl::math::Matrix k;
+			
+			::rl::math::Real minimumStepSize;
+			
+			::std::size_t rejectedSteps;
+			
+			::rl::math::Real relativeTolerance;
+			
+			::rl::math::Real stepSize;
+			
+			::rl::math::Vector tau;
+			
+			/** Torque of first stage. */
+			::rl::math::Vector tau0;
+			
+			::rl::math::Vector y;
+			
+			::rl::math::Vector y0;
+		};
+	}
+}
+
+#endif // RL_MDL_DORMANDPRINCEINTEGRATOR_H
@@ -31,6 +31,7 @@
 #include <rl/math/Rotation.h>
 #include <rl/math/Spatial.h>
 
+#include "Body.h"
 #include "EulerCauchyIntegrator.h"
 #include "Exception.h"
 #include "Dynamic.h"
@@ -45,10 +46,22 @@ namespace rl
 	{
 		Dynamic::Dynamic() :
 			Kinematic(),
+			D(),
+			dAdq(),
+			dAdqd(),
+			dqdddq(),
+			dqdddqd(),
+			dtaudq(),
+			dtaudqd(),
+			dVdq(),
+			F(),
 			G(),
+			IA(),
 			invM(),
 			invMx(),
+			L(),
 			M(),
+			U(),
 			V()
 		{
 		}
@@ -68,17 +81,46 @@ namespace rl
 		{
 			::rl::math::Vector3 g = this->getWorldGravity();
 			
-			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+			V.resize(this->getDof());
+			V.setZero();
 			
-			this->setAcceleration(tmp);
+			this->setAcceleration(V);
 			this->setWorldGravity(::rl::math::Vector3::Zero());
 			
 			this->inverseDynamics();
-			V = this->getTorque();
+			this->getTorque(V);
 			
 			this->setWorldGravity(g);
 		}
 		
+		void
+		Dynamic::calculateForwardDynamicsDerivatives()
+		{
+			this->calculateForwardDynamicsDerivatives(this->dqdddq, this->dqdddqd, this->invM);
+		}
+		
+		void
+		Dynamic::calculateForwardDynamicsDerivatives(::rl::math::Matrix& dqdddq, ::rl::math::Matrix& dqdddqd, ::rl::math::Matrix& invM)
+		{
+			assert(dqdddq.rows() == this->getDof());
+			assert(dqdddq.cols() == this->getDof());
+			assert(dqdddqd.rows() == this->getDof());
+			assert(dqdddqd.cols() == this->getDof());
+			
+			::rl::math::Vector tau = this->getTorque();
+			
+			this->forwardDynamics();
+			this->calculateMassMatrixInverse(invM);
+			this->calculateInverseDynamicsDerivatives(this->dtaudq, this->dtaudqd);
+			
+			// -M^-1 * dtau/dq
+			dqdddq.noalias() = -invM * this->dtaudq;
+			// -M^-1 * dtau/dqd
+			dqdddqd.noalias() = -invM * this->dtaudqd;
+			
+			this->setTorque(tau);
+		}
+		
 		void
 		Dynamic::calculateGravity()
 		{
@@ -88,13 +130,107 @@ namespace rl
 		void
 		Dynamic::calculateGravity(::rl::math::Vector& G)
 		{
-			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+			G.resize(this->getDof());
+			G.setZero();
 			
-			this->setVelocity(tmp);
-			this->setAcceleration(tmp);
+			this->setVelocity(G);
+			this->setAcceleration(G);
 			
 			this->inverseDynamics();
-			G = this->getTorque();
+			this->getTorque(G);
+		}
+		
+		void
+		Dynamic::calculateInverseDynamicsDerivatives()
+		{
+			this->calculateInverseDynamicsDerivatives(this->dtaudq, this->dtaudqd);
+		}
+		
+		void
+		Dynamic::calculateInverseDynamicsDerivatives(::rl::math::Matrix& dtaudq, ::rl::math::Matrix& dtaudqd)
+		{
+			assert(dtaudq.rows() == this->getDof());
+			assert(dtaudq.cols() == this->getDof());
+			assert(dtaudqd.rows() == this->getDof());
+			assert(dtaudqd.cols() == this->getDof());
+			
+			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			{
+				(*i)->inverseDynamicsDerivatives1();
+			}
+			
+			for (::std::vector<Element*>::reverse_iterator i = this->elements.rbegin(); i != this->elements.rend(); ++i)
+			{
+				(*i)->inverseDynamicsDerivatives2();
+			}
+			
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			{
+				// X_0^-1 * v
+				::rl::math::MotionVector vIn = this->joints[i]->in->x / this->joints[i]->in->v;
+				::rl::math::MotionVector vOut = this->joints[i]->out->x / this->joints[i]->out->v;
+				// X_0^-1 * a
+				::rl::math::MotionVector aIn = this->joints[i]->in->x / this->joints[i]->in->a;
+				
+				for (::std::size_t k = 0; k < this->joints[i]->getDof(); ++k)
+				{
+					// X_0^-1 * S
+					::rl::math::MotionVector s = this->joints[i]->out->x / ::rl::math::MotionVector(this->joints[i]->S.col(k));
+					this->S.col(j + k) = s.matrix();
+					// v x S
+					::rl::math::MotionVector dv = vIn.cross(s);
+					this->dVdq.col(j + k) = dv.matrix();
+					// a x S + v x v x S
+					this->dAdq.col(j + k) = (aIn.cross(s) + vIn.cross(dv)).matrix();
+					// (v + v) x S
+					this->dAdqd.col(j + k) = (vIn + vOut).cross(s).matrix();
+				}
+			}
+			
+			dtaudq.setZero();
+			dtaudqd.setZero();
+			
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			{
+				const Frame* out = this->joints[i]->out;
+				
+				// X_0^* * f^x
+				::rl::math::ForceVector fX = out->fC - out->x / out->f;
+				
+				for (::std::size_t k = j; k < j + this->joints[i]->getDof(); ++k)
+				{
+					::rl::math::MotionVector s(this->S.col(k));
+					// S^T * I^c
+					::rl::math::ForceVector y = out->iC * s;
+					// S^T * B^c
+					::rl::math::Vector6 z = out->bC.transpose() * this->S.col(k);
+					
+					for (::std::size_t l = j; l < j + this->joints[i]->getDof(); ++l)
+					{
+						// S^T * (I^c * dA/dq + B^c * dV/dq + S x* f^x)
+						dtaudq(k, l) = y.matrix().dot(this->dAdq.col(l)) + z.dot(this->dVdq.col(l)) + ::rl::math::MotionVector(this->S.col(l)).cross(fX).dot(s);
+						// S^T * (I^c * dA/dqd + B^c * S)
+						dtaudqd(k, l) = y.matrix().dot(this->dAdqd.col(l)) + z.dot(this->S.col(l));
+					}
+					
+					// S x* f^c + I^c * dA/dq + B^c * dV/dq
+					::rl::math::ForceVector fq = s.cross(out->fC) + out->iC * ::rl::math::MotionVector(this->dAdq.col(k)) + ::rl::math::ForceVector(out->bC * this->dVdq.col(k));
+					// I^c * dA/dqd + B^c * S
+					::rl::math::ForceVector fqd = out->iC * ::rl::math::MotionVector(this->dAdqd.col(k)) + ::rl::math::ForceVector(out->bC * this->S.col(k));
+					
+					for (::std::size_t l = this->parents[j]; l < this->parents.size(); l = this->parents[l])
+					{
+						// S^T * (I^c * dA/dq + B^c * dV/dq + S x* f^x)
+						dtaudq(k, l) = y.matrix().dot(this->dAdq.col(l)) + z.dot(this->dVdq.col(l)) + ::rl::math::MotionVector(this->S.col(l)).cross(fX).dot(s);
+						// S^T * (I^c * dA/dqd + B^c * S)
+						dtaudqd(k, l) = y.matrix().dot(this->dAdqd.col(l)) + z.dot(this->S.col(l));
+						// S^T * (S x* f^c + I^c * dA/dq + B^c * dV/dq)
+						dtaudq(l, k) = fq.dot(::rl::math::MotionVector(this->S.col(l)));
+						// S^T * (I^c * dA/dqd + B^c * S)
+						dtaudqd(l, k) = fqd.dot(::rl::math::MotionVector(this->S.col(l)));
+					}
+				}
+			}
 		}
 		
 		void
@@ -106,27 +242,77 @@ namespace rl
 		void
 		Dynamic::calculateMassMatrix(::rl::math::Matrix& M)
 		{
-			::rl::math::Vector3 g = this->getWorldGravity();
+			assert(M.rows() == this->getDof());
+			assert(M.cols() == this->getDof());
 			
-			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			{
+				(*i)->compositeRigidBody1();
+			}
 			
-			this->setVelocity(tmp);
-			this->setWorldGravity(::rl::math::Vector3::Zero());
+			for (::std::vector<Element*>::reverse_iterator i = this->elements.rbegin(); i != this->elements.rend(); ++i)
+			{
+				(*i)->compositeRigidBody2();
+			}
 			
-			for (::std::size_t i = 0; i < this->getDof(); ++i)
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
-				for (::std::size_t j = 0; j < this->getDof(); ++j)
+				for (::std::size_t k = 0; k < this->joints[i]->getDof(); ++k)
 				{
-					tmp(j) = i == j ? 1 : 0;
+					// X_0^-1 * S
+					this->S.col(j + k) = (this->joints[i]->out->x / ::rl::math::MotionVector(this->joints[i]->S.col(k))).matrix();
 				}
-				
-				this->setAcceleration(tmp);
-				this->inverseDynamics();
-				
-				M.col(i) = this->getTorque();
 			}
 			
-			this->setWorldGravity(g);
+			M.setZero();
+			
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			{
+				for (::std::size_t k = j; k < j + this->joints[i]->getDof(); ++k)
+				{
+					// I^c * S
+					::rl::math::ForceVector f = this->joints[i]->out->iC * ::rl::math::MotionVector(this->S.col(k));
+					
+					for (::std::size_t l = k; l < this->parents.size(); l = this->parents[l])
+					{
+						// S^T * I^c * S
+						M(l, k) = this->S.col(l).dot(f.matrix());
+						M(k, l) = M(l, k);
+					}
+				}
+			}
+		}
+		
+		void
+		Dynamic::calculateMassMatrixFactorization()
+		{
+			this->calculateMassMatrixFactorization(this->M, this->L);
+		}
+		
+		void
+		Dynamic::calculateMassMatrixFactorization(const ::rl::math::Matrix& M, ::rl::math::Matrix& L) const
+		{
+			assert(M.rows() == this->parents.size());
+			assert(M.cols() == this->parents.size());
+			
+			L = M;
+			
+			for (::std::size_t k = this->parents.size(); k-- > 0;)
+			{
+				for (::std::size_t i = this->parents[k]; i < this->parents.size(); i = this->parents[i])
+				{
+					// L_ki = M_ki / D_k
+					::rl::math::Real a = L(k, i) / L(k, k);
+					
+					for (::std::size_t j = i; j < this->parents.size(); j = this->parents[j])
+					{
+						// M_ij - L_ki * M_kj
+						L(i, j) -= a * L(k, j);
+					}
+					
+					L(k, i) = a;
+				}
+			}
 		}
 		
 		void
@@ -138,27 +324,83 @@ namespace rl
 		void
 		Dynamic::calculateMassMatrixInverse(::rl::math::Matrix& invM)
 		{
-			::rl::math::Vector3 g = this->getWorldGravity();
+			assert(invM.rows() == this->parents.size());
+			assert(invM.cols() == this->parents.size());
 			
-			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+			::std::size_t n = this->parents.size();
 			
-			this->setVelocity(tmp);
-			this->setWorldGravity(::rl::math::Vector3::Zero());
+			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			{
+				(*i)->compositeRigidBody1();
+			}
+			
+			for (::std::vector<Element*>::reverse_iterator i = this->elements.rbegin(); i != this->elements.rend(); ++i)
+			{
+				(*i)->compositeRigidBody2();
+			}
+			
+			this->IA.setZero();
 			
-			for (::std::size_t i = 0; i < this->getDof(); ++i)
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
-				for (::std::size_t j = 0; j < this->getDof(); ++j)
+				for (::std::size_t k = 0; k < this->joints[i]->getDof(); ++k)
 				{
-					tmp(j) = i == j ? 1 : 0;
+					// X_0^-1 * S
+					this->S.col(j + k) = (this->joints[i]->out->x / ::rl::math::MotionVector(this->joints[i]->S.col(k))).matrix();
 				}
 				
-				this->setTorque(tmp);
-				this->forwardDynamics();
+				// I^c of bodies rigidly attached to last degree of freedom
+				this->IA.middleCols<6>(6 * (j + this->joints[i]->getDof() - 1)) += this->joints[i]->out->iC.matrix();
 				
-				invM.col(i) = this->getAcceleration();
+				if (this->parents[j] < n)
+				{
+					this->IA.middleCols<6>(6 * this->parents[j]) -= this->joints[i]->out->iC.matrix();
+				}
 			}
 			
-			this->setWorldGravity(g);
+			invM.setZero();
+			this->F.setZero();
+			
+			for (::std::size_t k = n; k-- > 0;)
+			{
+				// I^A * S
+				this->U.col(k) = this->IA.middleCols<6>(6 * k) * this->S.col(k);
+				// (S^T * U)^-1
+				this->D(k) = 1 / this->S.col(k).dot(this->U.col(k));
+				
+				// D^-1 - D^-1 * S^T * F
+				invM(k, k) = this->D(k);
+				invM.row(k).tail(n - k - 1).noalias() -= this->D(k) * this->S.col(k).transpose() * this->F.block(0, n * k + k + 1, 6, n - k - 1);
+				
+				if (this->parents[k] < n)
+				{
+					// F + U * M^-1
+					this->F.block(0, n * this->parents[k] + k, 6, n - k) += this->F.block(0, n * k + k, 6, n - k);
+					this->F.block(0, n * this->parents[k] + k, 6, n - k).noalias() += this->U.col(k) * invM.row(k).tail(n - k);
+					// I^A - U * D^-1 * U^T
+					this->IA.middleCols<6>(6 * this->parents[k]) += this->IA.middleCols<6>(6 * k);
+					this->IA.middleCols<6>(6 * this->parents[k]).noalias() -= this->U.col(k) * this->D(k) * this->U.col(k).transpose();
+				}
+			}
+			
+			for (::std::size_t k = 0; k < n; ++k)
+			{
+				if (this->parents[k] < n)
+				{
+					// M^-1 - D^-1 * U^T * P
+					invM.row(k).tail(n - k).noalias() -= this->D(k) * this->U.col(k).transpose() * this->F.block(0, n * this->parents[k] + k, 6, n - k);
+					// S * M^-1 + P
+					this->F.block(0, n * k + k, 6, n - k) = this->F.block(0, n * this->parents[k] + k, 6, n - k);
+					this->F.block(0, n * k + k, 6, n - k).noalias() += this->S.col(k) * invM.row(k).tail(n - k);
+				}
+				else
+				{
+					// S * M^-1
+					this->F.block(0, n * k + k, 6, n - k).noalias() = this->S.col(k) * invM.row(k).tail(n - k);
+				}
+			}
+			
+			invM.triangularView<::Eigen::StrictlyLower>() = invM.transpose().triangularView<::Eigen::StrictlyLower>();
 		}
 		
 		void
@@ -173,6 +415,12 @@ namespace rl
 			invMx = J * invM * J.transpose();
 		}
 		
+		Model*
+		Dynamic::clone() const
+		{
+			return new Dynamic(*this);
+		}
+		
 		void
 		Dynamic::eulerCauchy(const ::rl::math::Real& dt)
 		{
@@ -183,19 +431,67 @@ namespace rl
 		void
 		Dynamic::forwardDynamics()
 		{
-			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			for (::std::vector<Operation>::iterator i = this->operations.begin(); i != this->operations.end(); ++i)
 			{
-				(*i)->forwardDynamics1();
+				switch (i->type)
+				{
+				case Operation::Type::body:
+					static_cast<Body*>(i->element)->Body::forwardDynamics1();
+					break;
+				case Operation::Type::frame:
+					static_cast<Frame*>(i->element)->Frame::forwardDynamics1();
+					break;
+				case Operation::Type::joint:
+					static_cast<Joint*>(i->element)->Joint::forwardDynamics1();
+					break;
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::forwardDynamics1();
+					break;
+				case Operation::Type::world:
+					static_cast<World*>(i->element)->World::forwardDynamics1();
+					break;
+				case Operation::Type::element:
+					i->element->forwardDynamics1();
+					break;
+				default:
+					break;
+				}
 			}
 			
-			for (::std::vector<Element*>::reverse_iterator i = this->elements.rbegin(); i != this->elements.rend(); ++i)
+			for (::std::vector<Operation>::reverse_iterator i = this->operations.rbegin(); i != this->operations.rend(); ++i)
 			{
-				(*i)->forwardDynamics2();
+				switch (i->type)
+				{
+				case Operation::Type::joint:
+					static_cast<Joint*>(i->element)->Joint::forwardDynamics2();
+					break;
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::forwardDynamics2();
+					break;
+				case Operation::Type::element:
+					i->element->forwardDynamics2();
+					break;
+				default:
+					break;
+				}
 			}
 			
-			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			for (::std::vector<Operation>::iterator i = this->operations.begin(); i != this->operations.end(); ++i)
 			{
-				(*i)->forwardDynamics3();
+				switch (i->type)
+				{
+				case Operation::Type::joint:
+					static_cast<Joint*>(i->element)->Joint::forwardDynamics3();
+					break;
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::forwardDynamics3();
+					break;
+				case Operation::Type::element:
+					i->element->forwardDynamics3();
+					break;
+				default:
+					break;
+				}
 			}
 		}
 		
@@ -205,12 +501,42 @@ namespace rl
 			return this->V;
 		}
 		
+		const ::rl::math::Matrix&
+		Dynamic::getForwardDynamicsPositionDerivative() const
+		{
+			return this->dqdddq;
+		}
+		
+		const ::rl::math::Matrix&
+		Dynamic::getForwardDynamicsVelocityDerivative() const
+		{
+			return this->dqdddqd;
+		}
+		
 		const ::rl::math::Vector&
 		Dynamic::getGravity() const
 		{
 			return this->G;
 		}
 		
+		const ::rl::math::Matrix&
+		Dynamic::getInverseDynamicsPositionDerivative() const
+		{
+			return this->dtaudq;
+		}
+		
+		const ::rl::math::Matrix&
+		Dynamic::getInverseDynamicsVelocityDerivative() const
+		{
+			return this->dtaudqd;
+		}
+		
+		const ::rl::math::Matrix&
+		Dynamic::getMassMatrixFactorization() const
+		{
+			return this->L;
+		}
+		
 		const ::rl::math::Matrix&
 		Dynamic::getMassMatrixInverse() const
 		{
@@ -232,23 +558,73 @@ namespace rl
 		void
 		Dynamic::inverseDynamics()
 		{
-			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			for (::std::vector<Operation>::iterator i = this->operations.begin(); i != this->operations.end(); ++i)
 			{
-				(*i)->inverseDynamics1();
+				switch (i->type)
+				{
+				case Operation::Type::body:
+					static_cast<Body*>(i->element)->Body::inverseDynamics1();
+					break;
+				case Operation::Type::frame:
+					static_cast<Frame*>(i->element)->Frame::inverseDynamics1();
+					break;
+				case Operation::Type::joint:
+					static_cast<Joint*>(i->element)->Joint::forwardVelocity();
+					static_cast<Joint*>(i->element)->Joint::forwardAcceleration();
+					break;
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::forwardVelocity();
+					static_cast<Transform*>(i->element)->Transform::forwardAcceleration();
+					break;
+				case Operation::Type::world:
+					static_cast<World*>(i->element)->World::inverseDynamics1();
+					break;
+				case Operation::Type::element:
+					i->element->inverseDynamics1();
+					break;
+				default:
+					break;
+				}
 			}
 			
-			for (::std::vector<Element*>::reverse_iterator i = this->elements.rbegin(); i != this->elements.rend(); ++i)
+			for (::std::vector<Operation>::reverse_iterator i = this->operations.rbegin(); i != this->operations.rend(); ++i)
 			{
-				(*i)->inverseDynamics2();
+				switch (i->type)
+				{
+				case Operation::Type::joint:
+					static_cast<Joint*>(i->element)->Joint::inverseForce();
+					break;
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::inverseForce();
+					break;
+				case Operation::Type::element:
+					i->element->inverseDynamics2();
+					break;
+				default:
+					break;
+				}
 			}
 		}
 		
 		void
 		Dynamic::inverseForce()
 		{
-			for (::std::vector<Element*>::reverse_iterator i = this->elements.rbegin(); i != this->elements.rend(); ++i)
+			for (::std::vector<Operation>::reverse_iterator i = this->operations.rbegin(); i != this->operations.rend(); ++i)
 			{
-				(*i)->inverseForce();
+				switch (i->type)
+				{
+				case Operation::Type::joint:
+					static_cast<Joint*>(i->element)->Joint::inverseForce();
+					break;
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::inverseForce();
+					break;
+				case Operation::Type::element:
+					i->element->inverseForce();
+					break;
+				default:
+					break;
+				}
 			}
 		}
 		
@@ -259,12 +635,59 @@ namespace rl
 			integrator.integrate(dt);
 		}
 		
+		void
+		Dynamic::solveMassMatrix(::rl::math::MatrixRef X) const
+		{
+			this->solveMassMatrix(this->L, X);
+		}
+		
+		void
+		Dynamic::solveMassMatrix(const ::rl::math::Matrix& L, ::rl::math::MatrixRef X) const
+		{
+			assert(L.rows() == this->parents.size());
+			assert(L.cols() == this->parents.size());
+			assert(X.rows() == this->parents.size());
+			
+			for (::std::size_t i = this->parents.size(); i-- > 0;)
+			{
+				for (::std::size_t j = this->parents[i]; j < this->parents.size(); j = this->parents[j])
+				{
+					// L^-T * B
+					X.row(j) -= L(i, j) * X.row(i);
+				}
+			}
+			
+			for (::std::size_t i = 0; i < this->parents.size(); ++i)
+			{
+				// D^-1 * L^-T * B
+				X.row(i) /= L(i, i);
+				
+				for (::std::size_t j = this->parents[i]; j < this->parents.size(); j = this->parents[j])
+				{
+					// L^-1 * D^-1 * L^-T * B
+					X.row(i) -= L(i, j) * X.row(j);
+				}
+			}
+		}
+		
 		void
 		Dynamic::update()
 		{
 			Kinematic::update();
 			
+			this->D = ::rl::math::Vector::Zero(this->getDof());
+			this->dAdq = ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, this->getDof());
+			this->dAdqd = ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, this->getDof());
+			this->dqdddq = ::rl::math::Matrix::Zero(this->getDof(), this->getDof());
+			this->dqdddqd = ::rl::math::Matrix::Zero(this->getDof(), this->getDof());
+			this->dtaudq = ::rl::math::Matrix::Zero(this->getDof(), this->getDof());
+			this->dtaudqd = ::rl::math::Matrix::Zero(this->getDof(), this->getDof());
+			this->dVdq = ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, this->getDof());
+			this->F = ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, this->getDof() * this->getDof());
+			this->IA = ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, 6 * this->getDof());
+			this->L = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
 			this->M = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
+			this->U = ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, this->getDof());
 			this->V = ::rl::math::Vector::Zero(this->getDof());
 			this->G = ::rl::math::Vector::Zero(this->getDof());
 			this->invM = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
@@ -59,10 +59,53 @@ namespace rl
 			 * @pre setPosition()
 			 * @pre setVelocity()
 			 *
+			 * @post Acceleration is set to zero.
+			 *
+			 * Does not allocate if V already has the correct size.
+			 *
 			 * @see inverseDynamics()
 			 */
 			void calculateCentrifugalCoriolis(::rl::math::Vector& V);
 			
+			/**
+			 * Calculate derivatives of forward dynamics.
+			 *
+			 * @pre setPosition()
+			 * @pre setVelocity()
+			 * @pre setTorque()
+			 * @post getAcceleration()
+			 * @post getForwardDynamicsPositionDerivative()
+			 * @post getForwardDynamicsVelocityDerivative()
+			 * @post getMassMatrixInverse()
+			 *
+			 * @see calculateInverseDynamicsDerivatives()
+			 */
+			void calculateForwardDynamicsDerivatives();
+			
+			/**
+			 * Calculate derivatives of forward dynamics.
+			 *
+			 * Acceleration is calculated via forwardDynamics(), derivatives
+			 * follow from the derivatives of inverse dynamics at this
+			 * acceleration and the mass matrix inverse.
+			 *
+			 * \f[ \frac{\partial \ddot{\vec{q}}}{\partial \vec{q}} = -\matr{M}^{-1}(\vec{q}) \, \frac{\partial \vec{\tau}}{\partial \vec{q}} \f]
+			 * \f[ \frac{\partial \ddot{\vec{q}}}{\partial \dot{\vec{q}}} = -\matr{M}^{-1}(\vec{q}) \, \frac{\partial \vec{\tau}}{\partial \dot{\vec{q}}} \f]
+			 * \f[ \frac{\partial \ddot{\vec{q}}}{\partial \vec{\tau}} = \matr{M}^{-1}(\vec{q}) \f]
+			 *
+			 * @param[out] dqdddq Derivative of acceleration with respect to position
+			 * @param[out] dqdddqd Derivative of acceleration with respect to velocity
+			 * @param[out] invM Derivative of acceleration with respect to torque \f$\matr{M}^{-1}(\vec{q})\f$
+			 *
+			 * @pre setPosition()
+			 * @pre setVelocity()
+			 * @pre setTorque()
+			 * @post getAcceleration()
+			 *
+			 * @see calculateInverseDynamicsDerivatives()
+			 */
+			void calculateForwardDynamicsDerivatives(::rl::math::Matrix& dqdddq, ::rl::math::Matrix& dqdddqd, ::rl::math::Matrix& invM);
+			
 			/**
 			 * Calculate gravity vector.
 			 *
@@ -80,36 +123,113 @@ namespace rl
 			 *
 			 * @pre setPosition()
 			 *
+			 * @post Velocity and acceleration are set to zero.
+			 *
+			 * Does not allocate if G already has the correct size.
+			 *
 			 * @see inverseDynamics()
 			 */
 			void calculateGravity(::rl::math::Vector& G);
 			
 			/**
-			 * Calculate joint space mass matrix.
+			 * Calculate derivatives of inverse dynamics.
 			 *
 			 * @pre setPosition()
-			 * @post getMassMatrix()
+			 * @pre setVelocity()
+			 * @pre setAcceleration()
+			 * @post getInverseDynamicsPositionDerivative()
+			 * @post getInverseDynamicsVelocityDerivative()
+			 * @post getTorque()
 			 *
-			 * @see inverseDynamics()
+			 * @see calculateMassMatrix()
 			 */
-			void calculateMassMatrix();
+			void calculateInverseDynamicsDerivatives();
 			
 			/**
-			 * Calculate joint space mass matrix.
+			 * Calculate derivatives of inverse dynamics.
+			 *
+			 * Analytical derivatives of the recursive Newton-Euler algorithm,
+			 * evaluated in world coordinates with composite inertias, composite
+			 * inertia variations, and composite forces of one backward pass.
+			 * Derivatives with respect to position refer to the tangent space
+			 * of the joints as used by step(), i.e., have getDof() columns. The
+			 * derivative with respect to acceleration is the mass matrix.
 			 *
-			 * @param[out] M Joint space mass matrix \f$\matr{M}^{-1}(\vec{q})\f$
+			 * \f[ \frac{\partial \vec{\tau}}{\partial \vec{q}}, \frac{\partial \vec{\tau}}{\partial \dot{\vec{q}}} \f]
+			 *
+			 * @param[out] dtaudq Derivative of torque with respect to position
+			 * @param[out] dtaudqd Derivative of torque with respect to velocity
 			 *
 			 * @pre setPosition()
+			 * @pre setVelocity()
+			 * @pre setAcceleration()
+			 * @post getTorque()
 			 *
-			 * @see inverseDynamics()
+			 * @see calculateMassMatrix()
+			 */
+			void calculateInverseDynamicsDerivatives(::rl::math::Matrix& dtaudq, ::rl::math::Matrix& dtaudqd);
+			
+			/**
+			 * Calculate joint space mass matrix via composite-rigid-body algorithm.
+			 *
+			 * @pre setPosition()
+			 * @post getMassMatrix()
+			 * @post getOperationalPosition()
+			 */
+			void calculateMassMatrix();
+			
+			/**
+			 * Calculate joint space mass matrix via composite-rigid-body algorithm.
+			 *
+			 * Composite inertias are accumulated in world coordinates, entries
+			 * are only evaluated for pairs of degrees of freedom on a common path
+			 * to the root, all others are zero due to branch-induced sparsity.
+			 *
+			 * \f[ M_{ij} = \matr{S}_{i}^{\mathrm{T}} \, \matr{I}_{i}^{\mathrm{c}} \, \matr{S}_{j} \f]
+			 *
+			 * @param[out] M Joint space mass matrix \f$\matr{M}(\vec{q})\f$
+			 *
+			 * @pre setPosition()
+			 * @post getOperationalPosition()
 			 */
 			void calculateMassMatrix(::rl::math::Matrix& M);
 			
+			/**
+			 * Calculate factorization of joint space mass matrix.
+			 *
+			 * @pre calculateMassMatrix()
+			 * @post getMassMatrixFactorization()
+			 *
+			 * @see solveMassMatrix()
+			 */
+			void calculateMassMatrixFactorization();
+			
+			/**
+			 * Calculate factorization of joint space mass matrix.
+			 *
+			 * Sparse \f$\matr{L}^{\mathrm{T}} \matr{D} \matr{L}\f$ factorization
+			 * that preserves branch-induced sparsity, \f$L_{ij}\f$ is only nonzero
+			 * if degree of freedom \f$j\f$ is an ancestor of degree of freedom
+			 * \f$i\f$. The unit diagonal of \f$\matr{L}\f$ is not stored, the
+			 * diagonal of the result contains \f$\matr{D}\f$, the strictly lower
+			 * triangular part contains \f$\matr{L}\f$, the strictly upper
+			 * triangular part is not referenced.
+			 *
+			 * \f[ \matr{M}(\vec{q}) = \matr{L}^{\mathrm{T}} \, \matr{D} \, \matr{L} \f]
+			 *
+			 * @param[in] M Joint space mass matrix \f$\matr{M}(\vec{q})\f$
+			 * @param[out] L Factorization \f$\matr{L}\f$ and \f$\matr{D}\f$
+			 *
+			 * @see solveMassMatrix()
+			 */
+			void calculateMassMatrixFactorization(const ::rl::math::Matrix& M, ::rl::math::Matrix& L) const;
+			
 			/**
 			 * Calculate joint space mass matrix inverse.
 			 *
 			 * @pre setPosition()
 			 * @post getMassMatrixInverse()
+			 * @post getOperationalPosition()
 			 *
 			 * @see forwardDynamics()
 			 */
@@ -118,9 +238,14 @@ namespace rl
 			/**
 			 * Calculate joint space mass matrix inverse.
 			 *
+			 * Direct computation via articulated-body inertias in world
+			 * coordinates without unit torque sweeps of forwardDynamics(),
+			 * velocity, acceleration, and torque remain unchanged.
+			 *
 			 * @param[out] invM Joint space mass matrix inverse \f$\matr{M}^{-1}(\vec{q})\f$
 			 *
 			 * @pre setPosition()
+			 * @post getOperationalPosition()
 			 *
 			 * @see forwardDynamics()
 			 */
@@ -146,6 +271,8 @@ namespace rl
 			 */
 			void calculateOperationalMassMatrixInverse(const ::rl::math::Matrix& J, const ::rl::math::Matrix& invM, ::rl::math::Matrix& invMx) const;
 			
+			Model* clone() const;
+			
 			RL_MDL_DEPRECATED void eulerCauchy(const ::rl::math::Real& dt);
 			
 			/**
@@ -170,6 +297,24 @@ namespace rl
 			 */
 			const ::rl::math::Vector& getCentrifugalCoriolis() const;
 			
+			/**
+			 * Access calculated derivative of forward dynamics with respect to position.
+			 *
+			 * @return Derivative \f$\frac{\partial \ddot{\vec{q}}}{\partial \vec{q}}\f$
+			 *
+			 * @pre calculateForwardDynamicsDerivatives()
+			 */
+			const ::rl::math::Matrix& getForwardDynamicsPositionDerivative() const;
+			
+			/**
+			 * Access calculated derivative of forward dynamics with respect to velocity.
+			 *
+			 * @return Derivative \f$\frac{\partial \ddot{\vec{q}}}{\partial \dot{\vec{q}}}\f$
+			 *
+			 * @pre calculateForwardDynamicsDerivatives()
+			 */
+			const ::rl::math::Matrix& getForwardDynamicsVelocityDerivative() const;
+			
 			/**
 			 * Access calculated gravity vector.
 			 *
@@ -180,6 +325,34 @@ namespace rl
 			 */
 			const ::rl::math::Vector& getGravity() const;
 			
+			/**
+			 * Access calculated derivative of inverse dynamics with respect to position.
+			 *
+			 * @return Derivative \f$\frac{\partial \vec{\tau}}{\partial \vec{q}}\f$
+			 *
+			 * @pre calculateInverseDynamicsDerivatives()
+			 */
+			const ::rl::math::Matrix& getInverseDynamicsPositionDerivative() const;
+			
+			/**
+			 * Access calculated derivative of inverse dynamics with respect to velocity.
+			 *
+			 * @return Derivative \f$\frac{\partial \vec{\tau}}{\partial \dot{\vec{q}}}\f$
+			 *
+			 * @pre calculateInverseDynamicsDerivatives()
+			 */
+			const ::rl::math::Matrix& getInverseDynamicsVelocityDerivative() const;
+			
+			/**
+			 * Access calculated factorization of joint space mass matrix.
+			 *
+			 * @return Factorization \f$\matr{L}\f$ and \f$\matr{D}\f$ of \f$\matr{M}(\vec{q})\f$
+			 *
+			 * @pre calculateMassMatrix()
+			 * @pre calculateMassMatrixFactorization()
+			 */
+			const ::rl::math::Matrix& getMassMatrixFactorization() const;
+			
 			/**
 			 * Access calculated joint space mass matrix inverse.
 			 *
@@ -230,9 +403,116 @@ namespace rl
 			
 			RL_MDL_DEPRECATED void rungeKuttaNystrom(const ::rl::math::Real& dt);
 			
+			/**
+			 * Solve with joint space mass matrix.
+			 *
+			 * @param[in,out] X Right-hand side \f$\matr{B}\f$ on input, solution \f$\matr{M}^{-1}(\vec{q}) \, \matr{B}\f$ on output
+			 *
+			 * @pre calculateMassMatrix()
+			 * @pre calculateMassMatrixFactorization()
+			 */
+			void solveMassMatrix(::rl::math::MatrixRef X) const;
+			
+			/**
+			 * Solve with joint space mass matrix.
+			 *
+			 * Back-substitution with both triangular factors, without forming
+			 * \f$\matr{M}^{-1}(\vec{q})\f$, e.g., for
+			 * \f$\matr{M}^{-1}(\vec{q}) \, \matr{J}^{\mathrm{T}}(\vec{q})\f$.
+			 *
+			 * \f[ \matr{X} = \matr{L}^{-1} \, \matr{D}^{-1} \, \matr{L}^{-\mathrm{T}} \, \matr{B} \f]
+			 *
+			 * @param[in] L Factorization \f$\matr{L}\f$ and \f$\matr{D}\f$
+			 * @param[in,out] X Right-hand side \f$\matr{B}\f$ on input, solution \f$\matr{M}^{-1}(\vec{q}) \, \matr{B}\f$ on output
+			 *
+			 * @see calculateMassMatrixFactorization()
+			 */
+			void solveMassMatrix(const ::rl::math::Matrix& L, ::rl::math::MatrixRef X) const;
+			
 			virtual void update();
 			
 		protected:
+			/**
+			 * Inverse articulated-body inertias along joint motion subspaces.
+			 *
+			 * \f[ D_{i}^{-1} = \bigl( \matr{S}_{i}^{\mathrm{T}} \, \matr{I}_{i}^{\mathrm{A}} \, \matr{S}_{i} \bigr)^{-1} \f]
+			 *
+			 * @pre calculateMassMatrixInverse()
+			 * */
+			::rl::math::Vector D;
+			
+			/**
+			 * Derivatives of joint accelerations with respect to position in world coordinates.
+			 *
+			 * \f[ \vec{a}_{\lambda(i)} \times \matr{S}_{i} + \vec{v}_{\lambda(i)} \times \vec{v}_{\lambda(i)} \times \matr{S}_{i} \f]
+			 *
+			 * @pre calculateInverseDynamicsDerivatives()
+			 * */
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic> dAdq;
+			
+			/**
+			 * Derivatives of joint accelerations with respect to velocity in world coordinates.
+			 *
+			 * \f[ (\vec{v}_{i} + \vec{v}_{\lambda(i)}) \times \matr{S}_{i} \f]
+			 *
+			 * @pre calculateInverseDynamicsDerivatives()
+			 * */
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic> dAdqd;
+			
+			/**
+			 * Derivative of forward dynamics with respect to position.
+			 *
+			 * @pre calculateForwardDynamicsDerivatives()
+			 *
+			 * @see getForwardDynamicsPositionDerivative()
+			 * */
+			::rl::math::Matrix dqdddq;
+			
+			/**
+			 * Derivative of forward dynamics with respect to velocity.
+			 *
+			 * @pre calculateForwardDynamicsDerivatives()
+			 *
+			 * @see getForwardDynamicsVelocityDerivative()
+			 * */
+			::rl::math::Matrix dqdddqd;
+			
+			/**
+			 * Derivative of inverse dynamics with respect to position.
+			 *
+			 * @pre calculateInverseDynamicsDerivatives()
+			 *
+			 * @see getInverseDynamicsPositionDerivative()
+			 * */
+			::rl::math::Matrix dtaudq;
+			
+			/**
+			 * Derivative of inverse dynamics with respect to velocity.
+			 *
+			 * @pre calculateInverseDynamicsDerivatives()
+			 *
+			 * @see getInverseDynamicsVelocityDerivative()
+			 * */
+			::rl::math::Matrix dtaudqd;
+			
+			/**
+			 * Derivatives of joint velocities with respect to position in world coordinates.
+			 *
+			 * \f[ \vec{v}_{\lambda(i)} \times \matr{S}_{i} \f]
+			 *
+			 * @pre calculateInverseDynamicsDerivatives()
+			 * */
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic> dVdq;
+			
+			/**
+			 * Force and acceleration propagation matrices in world coordinates.
+			 *
+			 * One block of size \f$6 \times n\f$ per degree of freedom.
+			 *
+			 * @pre calculateMassMatrixInverse()
+			 * */
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic> F;
+			
 			/**
 			 * Gravity vector
 			 *
@@ -244,6 +524,17 @@ namespace rl
 			 * */
 			::rl::math::Vector G;
 			
+			/**
+			 * Articulated-body inertias in world coordinates.
+			 *
+			 * One block of size \f$6 \times 6\f$ per degree of freedom.
+			 *
+			 * \f[ \matr{I}_{i}^{\mathrm{A}} \f]
+			 *
+			 * @pre calculateMassMatrixInverse()
+			 * */
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic> IA;
+			
 			/**
 			 * Joint space mass matrix inverse.
 			 *
@@ -266,6 +557,17 @@ namespace rl
 			 * */
 			::rl::math::Matrix invMx;
 			
+			/**
+			 * Factorization of joint space mass matrix.
+			 *
+			 * \f[ \matr{M}(\vec{q}) = \matr{L}^{\mathrm{T}} \, \matr{D} \, \matr{L} \f]
+			 *
+			 * @pre calculateMassMatrixFactorization()
+			 *
+			 * @see getMassMatrixFactorization()
+			 * */
+			::rl::math::Matrix L;
+			
 			/**
 			 * Joint space mass matrix.
 			 *
@@ -277,6 +579,15 @@ namespace rl
 			 * */
 			::rl::math::Matrix M;
 			
+			/**
+			 * Articulated-body inertias times joint motion subspaces in world coordinates.
+			 *
+			 * \f[ \matr{U}_{i} = \matr{I}_{i}^{\mathrm{A}} \, \matr{S}_{i} \f]
+			 *
+			 * @pre calculateMassMatrixInverse()
+			 * */
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic> U;
+			
 			/**
 			 * Centrifugal and Coriolis vector.
 			 *
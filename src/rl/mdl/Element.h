@@ -43,6 +43,10 @@ namespace rl
 			
 			virtual ~Element();
 			
+			virtual void compositeRigidBody1() = 0;
+			
+			virtual void compositeRigidBody2() = 0;
+			
 			virtual void forwardAcceleration() = 0;
 			
 			virtual void forwardDynamics1() = 0;
@@ -61,6 +65,10 @@ namespace rl
 			
 			virtual void inverseDynamics2() = 0;
 			
+			virtual void inverseDynamicsDerivatives1() = 0;
+			
+			virtual void inverseDynamicsDerivatives2() = 0;
+			
 			virtual void inverseForce() = 0;
 			
 			void setName(const ::std::string& name);
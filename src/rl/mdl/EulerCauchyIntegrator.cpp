@@ -24,6 +24,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+
 #include "Dynamic.h"
 #include "EulerCauchyIntegrator.h"
 
@@ -32,8 +33,12 @@ namespace rl
 	namespace mdl
 	{
 		EulerCauchyIntegrator::EulerCauchyIntegrator(Dynamic* dynamic) :
-			Integrator(dynamic)
+			Integrator(dynamic),
+			dy(),
+			f(),
+			y()
 		{
+			this->resize();
 		}
 		
 		EulerCauchyIntegrator::~EulerCauchyIntegrator()
@@ -43,22 +48,32 @@ namespace rl
 		void
 		EulerCauchyIntegrator::integrate(const ::rl::math::Real& dt)
 		{
-			::rl::math::Vector y = this->dynamic->getPosition();
-			::rl::math::Vector dy = this->dynamic->getVelocity();
+			this->resize();
+			
+			this->dynamic->getPosition(this->y);
+			this->dynamic->getVelocity(this->dy);
 			
 			this->dynamic->forwardDynamics();
 			
 			// f
-			::rl::math::Vector f = this->dynamic->getAcceleration();
+			this->dynamic->getAcceleration(this->f);
 			
 			// y_0 + dy_0 * dt
-			y += dt * dy;
+			this->y += dt * this->dy;
 			// dy_0 + f * dt
-			dy += dt * f;
+			this->dy += dt * this->f;
 			
-			this->dynamic->setPosition(y);
-			this->dynamic->setVelocity(dy);
-			this->dynamic->setAcceleration(f);
+			this->dynamic->setPosition(this->y);
+			this->dynamic->setVelocity(this->dy);
+			this->dynamic->setAcceleration(this->f);
+		}
+		
+		void
+		EulerCauchyIntegrator::resize()
+		{
+			this->dy.resize(this->dynamic->getDof());
+			this->f.resize(this->dynamic->getDof());
+			this->y.resize(this->dynamic->getDofPosition());
 		}
 	}
 }
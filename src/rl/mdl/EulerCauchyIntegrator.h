@@ -27,6 +27,8 @@
 #ifndef RL_MDL_EULERCAUCHYINTEGRATOR_H
 #define RL_MDL_EULERCAUCHYINTEGRATOR_H
 
+#include <rl/math/Vector.h>
+
 #include "Integrator.h"
 
 namespace rl
@@ -62,7 +64,13 @@ namespace rl
 		protected:
 			
 		private:
+			void resize();
+			
+			::rl::math::Vector dy;
+			
+			::rl::math::Vector f;
 			
+			::rl::math::Vector y;
 		};
 	}
 }
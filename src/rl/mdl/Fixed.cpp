@@ -39,6 +39,12 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Transform>
+		Fixed::clone() const
+		{
+			return ::std::make_shared<Fixed>(*this);
+		}
+		
 		const ::rl::math::Transform&
 		Fixed::getTransform() const
 		{
@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~Fixed();
 			
+			::std::shared_ptr<Transform> clone() const;
+			
 			const ::rl::math::Transform& getTransform() const;
 			
 			void setTransform(const ::rl::math::Transform& t);
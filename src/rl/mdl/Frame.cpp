@@ -33,10 +33,13 @@ namespace rl
 		Frame::Frame() :
 			Element(),
 			a(::rl::math::MotionVector::Zero()),
+			bC(::rl::math::Matrix66::Zero()),
 			c(::rl::math::MotionVector::Zero()),
 			f(::rl::math::ForceVector::Zero()),
+			fC(::rl::math::ForceVector::Zero()),
 			i(::rl::math::RigidBodyInertia::Identity()),
 			iA(::rl::math::ArticulatedBodyInertia::Identity()),
+			iC(::rl::math::RigidBodyInertia::Zero()),
 			pA(::rl::math::ForceVector::Zero()),
 			v(::rl::math::MotionVector::Zero()),
 			x(::rl::math::PlueckerTransform::Identity()),
@@ -48,6 +51,23 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Frame>
+		Frame::clone() const
+		{
+			return ::std::make_shared<Frame>(*this);
+		}
+		
+		void
+		Frame::compositeRigidBody1()
+		{
+			this->iC.setZero();
+		}
+		
+		void
+		Frame::compositeRigidBody2()
+		{
+		}
+		
 		void
 		Frame::forwardAcceleration()
 		{
@@ -97,6 +117,20 @@ namespace rl
 		{
 		}
 		
+		void
+		Frame::inverseDynamicsDerivatives1()
+		{
+			this->inverseDynamics1();
+			this->bC.setZero();
+			this->fC.setZero();
+			this->iC.setZero();
+		}
+		
+		void
+		Frame::inverseDynamicsDerivatives2()
+		{
+		}
+		
 		void
 		Frame::inverseForce()
 		{
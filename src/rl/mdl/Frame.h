@@ -27,7 +27,9 @@
 #ifndef RL_MDL_FRAME_H
 #define RL_MDL_FRAME_H
 
+#include <memory>
 #include <boost/graph/adjacency_list.hpp>
+#include <rl/math/Matrix.h>
 #include <rl/math/Transform.h>
 #include <rl/math/Spatial.h>
 #include <rl/math/Vector.h>
@@ -56,6 +58,12 @@ namespace rl
 			
 			virtual ~Frame();
 			
+			virtual ::std::shared_ptr<Frame> clone() const;
+			
+			virtual void compositeRigidBody1();
+			
+			virtual void compositeRigidBody2();
+			
 			virtual void forwardAcceleration();
 			
 			virtual void forwardDynamics1();
@@ -74,20 +82,30 @@ namespace rl
 			
 			virtual void inverseDynamics2();
 			
+			virtual void inverseDynamicsDerivatives1();
+			
+			virtual void inverseDynamicsDerivatives2();
+			
 			virtual void inverseForce();
 			
 			void setVertexDescriptor(const Vertex& descriptor);
 			
 			::rl::math::MotionVector a;
 			
+			::rl::math::Matrix66 bC;
+			
 			::rl::math::MotionVector c;
 			
 			::rl::math::ForceVector f;
 			
+			::rl::math::ForceVector fC;
+			
 			::rl::math::RigidBodyInertia i;
 			
 			::rl::math::ArticulatedBodyInertia iA;
 			
+			::rl::math::RigidBodyInertia iC;
+			
 			::rl::math::ForceVector pA;
 			
 			::rl::math::MotionVector v;
@@ -49,6 +49,12 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Transform>
+		Helical::clone() const
+		{
+			return ::std::make_shared<Helical>(*this);
+		}
+		
 		::rl::math::Real
 		Helical::getPitch() const
 		{
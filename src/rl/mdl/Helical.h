@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~Helical();
 			
+			::std::shared_ptr<Transform> clone() const;
+			
 			::rl::math::Real getPitch() const;
 			
 			void setPitch(const ::rl::math::Real& h);
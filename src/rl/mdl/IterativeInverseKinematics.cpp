@@ -25,6 +25,8 @@
 //
 
 #include "IterativeInverseKinematics.h"
+#include "Kinematic.h"
+#include "ReachabilityMap.h"
 
 namespace rl
 {
@@ -32,9 +34,11 @@ namespace rl
 	{
 		IterativeInverseKinematics::IterativeInverseKinematics(Kinematic* kinematic) :
 			InverseKinematics(kinematic),
+			cancel(nullptr),
 			duration(::std::chrono::milliseconds(1000)),
 			epsilon(static_cast<::rl::math::Real>(1.0e-6)),
-			iterations(10000)
+			iterations(10000),
+			reachabilityMap(nullptr)
 		{
 		}
 		
@@ -60,6 +64,43 @@ namespace rl
 			return this->iterations;
 		}
 		
+		const ReachabilityMap*
+		IterativeInverseKinematics::getReachabilityMap() const
+		{
+			return this->reachabilityMap;
+		}
+		
+		bool
+		IterativeInverseKinematics::isCanceled() const
+		{
+			return nullptr != this->cancel && this->cancel->load(::std::memory_order_relaxed);
+		}
+		
+		bool
+		IterativeInverseKinematics::isReachable() const
+		{
+			if (nullptr == this->reachabilityMap)
+			{
+				return true;
+			}
+			
+			for (::std::size_t i = 0; i < this->goals.size(); ++i)
+			{
+				if (this->reachabilityMap->getFrame() == this->goals[i].second && !this->reachabilityMap->isReachable(this->goals[i].first))
+				{
+					return false;
+				}
+			}
+			
+			return true;
+		}
+		
+		void
+		IterativeInverseKinematics::setCancel(const ::std::atomic<bool>* cancel)
+		{
+			this->cancel = cancel;
+		}
+		
 		void
 		IterativeInverseKinematics::setDuration(const ::std::chrono::nanoseconds& duration)
 		{
@@ -77,5 +118,53 @@ namespace rl
 		{
 			this->iterations = iterations;
 		}
+		
+		void
+		IterativeInverseKinematics::setReachabilityMap(const ReachabilityMap* reachabilityMap)
+		{
+			this->reachabilityMap = reachabilityMap;
+		}
+		
+		bool
+		IterativeInverseKinematics::warmStart()
+		{
+			if (nullptr == this->reachabilityMap)
+			{
+				return true;
+			}
+			
+			if (!this->isReachable())
+			{
+				return false;
+			}
+			
+			for (::std::size_t i = 0; i < this->goals.size(); ++i)
+			{
+				if (this->reachabilityMap->getFrame() == this->goals[i].second)
+				{
+					::rl::math::Vector seed(this->kinematic->getDofPosition());
+					
+					if (this->reachabilityMap->getSeed(this->goals[i].first, seed))
+					{
+						::rl::math::Vector q(this->kinematic->getDofPosition());
+						this->kinematic->getPosition(q);
+						this->kinematic->forwardPosition();
+						::rl::math::Real distance = this->kinematic->getOperationalPosition(this->goals[i].second).distance(this->goals[i].first);
+						
+						this->kinematic->setPosition(seed);
+						this->kinematic->forwardPosition();
+						
+						if (this->kinematic->getOperationalPosition(this->goals[i].second).distance(this->goals[i].first) > distance)
+						{
+							this->kinematic->setPosition(q);
+						}
+					}
+					
+					break;
+				}
+			}
+			
+			return true;
+		}
 	}
 }
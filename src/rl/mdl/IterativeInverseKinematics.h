@@ -27,6 +27,7 @@
 #ifndef RL_MDL_ITERATIVEINVERSEKINEMATICS_H
 #define RL_MDL_ITERATIVEINVERSEKINEMATICS_H
 
+#include <atomic>
 #include <chrono>
 
 #include "InverseKinematics.h"
@@ -35,6 +36,8 @@ namespace rl
 {
 	namespace mdl
 	{
+		class ReachabilityMap;
+		
 		class RL_MDL_EXPORT IterativeInverseKinematics : public InverseKinematics
 		{
 		public:
@@ -48,20 +51,58 @@ namespace rl
 			
 			const ::std::size_t& getIterations() const;
 			
+			const ReachabilityMap* getReachabilityMap() const;
+			
+			/**
+			 * Abort solve() as soon as flag is set, e.g., by another thread.
+			 *
+			 * @param[in] cancel Flag checked once per iteration, nullptr to
+			 * disable
+			 */
+			void setCancel(const ::std::atomic<bool>* cancel);
+			
 			void setDuration(const ::std::chrono::nanoseconds& duration);
 			
 			virtual void setEpsilon(const ::rl::math::Real& epsilon);
 			
 			void setIterations(const ::std::size_t& iterations);
 			
+			/**
+			 * Reject goals outside of a reachability map without iterating and
+			 * start from its nearest seed.
+			 *
+			 * @param[in] reachabilityMap Map of the model, nullptr to disable
+			 */
+			void setReachabilityMap(const ReachabilityMap* reachabilityMap);
+			
 		protected:
+			bool isCanceled() const;
+			
+			/**
+			 * @return False if the reachability map rejects a goal of its
+			 * operational frame, true without reachability map
+			 */
+			bool isReachable() const;
+			
+			/**
+			 * Set joint position of model to the seed of the reachability map
+			 * nearest to the goal of its operational frame, unless the current
+			 * joint position is already nearer to that goal.
+			 *
+			 * @return False if the reachability map rejects a goal
+			 */
+			bool warmStart();
 			
 		private:
+			const ::std::atomic<bool>* cancel;
+			
 			::std::chrono::nanoseconds duration;
 			
 			::rl::math::Real epsilon;
 			
 			::std::size_t iterations;
+			
+			const ReachabilityMap* reachabilityMap;
 		};
 	}
 }
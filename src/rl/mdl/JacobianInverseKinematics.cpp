@@ -85,9 +85,14 @@ namespace rl
 			double remaining = ::std::chrono::duration<double>(this->getDuration()).count();
 			::std::size_t iteration = 0;
 			
+			if (!this->warmStart())
+			{
+				return false;
+			}
+			
 			::rl::math::Vector q = this->kinematic->getPosition();
 			::rl::math::Vector q2(this->kinematic->getDofPosition());
-			::rl::math::Vector dq(this->kinematic->getDofPosition());
+			::rl::math::Vector dq(this->kinematic->getDof());
 			::rl::math::Vector dx(6 * this->kinematic->getOperationalDof());
 			
 			::rl::math::Vector rand(this->kinematic->getDof());
@@ -121,12 +126,10 @@ namespace rl
 					switch (this->method)
 					{
 					case Method::dls:
-						this->kinematic->calculateJacobianInverse(0, false);
-						dq = this->kinematic->getJacobianInverse() * dx;
+						this->kinematic->solveJacobianInverse(dx, dq, 0, Kinematic::JacobianInverseMethod::ldlt);
 						break;
 					case Method::svd:
-						this->kinematic->calculateJacobianInverse(0, true);
-						dq = this->kinematic->getJacobianInverse() * dx;
+						this->kinematic->solveJacobianInverse(dx, dq, 0, Kinematic::JacobianInverseMethod::svd);
 						break;
 					case Method::transpose:
 						{
@@ -156,7 +159,7 @@ namespace rl
 						break;
 					}
 				}
-				while (remaining > 0 && iteration < this->getIterations());
+				while (remaining > 0 && iteration < this->getIterations() && !this->isCanceled());
 				
 				for (::std::size_t i = 0; i < this->kinematic->getDof(); ++i)
 				{
@@ -168,7 +171,7 @@ namespace rl
 				
 				remaining = ::std::chrono::duration<double>(this->getDuration() - (::std::chrono::steady_clock::now() - start)).count();
 			}
-			while (remaining > 0 && iteration < this->getIterations());
+			while (remaining > 0 && iteration < this->getIterations() && !this->isCanceled());
 			
 			return false;
 		}
@@ -112,16 +112,48 @@ namespace rl
 		void
 		Joint::forwardDynamics2()
 		{
+			switch (this->getDof())
+			{
+			case 1:
+				this->forwardDynamics2<1>();
+				break;
+			case 2:
+				this->forwardDynamics2<2>();
+				break;
+			case 3:
+				this->forwardDynamics2<3>();
+				break;
+			case 6:
+				this->forwardDynamics2<6>();
+				break;
+			default:
+				this->forwardDynamics2<::Eigen::Dynamic>();
+				break;
+			}
+		}
+		
+		template<int N>
+		void
+		Joint::forwardDynamics2()
+		{
+			const ::std::ptrdiff_t dof = this->getDof();
+			::Eigen::Block<::rl::math::Matrix, 6, N> S = this->S.block<6, N>(0, 0, 6, dof);
+			::Eigen::Block<::rl::math::Matrix, 6, N> U = this->U.block<6, N>(0, 0, 6, dof);
+			::Eigen::Block<::rl::math::Matrix, N, N> D = this->D.block<N, N>(0, 0, dof, dof);
+			::Eigen::VectorBlock<::rl::math::Vector, N> u = this->u.segment<N>(0, dof);
 			// I^A * S
-			this->U = this->out->iA.matrix() * this->S;
+			U.noalias() = this->out->iA.matrix() * S;
 			// S^T * U
-			this->D = this->S.transpose() * this->U;
+			D.noalias() = S.transpose() * U;
 			// tau - S^T * p^A
-			this->u = this->tau - this->S.transpose() * this->out->pA.matrix();
+			u = this->tau.segment<N>(0, dof);
+			u.noalias() -= S.transpose() * this->out->pA.matrix();
+			// U * D^-1
+			::Eigen::Matrix<::rl::math::Real, 6, N> UinvD = U * D.inverse();
 			// I^A - U * D^-1 * U^T
-			::rl::math::ArticulatedBodyInertia ia(this->out->iA - ::rl::math::ArticulatedBodyInertia(this->U * this->D.inverse() * this->U.transpose()));
+			::rl::math::ArticulatedBodyInertia ia(this->out->iA - ::rl::math::ArticulatedBodyInertia(UinvD * U.transpose()));
 			// p^A + I^a * c + U * D^-1 * u
-			::rl::math::ForceVector pa(this->out->pA + ia * this->out->c + ::rl::math::ForceVector(this->U * this->D.inverse() * this->u));
+			::rl::math::ForceVector pa(this->out->pA + ia * this->out->c + ::rl::math::ForceVector(UinvD * u));
 			// I^A + X^* * I^a * X
 			this->in->iA = this->in->iA + this->x / ia;
 			// p^A + X^* * p^a
@@ -131,12 +163,41 @@ namespace rl
 		void
 		Joint::forwardDynamics3()
 		{
+			switch (this->getDof())
+			{
+			case 1:
+				this->forwardDynamics3<1>();
+				break;
+			case 2:
+				this->forwardDynamics3<2>();
+				break;
+			case 3:
+				this->forwardDynamics3<3>();
+				break;
+			case 6:
+				this->forwardDynamics3<6>();
+				break;
+			default:
+				this->forwardDynamics3<::Eigen::Dynamic>();
+				break;
+			}
+		}
+		
+		template<int N>
+		void
+		Joint::forwardDynamics3()
+		{
+			const ::std::ptrdiff_t dof = this->getDof();
+			::Eigen::VectorBlock<::rl::math::Vector, N> qdd = this->qdd.segment<N>(0, dof);
 			// X * a + c
 			::rl::math::MotionVector a(this->x * this->in->a + this->out->c);
+			// u - U^T * a'
+			::Eigen::Matrix<::rl::math::Real, N, 1> tmp = this->u.segment<N>(0, dof);
+			tmp.noalias() -= this->U.block<6, N>(0, 0, 6, dof).transpose() * a.matrix();
 			// D^-1 * (u - U^T * a')
-			this->qdd = this->D.inverse() * (this->u - this->U.transpose() * a.matrix());
+			qdd.noalias() = this->D.block<N, N>(0, 0, dof, dof).inverse() * tmp;
 			// S * qdd
-			this->a = this->S * this->qdd;
+			this->a = this->S.block<6, N>(0, 0, 6, dof) * qdd;
 			// a' + S * qdd
 			this->out->a = a + this->a;
 		}
@@ -282,13 +343,38 @@ namespace rl
 		void
 		Joint::inverseForce()
 		{
-			// S^T * f
-			this->tau = this->S.transpose() * this->out->f.matrix();
+			switch (this->getDof())
+			{
+			case 1:
+				this->inverseForce<1>();
+				break;
+			case 2:
+				this->inverseForce<2>();
+				break;
+			case 3:
+				this->inverseForce<3>();
+				break;
+			case 6:
+				this->inverseForce<6>();
+				break;
+			default:
+				this->inverseForce<::Eigen::Dynamic>();
+				break;
+			}
 			
 			// f + X * f
 			this->in->f = this->in->f + this->x / this->out->f;
 		}
 		
+		template<int N>
+		void
+		Joint::inverseForce()
+		{
+			const ::std::ptrdiff_t dof = this->getDof();
+			// S^T * f
+			this->tau.segment<N>(0, dof).noalias() = this->S.block<6, N>(0, 0, 6, dof).transpose() * this->out->f.matrix();
+		}
+		
 		bool
 		Joint::isValid(const ::rl::math::ConstVectorRef& q) const
 		{
@@ -313,8 +399,33 @@ namespace rl
 		{
 			this->qdd = qdd;
 			
+			switch (this->getDof())
+			{
+			case 1:
+				this->setAcceleration<1>();
+				break;
+			case 2:
+				this->setAcceleration<2>();
+				break;
+			case 3:
+				this->setAcceleration<3>();
+				break;
+			case 6:
+				this->setAcceleration<6>();
+				break;
+			default:
+				this->setAcceleration<::Eigen::Dynamic>();
+				break;
+			}
+		}
+		
+		template<int N>
+		void
+		Joint::setAcceleration()
+		{
+			const ::std::ptrdiff_t dof = this->getDof();
 			// S * qdd
-			this->a = this->S * this->qdd;
+			this->a = this->S.block<6, N>(0, 0, 6, dof) * this->qdd.segment<N>(0, dof);
 		}
 		
 		void
@@ -352,8 +463,33 @@ namespace rl
 		{
 			this->qd = qd;
 			
+			switch (this->getDof())
+			{
+			case 1:
+				this->setVelocity<1>();
+				break;
+			case 2:
+				this->setVelocity<2>();
+				break;
+			case 3:
+				this->setVelocity<3>();
+				break;
+			case 6:
+				this->setVelocity<6>();
+				break;
+			default:
+				this->setVelocity<::Eigen::Dynamic>();
+				break;
+			}
+		}
+		
+		template<int N>
+		void
+		Joint::setVelocity()
+		{
+			const ::std::ptrdiff_t dof = this->getDof();
 			// S * qd
-			this->v = this->S * this->qd;
+			this->v = this->S.block<6, N>(0, 0, 6, dof) * this->qd.segment<N>(0, dof);
 		}
 		
 		void
@@ -170,7 +170,21 @@ namespace rl
 		protected:
 			
 		private:
+			/**
+			 * Kernels specialised for a fixed number of degrees of freedom.
+			 *
+			 * Blocks of compile-time size avoid temporaries on the heap and are
+			 * dispatched on getDof(), ::Eigen::Dynamic is used otherwise.
+			 */
+			template<int N> void forwardDynamics2();
 			
+			template<int N> void forwardDynamics3();
+			
+			template<int N> void inverseForce();
+			
+			template<int N> void setAcceleration();
+			
+			template<int N> void setVelocity();
 		};
 	}
 }
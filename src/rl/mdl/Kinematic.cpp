@@ -36,16 +36,47 @@
 #include "Kinematic.h"
 #include "Prismatic.h"
 #include "Revolute.h"
+#include "World.h"
 
 namespace rl
 {
 	namespace mdl
 	{
+		namespace
+		{
+			/**
+			 * Damped inverse of singular values, damping is only applied to
+			 * singular values below a threshold.
+			 */
+			template<typename T>
+			void
+			invertSingularValues(const T& svd, const ::rl::math::Real& lambda, ::rl::math::Vector& sigma)
+			{
+				::rl::math::Real wMin = svd.singularValues().minCoeff();
+				::rl::math::Real lambdaSqr = wMin < static_cast<::rl::math::Real>(1.0e-9) ? (1 - ::std::pow((wMin / static_cast<::rl::math::Real>(1.0e-9)), 2)) * ::std::pow(lambda, 2) : 0;
+				
+				for (::std::ptrdiff_t i = 0; i < sigma.size(); ++i)
+				{
+					sigma(i) = i < svd.nonzeroSingularValues() ? svd.singularValues()(i) / (::std::pow(svd.singularValues()(i), 2) + lambdaSqr) : 0;
+				}
+			}
+		}
+		
 		Kinematic::Kinematic() :
 			Metric(),
 			invJ(),
 			J(),
-			Jdqd()
+			Jdqd(),
+			S(),
+			bdcSvd(),
+			cod(),
+			JJ(),
+			ldlt(),
+			llt(),
+			svd(),
+			svdSigma(),
+			svdV(),
+			tmp()
 		{
 		}
 		
@@ -71,34 +102,42 @@ namespace rl
 		}
 		
 		void
-		Kinematic::calculateJacobian(::rl::math::Matrix& J, const bool& inWorldFrame)
+		Kinematic::calculateJacobian(::rl::math::MatrixRef J, const bool& inWorldFrame)
 		{
 			assert(J.rows() == this->getOperationalDof() * 6);
 			assert(J.cols() == this->getDof());
 			
-			::rl::math::Vector tmp(this->getDof());
+			this->forwardPosition();
 			
-			for (::std::size_t i = 0; i < this->getDof(); ++i)
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
-				for (::std::size_t j = 0; j < this->getDof(); ++j)
+				for (::std::size_t k = 0; k < this->joints[i]->getDof(); ++k)
 				{
-					tmp(j) = i == j ? 1 : 0;
+					// X_0^-1 * S
+					this->S.col(j + k) = (this->joints[i]->out->x / ::rl::math::MotionVector(this->joints[i]->S.col(k))).matrix();
 				}
+			}
+			
+			J.setZero();
+			
+			for (::std::size_t i = 0; i < this->leaves.size(); ++i)
+			{
+				const ::rl::math::PlueckerTransform& x = this->tree[this->leaves[i]]->x;
 				
-				this->setVelocity(tmp);
-				this->forwardVelocity();
-				
-				for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
+				for (::std::size_t j = this->leafParents[i]; j < this->parents.size(); j = this->parents[j])
 				{
 					if (inWorldFrame)
 					{
-						J.block(j * 6, i, 3, 1) = this->getOperationalPosition(j).linear() * this->getOperationalVelocity(j).linear();
-						J.block(j * 6 + 3, i, 3, 1) = this->getOperationalPosition(j).linear() * this->getOperationalVelocity(j).angular();
+						// v + omega x p
+						J.block<3, 1>(i * 6, j) = this->S.block<3, 1>(3, j) + this->S.block<3, 1>(0, j).cross(x.translation());
+						J.block<3, 1>(i * 6 + 3, j) = this->S.block<3, 1>(0, j);
 					}
 					else
 					{
-						J.block(j * 6, i, 3, 1) = this->getOperationalVelocity(j).linear();
-						J.block(j * 6 + 3, i, 3, 1) = this->getOperationalVelocity(j).angular();
+						// X * X_0^-1 * S
+						::rl::math::MotionVector v = x * ::rl::math::MotionVector(this->S.col(j));
+						J.block<3, 1>(i * 6, j) = v.linear();
+						J.block<3, 1>(i * 6 + 3, j) = v.angular();
 					}
 				}
 			}
@@ -138,35 +177,70 @@ namespace rl
 		void
 		Kinematic::calculateJacobianInverse(const ::rl::math::Real& lambda, const bool& doSvd)
 		{
-			this->calculateJacobianInverse(this->J, this->invJ, lambda, doSvd);
+			this->calculateJacobianInverse(lambda, doSvd ? JacobianInverseMethod::svd : JacobianInverseMethod::ldlt);
 		}
 		
 		void
-		Kinematic::calculateJacobianInverse(const ::rl::math::Matrix& J, ::rl::math::Matrix& invJ, const ::rl::math::Real& lambda, const bool& doSvd) const
+		Kinematic::calculateJacobianInverse(const ::rl::math::Real& lambda, const JacobianInverseMethod& method)
 		{
-			if (doSvd)
+			this->decomposeJacobian(lambda, method);
+			
+			switch (method)
 			{
-				invJ.setZero();
-				
-				::Eigen::JacobiSVD<::rl::math::Matrix> svd(J, ::Eigen::ComputeFullU | ::Eigen::ComputeFullV);
-				
-				::rl::math::Real wMin = svd.singularValues().minCoeff();
-				::rl::math::Real lambdaSqr = wMin < static_cast<::rl::math::Real>(1.0e-9) ? (1 - ::std::pow((wMin / static_cast<::rl::math::Real>(1.0e-9)), 2)) * ::std::pow(lambda, 2) : 0;
-				
-				for (::std::ptrdiff_t i = 0; i < svd.nonzeroSingularValues(); ++i)
+			case JacobianInverseMethod::bdcSvd:
+				this->svdV.noalias() = this->bdcSvd.matrixV() * this->svdSigma.asDiagonal();
+				this->invJ.noalias() = this->svdV * this->bdcSvd.matrixU().transpose();
+				break;
+			case JacobianInverseMethod::cod:
+				this->invJ = this->cod.pseudoInverse();
+				break;
+			case JacobianInverseMethod::ldlt:
+				if (this->J.rows() <= this->J.cols())
+				{
+					// (J * J^T + lambda^2 * 1)^-1 * J
+					this->invJ.transpose() = this->ldlt.solve(this->J);
+				}
+				else
+				{
+					// (J^T * J + lambda^2 * 1)^-1 * J^T
+					this->invJ = this->ldlt.solve(this->J.transpose());
+				}
+				break;
+			case JacobianInverseMethod::llt:
+				if (this->J.rows() <= this->J.cols())
 				{
-					invJ.noalias() += (
-						svd.singularValues()(i) / (::std::pow(svd.singularValues()(i), 2) + lambdaSqr) *
-						svd.matrixV().col(i) * svd.matrixU().col(i).transpose()
-					);
+					this->invJ.transpose() = this->llt.solve(this->J);
 				}
+				else
+				{
+					this->invJ = this->llt.solve(this->J.transpose());
+				}
+				break;
+			case JacobianInverseMethod::svd:
+				this->svdV.noalias() = this->svd.matrixV() * this->svdSigma.asDiagonal();
+				this->invJ.noalias() = this->svdV * this->svd.matrixU().transpose();
+				break;
+			default:
+				break;
+			}
+		}
+		
+		void
+		Kinematic::calculateJacobianInverse(const ::rl::math::Matrix& J, ::rl::math::Matrix& invJ, const ::rl::math::Real& lambda, const bool& doSvd) const
+		{
+			if (doSvd)
+			{
+				::Eigen::JacobiSVD<::rl::math::Matrix> svd(J, ::Eigen::ComputeThinU | ::Eigen::ComputeThinV);
+				::rl::math::Vector sigma(svd.singularValues().size());
+				invertSingularValues(svd, lambda, sigma);
+				invJ.noalias() = svd.matrixV() * sigma.asDiagonal() * svd.matrixU().transpose();
 			}
 			else
 			{
 				invJ = J.transpose() * (
 					J * J.transpose() + ::std::pow(lambda, 2) *
-					::rl::math::Matrix::Identity(this->getOperationalDof() * 6, this->getOperationalDof() * 6)
-				).inverse();
+					::rl::math::Matrix::Identity(J.rows(), J.rows())
+				).ldlt().solve(::rl::math::Matrix::Identity(J.rows(), J.rows()));
 			}
 		}
 		
@@ -182,30 +256,119 @@ namespace rl
 			return ::std::sqrt((J * J.transpose()).determinant());
 		}
 		
+		Model*
+		Kinematic::clone() const
+		{
+			return new Kinematic(*this);
+		}
+		
+		void
+		Kinematic::decomposeJacobian(const ::rl::math::Real& lambda, const JacobianInverseMethod& method)
+		{
+			switch (method)
+			{
+			case JacobianInverseMethod::bdcSvd:
+				this->bdcSvd.compute(this->J);
+				invertSingularValues(this->bdcSvd, lambda, this->svdSigma);
+				break;
+			case JacobianInverseMethod::cod:
+				this->cod.compute(this->J);
+				break;
+			case JacobianInverseMethod::ldlt:
+			case JacobianInverseMethod::llt:
+				if (this->J.rows() <= this->J.cols())
+				{
+					this->JJ.noalias() = this->J * this->J.transpose();
+				}
+				else
+				{
+					this->JJ.noalias() = this->J.transpose() * this->J;
+				}
+				
+				this->JJ.diagonal().array() += ::std::pow(lambda, 2);
+				
+				if (JacobianInverseMethod::ldlt == method)
+				{
+					this->ldlt.compute(this->JJ);
+				}
+				else
+				{
+					this->llt.compute(this->JJ);
+				}
+				break;
+			case JacobianInverseMethod::svd:
+				this->svd.compute(this->J);
+				invertSingularValues(this->svd, lambda, this->svdSigma);
+				break;
+			default:
+				break;
+			}
+		}
+		
 		void
 		Kinematic::forwardAcceleration()
 		{
-			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			for (::std::vector<Operation>::iterator i = this->operations.begin(); i != this->operations.end(); ++i)
 			{
-				(*i)->forwardAcceleration();
+				switch (i->type)
+				{
+				case Operation::Type::joint:
+					static_cast<Joint*>(i->element)->Joint::forwardAcceleration();
+					break;
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::forwardAcceleration();
+					break;
+				case Operation::Type::world:
+					static_cast<World*>(i->element)->World::forwardAcceleration();
+					break;
+				case Operation::Type::element:
+					i->element->forwardAcceleration();
+					break;
+				default:
+					break;
+				}
 			}
 		}
 		
 		void
 		Kinematic::forwardPosition()
 		{
-			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			for (::std::vector<Operation>::iterator i = this->operations.begin(); i != this->operations.end(); ++i)
 			{
-				(*i)->forwardPosition();
+				switch (i->type)
+				{
+				case Operation::Type::joint:
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::forwardPosition();
+					break;
+				case Operation::Type::element:
+					i->element->forwardPosition();
+					break;
+				default:
+					break;
+				}
 			}
 		}
 		
 		void
 		Kinematic::forwardVelocity()
 		{
-			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			for (::std::vector<Operation>::iterator i = this->operations.begin(); i != this->operations.end(); ++i)
 			{
-				(*i)->forwardVelocity();
+				switch (i->type)
+				{
+				case Operation::Type::joint:
+					static_cast<Joint*>(i->element)->Joint::forwardVelocity();
+					break;
+				case Operation::Type::transform:
+					static_cast<Transform*>(i->element)->Transform::forwardVelocity();
+					break;
+				case Operation::Type::element:
+					i->element->forwardVelocity();
+					break;
+				default:
+					break;
+				}
 			}
 		}
 		
@@ -240,14 +403,82 @@ namespace rl
 			return (::std::abs(svd.singularValues()(svd.singularValues().size() - 1)) > ::std::numeric_limits<::rl::math::Real>::epsilon()) ? false : true;
 		}
 		
+		void
+		Kinematic::solveJacobianInverse(const ::rl::math::ConstVectorRef& dx, ::rl::math::VectorRef dq, const ::rl::math::Real& lambda, const JacobianInverseMethod& method)
+		{
+			assert(dx.size() == this->J.rows());
+			assert(dq.size() == this->J.cols());
+			
+			this->decomposeJacobian(lambda, method);
+			
+			switch (method)
+			{
+			case JacobianInverseMethod::bdcSvd:
+				this->tmp.noalias() = this->bdcSvd.matrixU().transpose() * dx;
+				this->tmp.array() *= this->svdSigma.array();
+				dq.noalias() = this->bdcSvd.matrixV() * this->tmp;
+				break;
+			case JacobianInverseMethod::cod:
+				dq = this->cod.solve(dx);
+				break;
+			case JacobianInverseMethod::ldlt:
+				if (this->J.rows() <= this->J.cols())
+				{
+					this->tmp = this->ldlt.solve(dx);
+					dq.noalias() = this->J.transpose() * this->tmp;
+				}
+				else
+				{
+					this->tmp.noalias() = this->J.transpose() * dx;
+					dq = this->ldlt.solve(this->tmp);
+				}
+				break;
+			case JacobianInverseMethod::llt:
+				if (this->J.rows() <= this->J.cols())
+				{
+					this->tmp = dx;
+					this->llt.solveInPlace(this->tmp);
+					dq.noalias() = this->J.transpose() * this->tmp;
+				}
+				else
+				{
+					dq.noalias() = this->J.transpose() * dx;
+					this->llt.solveInPlace(dq);
+				}
+				break;
+			case JacobianInverseMethod::svd:
+				this->tmp.noalias() = this->svd.matrixU().transpose() * dx;
+				this->tmp.array() *= this->svdSigma.array();
+				dq.noalias() = this->svd.matrixV() * this->tmp;
+				break;
+			default:
+				break;
+			}
+		}
+		
 		void
 		Kinematic::update()
 		{
 			Metric::update();
 			
-			this->invJ = ::rl::math::Matrix::Identity(this->getDof(), 6 * this->getOperationalDof());
-			this->J = ::rl::math::Matrix::Identity(6 * this->getOperationalDof(), this->getDof());
-			this->Jdqd = ::rl::math::Vector::Zero(6 * this->getOperationalDof());
+			::std::size_t rows = 6 * this->getOperationalDof();
+			::std::size_t cols = this->getDof();
+			::std::size_t rank = ::std::min(rows, cols);
+			
+			this->invJ = ::rl::math::Matrix::Identity(cols, rows);
+			this->J = ::rl::math::Matrix::Identity(rows, cols);
+			this->Jdqd = ::rl::math::Vector::Zero(rows);
+			this->S = ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, cols);
+			
+			this->bdcSvd = ::Eigen::BDCSVD<::rl::math::Matrix>(rows, cols, ::Eigen::ComputeThinU | ::Eigen::ComputeThinV);
+			this->cod = ::Eigen::CompleteOrthogonalDecomposition<::rl::math::Matrix>(rows, cols);
+			this->JJ = ::rl::math::Matrix::Zero(rank, rank);
+			this->ldlt = ::Eigen::LDLT<::rl::math::Matrix>(rank);
+			this->llt = ::Eigen::LLT<::rl::math::Matrix>(rank);
+			this->svd = ::Eigen::JacobiSVD<::rl::math::Matrix>(rows, cols, ::Eigen::ComputeThinU | ::Eigen::ComputeThinV);
+			this->svdSigma = ::rl::math::Vector::Zero(rank);
+			this->svdV = ::rl::math::Matrix::Zero(cols, rank);
+			this->tmp = ::rl::math::Vector::Zero(rank);
 		}
 	}
 }
@@ -28,6 +28,9 @@
 #define RL_MDL_KINEMATIC_H
 
 #include <rl/math/Matrix.h>
+#include <Eigen/Cholesky>
+#include <Eigen/QR>
+#include <Eigen/SVD>
 
 #include "Metric.h"
 
@@ -40,6 +43,39 @@ namespace rl
 		public:
 			EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 			
+			/**
+			 * Decomposition used for the Jacobian matrix inverse.
+			 *
+			 * Decompositions are stored in the model and reused, svd, llt and
+			 * ldlt do not allocate memory.
+			 */
+			enum class JacobianInverseMethod
+			{
+				/**
+				 * Divide and conquer singular value decomposition, faster for
+				 * large models, allocates memory.
+				 */
+				bdcSvd,
+				/**
+				 * Complete orthogonal decomposition, minimum norm solution
+				 * without damping, allocates memory.
+				 */
+				cod,
+				/**
+				 * Damped least squares with robust Cholesky decomposition.
+				 */
+				ldlt,
+				/**
+				 * Damped least squares with Cholesky decomposition, requires
+				 * \f$\lambda > 0\f$ in singular configurations.
+				 */
+				llt,
+				/**
+				 * Thin Jacobi singular value decomposition.
+				 */
+				svd
+			};
+			
 			Kinematic();
 			
 			virtual ~Kinematic();
@@ -59,6 +95,7 @@ namespace rl
 			 *
 			 * @pre setPosition()
 			 * @post getJacobian()
+			 * @post getOperationalPosition()
 			 *
 			 * @see forwardVelocity()
 			 */
@@ -67,14 +104,20 @@ namespace rl
 			/**
 			 * Calculate Jacobian matrix.
 			 *
+			 * Single pass over the joint motion subspaces in world coordinates,
+			 * columns of joints that are not ancestors of an operational frame
+			 * are zero. Rows of all operational frames are filled at once, the
+			 * output may be a block of a larger preallocated matrix.
+			 *
 			 * @param[out] J Jacobian matrix \f$\matr{J}(\vec{q})\f$
 			 * @param[in] inWorldFrame Calculate in world or tool frame
 			 *
 			 * @pre setPosition()
+			 * @post getOperationalPosition()
 			 *
 			 * @see forwardVelocity()
 			 */
-			void calculateJacobian(::rl::math::Matrix& J, const bool& inWorldFrame = true);
+			void calculateJacobian(::rl::math::MatrixRef J, const bool& inWorldFrame = true);
 			
 			/**
 			 * Calculate Jacobian derivative vector.
@@ -119,6 +162,20 @@ namespace rl
 			 */
 			void calculateJacobianInverse(const ::rl::math::Real& lambda = 0, const bool& doSvd = true);
 			
+			/**
+			 * Calculate Jacobian matrix inverse.
+			 *
+			 * @param[in] lambda Damping factor \f$\lambda\f$, ignored by JacobianInverseMethod::cod
+			 * @param[in] method Decomposition of Jacobian matrix
+			 *
+			 * @pre setPosition()
+			 * @pre calculateJacobian()
+			 * @post getJacobianInverse()
+			 *
+			 * @see solveJacobianInverse()
+			 */
+			void calculateJacobianInverse(const ::rl::math::Real& lambda, const JacobianInverseMethod& method);
+			
 			/**
 			 * Calculate Jacobian matrix inverse.
 			 *
@@ -158,6 +215,8 @@ namespace rl
 			 */
 			::rl::math::Real calculateManipulabilityMeasure(const ::rl::math::Matrix& J) const;
 			
+			Model* clone() const;
+			
 			/**
 			 * @pre setPosition()
 			 * @pre setVelocity()
@@ -225,6 +284,21 @@ namespace rl
 			 */
 			bool isSingular(const ::rl::math::Matrix& J) const;
 			
+			/**
+			 * Multiply Jacobian matrix inverse with a vector without calculating it.
+			 *
+			 * \f[ \Delta\vec{q} = \matr{J}^{\dagger}(\vec{q}) \, \Delta\vec{x} \f]
+			 *
+			 * @param[in] dx Operational vector \f$\Delta\vec{x}\f$
+			 * @param[out] dq Joint vector \f$\Delta\vec{q}\f$
+			 * @param[in] lambda Damping factor \f$\lambda\f$, ignored by JacobianInverseMethod::cod
+			 * @param[in] method Decomposition of Jacobian matrix
+			 *
+			 * @pre setPosition()
+			 * @pre calculateJacobian()
+			 */
+			void solveJacobianInverse(const ::rl::math::ConstVectorRef& dx, ::rl::math::VectorRef dq, const ::rl::math::Real& lambda = 0, const JacobianInverseMethod& method = JacobianInverseMethod::svd);
+			
 			virtual void update();
 			
 		protected:
@@ -261,8 +335,55 @@ namespace rl
 			 * */
 			::rl::math::Vector Jdqd;
 			
+			/**
+			 * Joint motion subspaces in world coordinates.
+			 *
+			 * \f[ {}^{0}\matr{X}_{i}^{-1} \, \matr{S}_{i} \f]
+			 *
+			 * @pre calculateJacobian()
+			 * */
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic> S;
+			
 		private:
+			/**
+			 * Decompose Jacobian matrix with given method.
+			 */
+			void decomposeJacobian(const ::rl::math::Real& lambda, const JacobianInverseMethod& method);
+			
+			::Eigen::BDCSVD<::rl::math::Matrix> bdcSvd;
+			
+			::Eigen::CompleteOrthogonalDecomposition<::rl::math::Matrix> cod;
+			
+			/**
+			 * Damped product of Jacobian matrix with its transpose.
+			 *
+			 * \f[ \matr{J} \, \matr{J}^{\mathrm{T}} + \lambda^{2} \, \matr{1} \f] or \f[ \matr{J}^{\mathrm{T}} \, \matr{J} + \lambda^{2} \, \matr{1} \f]
+			 * for fewer joints than operational coordinates.
+			 */
+			::rl::math::Matrix JJ;
+			
+			::Eigen::LDLT<::rl::math::Matrix> ldlt;
+			
+			::Eigen::LLT<::rl::math::Matrix> llt;
+			
+			::Eigen::JacobiSVD<::rl::math::Matrix> svd;
 			
+			/**
+			 * Damped inverse singular values.
+			 *
+			 * \f[ \frac{ \sigma_{i} }{ \sigma_{i}^{2} + \lambda^{2} } \f]
+			 */
+			::rl::math::Vector svdSigma;
+			
+			/**
+			 * Right singular vectors scaled by svdSigma.
+			 */
+			::rl::math::Matrix svdV;
+			
+			/**
+			 * Temporary vector with one element per singular value.
+			 */
+			::rl::math::Vector tmp;
 		};
 	}
 }
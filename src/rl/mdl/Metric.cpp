@@ -51,8 +51,14 @@ namespace rl
 			}
 		}
 		
+		Model*
+		Metric::clone() const
+		{
+			return new Metric(*this);
+		}
+		
 		::rl::math::Real
-		Metric::distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Metric::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			assert(q1.size() == this->getDofPosition());
 			assert(q2.size() == this->getDofPosition());
@@ -147,7 +153,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Metric::transformedDistance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Metric::transformedDistance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			assert(q1.size() == this->getDofPosition());
 			assert(q2.size() == this->getDofPosition());
@@ -24,10 +24,20 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <typeinfo>
+#include <unordered_map>
+
 #include "Body.h"
+#include "Cylindrical.h"
 #include "Exception.h"
+#include "Fixed.h"
+#include "Helical.h"
 #include "Joint.h"
 #include "Model.h"
+#include "Prismatic.h"
+#include "Revolute.h"
+#include "SixDof.h"
+#include "Spherical.h"
 #include "World.h"
 
 namespace rl
@@ -39,15 +49,23 @@ namespace rl
 			elements(),
 			frames(),
 			gammaPosition(),
+			gammaPositionCoupling(),
 			gammaVelocity(),
+			gammaVelocityCoupling(),
 			home(),
 			invGammaPosition(),
+			invGammaPositionCoupling(),
 			invGammaVelocity(),
+			invGammaVelocityCoupling(),
 			joints(),
+			leafParents(),
 			leaves(),
 			manufacturer(),
 			name(),
+			operations(),
+			parents(),
 			root(0),
+			tmp(),
 			tools(),
 			transforms(),
 			tree(),
@@ -56,10 +74,168 @@ namespace rl
 		{
 		}
 		
+		Model::Model(const Model& other) :
+			bodies(),
+			elements(),
+			frames(),
+			gammaPosition(),
+			gammaPositionCoupling(),
+			gammaVelocity(),
+			gammaVelocityCoupling(),
+			home(),
+			invGammaPosition(),
+			invGammaPositionCoupling(),
+			invGammaVelocity(),
+			invGammaVelocityCoupling(),
+			joints(),
+			leafParents(),
+			leaves(),
+			manufacturer(other.manufacturer),
+			name(other.name),
+			operations(),
+			parents(),
+			root(0),
+			tmp(),
+			tools(),
+			transforms(),
+			tree(),
+			randDistribution(other.randDistribution),
+			randEngine(other.randEngine)
+		{
+			::std::unordered_map<const Frame*, Frame*> clones;
+			
+			for (VertexIteratorPair i = ::boost::vertices(other.tree); i.first != i.second; ++i.first)
+			{
+				::std::shared_ptr<Frame> frame = other.tree[*i.first]->clone();
+				clones[other.tree[*i.first].get()] = frame.get();
+				this->add(frame);
+			}
+			
+			for (EdgeIteratorPair i = ::boost::edges(other.tree); i.first != i.second; ++i.first)
+			{
+				this->add(
+					other.tree[*i.first]->clone(),
+					clones[other.tree[::boost::source(*i.first, other.tree)].get()],
+					clones[other.tree[::boost::target(*i.first, other.tree)].get()]
+				);
+			}
+			
+			for (VertexIteratorPair i = ::boost::vertices(this->tree); i.first != i.second; ++i.first)
+			{
+				if (Body* body = dynamic_cast<Body*>(this->tree[*i.first].get()))
+				{
+					::std::unordered_set<Body*> selfcollision;
+					
+					for (::std::unordered_set<Body*>::const_iterator j = body->selfcollision.begin(); j != body->selfcollision.end(); ++j)
+					{
+						selfcollision.insert(static_cast<Body*>(clones[*j]));
+					}
+					
+					body->selfcollision = selfcollision;
+				}
+			}
+			
+			if (!other.elements.empty())
+			{
+				this->update();
+			}
+			
+			this->gammaPosition = other.gammaPosition;
+			this->gammaPositionCoupling = other.gammaPositionCoupling;
+			this->gammaVelocity = other.gammaVelocity;
+			this->gammaVelocityCoupling = other.gammaVelocityCoupling;
+			this->home = other.home;
+			this->invGammaPosition = other.invGammaPosition;
+			this->invGammaPositionCoupling = other.invGammaPositionCoupling;
+			this->invGammaVelocity = other.invGammaVelocity;
+			this->invGammaVelocityCoupling = other.invGammaVelocityCoupling;
+		}
+		
 		Model::~Model()
 		{
 		}
 		
+		Model::Coupling::Coupling() :
+			permutation(),
+			sparse(),
+			type(Type::identity)
+		{
+		}
+		
+		void
+		Model::Coupling::assign(const ::rl::math::Matrix& matrix)
+		{
+			this->permutation.resize(0);
+			this->sparse.resize(0, 0);
+			
+			if (matrix.isIdentity(0))
+			{
+				this->type = Type::identity;
+				return;
+			}
+			
+			if (matrix.rows() == matrix.cols() && (matrix.array() == 0 || matrix.array() == 1).all() && (matrix.colwise().sum().array() == 1).all() && (matrix.rowwise().sum().array() == 1).all())
+			{
+				this->permutation.resize(matrix.rows());
+				
+				for (::std::ptrdiff_t i = 0; i < matrix.cols(); ++i)
+				{
+					matrix.col(i).maxCoeff(&this->permutation.indices()(i));
+				}
+				
+				this->type = Type::permutation;
+				return;
+			}
+			
+			this->sparse = matrix.sparseView(matrix.cwiseAbs().maxCoeff(), ::std::numeric_limits<::rl::math::Real>::epsilon());
+			this->sparse.makeCompressed();
+			this->type = Type::sparse;
+		}
+		
+		void
+		Model::Coupling::multiply(const ::rl::math::ConstVectorRef& x, ::rl::math::VectorRef y) const
+		{
+			switch (this->type)
+			{
+			case Type::identity:
+				y = x;
+				break;
+			case Type::permutation:
+				for (::std::ptrdiff_t i = 0; i < x.size(); ++i)
+				{
+					y(this->permutation.indices()(i)) = x(i);
+				}
+				break;
+			case Type::sparse:
+				y.noalias() = this->sparse * x;
+				break;
+			default:
+				break;
+			}
+		}
+		
+		void
+		Model::Coupling::multiplyColumns(const ::std::size_t& j, const ::rl::math::ConstVectorRef& x, ::rl::math::VectorRef y) const
+		{
+			switch (this->type)
+			{
+			case Type::identity:
+				y.segment(j, x.size()) = x;
+				break;
+			case Type::permutation:
+				for (::std::ptrdiff_t i = 0; i < x.size(); ++i)
+				{
+					y(this->permutation.indices()(j + i)) = x(i);
+				}
+				break;
+			case Type::sparse:
+				y.noalias() += this->sparse.middleCols(j, x.size()) * x;
+				break;
+			default:
+				break;
+			}
+		}
+		
 		void
 		Model::add(Frame* frame)
 		{
@@ -102,6 +278,38 @@ namespace rl
 			return this->bodies[i]->getCollision(this->bodies[j]) || this->bodies[j]->getCollision(this->bodies[i]);
 		}
 		
+		Model*
+		Model::clone() const
+		{
+			return new Model(*this);
+		}
+		
+		::std::size_t
+		Model::findParentDof(const Vertex& u) const
+		{
+			for (Vertex v = u; ::boost::in_degree(v, this->tree) > 0; )
+			{
+				Edge e = *::boost::in_edges(v, this->tree).first;
+				
+				if (Joint* joint = dynamic_cast<Joint*>(this->tree[e].get()))
+				{
+					for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+					{
+						if (joint == this->joints[i])
+						{
+							return j + joint->getDof() - 1;
+						}
+					}
+					
+					break;
+				}
+				
+				v = ::boost::source(e, this->tree);
+			}
+			
+			return this->getDof();
+		}
+		
 		::rl::math::Vector
 		Model::generatePositionGaussian(const ::rl::math::Vector& mean, const ::rl::math::Vector& sigma)
 		{
@@ -197,13 +405,21 @@ namespace rl
 		Model::getAcceleration() const
 		{
 			::rl::math::Vector qdd(this->getDof());
+			this->getAcceleration(qdd);
+			return qdd;
+		}
+		
+		void
+		Model::getAcceleration(::rl::math::VectorRef ydd) const
+		{
+			assert(ydd.size() == this->getDof());
+			
+			ydd.setZero();
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
-				qdd.segment(j, this->joints[i]->getDof()) = this->joints[i]->getAcceleration();
+				this->invGammaVelocityCoupling.multiplyColumns(j, this->joints[i]->getAcceleration(), ydd);
 			}
-			
-			return this->invGammaVelocity * qdd;
 		}
 		
 		::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1>
@@ -413,13 +629,21 @@ namespace rl
 		Model::getPosition() const
 		{
 			::rl::math::Vector q(this->getDofPosition());
+			this->getPosition(q);
+			return q;
+		}
+		
+		void
+		Model::getPosition(::rl::math::VectorRef y) const
+		{
+			assert(y.size() == this->getDofPosition());
+			
+			y.setZero();
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
 			{
-				q.segment(j, this->joints[i]->getDofPosition()) = this->joints[i]->getPosition();
+				this->invGammaPositionCoupling.multiplyColumns(j, this->joints[i]->getPosition(), y);
 			}
-			
-			return this->invGammaPosition * q;
 		}
 		
 		::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1>
@@ -474,6 +698,17 @@ namespace rl
 			return tau;
 		}
 		
+		void
+		Model::getTorque(::rl::math::VectorRef tau) const
+		{
+			assert(tau.size() == this->getDof());
+			
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			{
+				tau.segment(j, this->joints[i]->getDof()) = this->joints[i]->getTorque();
+			}
+		}
+		
 		::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1>
 		Model::getTorqueUnits() const
 		{
@@ -505,13 +740,21 @@ namespace rl
 		Model::getVelocity() const
 		{
 			::rl::math::Vector qd(this->getDof());
+			this->getVelocity(qd);
+			return qd;
+		}
+		
+		void
+		Model::getVelocity(::rl::math::VectorRef yd) const
+		{
+			assert(yd.size() == this->getDof());
+			
+			yd.setZero();
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
-				qd.segment(j, this->joints[i]->getDof()) = this->joints[i]->getVelocity();
+				this->invGammaVelocityCoupling.multiplyColumns(j, this->joints[i]->getVelocity(), yd);
 			}
-			
-			return this->invGammaVelocity * qd;
 		}
 		
 		::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1>
@@ -542,11 +785,11 @@ namespace rl
 		::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>
 		Model::getWraparounds() const
 		{
-			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> wraparounds(this->getDof());
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> wraparounds(this->getDofPosition());
 			
-			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
 			{
-				wraparounds.segment(j, this->joints[i]->getDof()) = this->joints[i]->wraparound;
+				wraparounds.segment(j, this->joints[i]->getDofPosition()) = this->joints[i]->wraparound;
 			}
 			
 			return wraparounds;
@@ -592,13 +835,13 @@ namespace rl
 		}
 		
 		void
-		Model::setAcceleration(const ::rl::math::Vector& ydd)
+		Model::setAcceleration(const ::rl::math::ConstVectorRef& ydd)
 		{
-			::rl::math::Vector qdd = this->gammaVelocity * ydd;
+			this->gammaVelocityCoupling.multiply(ydd, this->tmp.head(this->getDof()));
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
-				this->joints[i]->setAcceleration(qdd.segment(j, this->joints[i]->getDof()));
+				this->joints[i]->setAcceleration(this->tmp.segment(j, this->joints[i]->getDof()));
 			}
 		}
 		
@@ -606,6 +849,15 @@ namespace rl
 		Model::setGammaPosition(const ::rl::math::Matrix& gammaPosition)
 		{
 			this->gammaPosition = gammaPosition;
+			this->gammaPositionCoupling.assign(this->gammaPosition);
+			
+			if (Coupling::Type::sparse != this->gammaPositionCoupling.type)
+			{
+				this->invGammaPosition = this->gammaPosition.transpose();
+				this->invGammaPositionCoupling.assign(this->invGammaPosition);
+				return;
+			}
+			
 			::Eigen::JacobiSVD<::rl::math::Matrix> svd(this->gammaPosition, ::Eigen::ComputeThinU | ::Eigen::ComputeThinV);
 			::rl::math::Vector singularValues(svd.singularValues().size());
 			
@@ -615,12 +867,22 @@ namespace rl
 			}
 			
 			this->invGammaPosition = svd.matrixV() * singularValues.asDiagonal() * svd.matrixU().transpose();
+			this->invGammaPositionCoupling.assign(this->invGammaPosition);
 		}
 		
 		void
 		Model::setGammaVelocity(const ::rl::math::Matrix& gammaVelocity)
 		{
 			this->gammaVelocity = gammaVelocity;
+			this->gammaVelocityCoupling.assign(this->gammaVelocity);
+			
+			if (Coupling::Type::sparse != this->gammaVelocityCoupling.type)
+			{
+				this->invGammaVelocity = this->gammaVelocity.transpose();
+				this->invGammaVelocityCoupling.assign(this->invGammaVelocity);
+				return;
+			}
+			
 			::Eigen::JacobiSVD<::rl::math::Matrix> svd(this->gammaVelocity, ::Eigen::ComputeThinU | ::Eigen::ComputeThinV);
 			::rl::math::Vector singularValues(svd.singularValues().size());
 			
@@ -630,6 +892,7 @@ namespace rl
 			}
 			
 			this->invGammaVelocity = svd.matrixV() * singularValues.asDiagonal() * svd.matrixU().transpose();
+			this->invGammaVelocityCoupling.assign(this->invGammaVelocity);
 		}
 		
 		void
@@ -675,13 +938,13 @@ namespace rl
 		}
 		
 		void
-		Model::setPosition(const ::rl::math::Vector& y)
+		Model::setPosition(const ::rl::math::ConstVectorRef& y)
 		{
-			::rl::math::Vector q = this->gammaPosition * y;
+			this->gammaPositionCoupling.multiply(y, this->tmp.head(this->getDofPosition()));
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
 			{
-				this->joints[i]->setPosition(q.segment(j, this->joints[i]->getDofPosition()));
+				this->joints[i]->setPosition(this->tmp.segment(j, this->joints[i]->getDofPosition()));
 			}
 		}
 		
@@ -695,7 +958,7 @@ namespace rl
 		}
 		
 		void
-		Model::setTorque(const ::rl::math::Vector& tau)
+		Model::setTorque(const ::rl::math::ConstVectorRef& tau)
 		{
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
@@ -704,13 +967,13 @@ namespace rl
 		}
 		
 		void
-		Model::setVelocity(const ::rl::math::Vector& yd)
+		Model::setVelocity(const ::rl::math::ConstVectorRef& yd)
 		{
-			::rl::math::Vector qd = this->gammaVelocity * yd;
+			this->gammaVelocityCoupling.multiply(yd, this->tmp.head(this->getDof()));
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
-				this->joints[i]->setVelocity(qd.segment(j, this->joints[i]->getDof()));
+				this->joints[i]->setVelocity(this->tmp.segment(j, this->joints[i]->getDof()));
 			}
 		}
 		
@@ -741,12 +1004,46 @@ namespace rl
 		{
 			this->bodies.clear();
 			this->elements.clear();
+			this->frames.clear();
 			this->joints.clear();
 			this->leaves.clear();
+			this->operations.clear();
 			this->tools.clear();
 			this->transforms.clear();
 			
 			this->update(this->root);
+			
+			this->gammaPosition = ::rl::math::Matrix::Identity(this->getDofPosition(), this->getDofPosition());
+			this->gammaVelocity = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
+			this->home = ::rl::math::Vector::Zero(this->getDofPosition());
+			this->invGammaPosition = ::rl::math::Matrix::Identity(this->getDofPosition(), this->getDofPosition());
+			this->invGammaVelocity = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
+			
+			this->gammaPositionCoupling.assign(this->gammaPosition);
+			this->gammaVelocityCoupling.assign(this->gammaVelocity);
+			this->invGammaPositionCoupling.assign(this->invGammaPosition);
+			this->invGammaVelocityCoupling.assign(this->invGammaVelocity);
+			
+			this->parents.assign(this->getDof(), this->getDof());
+			
+			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			{
+				this->parents[j] = this->findParentDof(this->joints[i]->in->getVertexDescriptor());
+				
+				for (::std::size_t k = 1; k < this->joints[i]->getDof(); ++k)
+				{
+					this->parents[j + k] = j + k - 1;
+				}
+			}
+			
+			this->tmp.resize(this->getDofPosition());
+			
+			this->leafParents.resize(this->leaves.size());
+			
+			for (::std::size_t i = 0; i < this->leaves.size(); ++i)
+			{
+				this->leafParents[i] = this->findParentDof(this->leaves[i]);
+			}
 		}
 		
 		void
@@ -756,6 +1053,23 @@ namespace rl
 			this->elements.push_back(frame);
 			this->frames.push_back(frame);
 			
+			if (typeid(*frame) == typeid(Body))
+			{
+				this->operations.push_back({frame, Operation::Type::body});
+			}
+			else if (typeid(*frame) == typeid(Frame))
+			{
+				this->operations.push_back({frame, Operation::Type::frame});
+			}
+			else if (typeid(*frame) == typeid(World))
+			{
+				this->operations.push_back({frame, Operation::Type::world});
+			}
+			else
+			{
+				this->operations.push_back({frame, Operation::Type::element});
+			}
+			
 			if (Body* body = dynamic_cast<Body*>(frame))
 			{
 				this->bodies.push_back(body);
@@ -774,6 +1088,26 @@ namespace rl
 					transform->in = this->tree[u].get();
 					transform->out = this->tree[v].get();
 					
+					if (typeid(*transform) == typeid(Fixed) || typeid(*transform) == typeid(Transform))
+					{
+						this->operations.push_back({transform, Operation::Type::transform});
+					}
+					else if (
+						typeid(*transform) == typeid(Cylindrical) ||
+						typeid(*transform) == typeid(Helical) ||
+						typeid(*transform) == typeid(Prismatic) ||
+						typeid(*transform) == typeid(Revolute) ||
+						typeid(*transform) == typeid(SixDof) ||
+						typeid(*transform) == typeid(Spherical)
+					)
+					{
+						this->operations.push_back({transform, Operation::Type::joint});
+					}
+					else
+					{
+						this->operations.push_back({transform, Operation::Type::element});
+					}
+					
 					if (Joint* joint = dynamic_cast<Joint*>(transform))
 					{
 						this->joints.push_back(joint);
@@ -791,12 +1125,6 @@ namespace rl
 					this->tools.push_back(*i.first);
 				}
 			}
-			
-			this->gammaPosition = ::rl::math::Matrix::Identity(this->getDofPosition(), this->getDofPosition());
-			this->gammaVelocity = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
-			this->home = ::rl::math::Vector::Zero(this->getDofPosition());
-			this->invGammaPosition = ::rl::math::Matrix::Identity(this->getDofPosition(), this->getDofPosition());
-			this->invGammaVelocity = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
 		}
 		
 		::rl::math::Transform&
@@ -35,6 +35,7 @@
 #include <rl/math/Transform.h>
 #include <rl/math/Units.h>
 #include <rl/math/Vector.h>
+#include <Eigen/SparseCore>
 
 #include "Frame.h"
 #include "Transform.h"
@@ -58,8 +59,22 @@ namespace rl
 		public:
 			Model();
 			
+			/**
+			 * Create a deep copy of a model.
+			 *
+			 * All frames and transforms are cloned, so the copy may be evaluated
+			 * independently of the original, e.g., in a separate thread.
+			 */
+			Model(const Model& other);
+			
 			virtual ~Model();
 			
+			/**
+			 * Assignment would share frames and transforms, use the copy
+			 * constructor or clone() instead.
+			 */
+			Model& operator=(const Model& other) = delete;
+			
 			RL_MDL_DEPRECATED void add(Frame* frame);
 			
 			void add(const ::std::shared_ptr<Frame>& frame);
@@ -70,6 +85,14 @@ namespace rl
 			
 			bool areColliding(const ::std::size_t& i, const ::std::size_t& j) const;
 			
+			/**
+			 * Create a deep copy of a model of the same type.
+			 *
+			 * @return Newly allocated copy, owned by the caller
+			 * @see Model(const Model&)
+			 */
+			virtual Model* clone() const;
+			
 			::rl::math::Vector generatePositionGaussian(const ::rl::math::Vector& mean, const ::rl::math::Vector& sigma);
 			
 			::rl::math::Vector generatePositionGaussian(const ::rl::math::Vector& rand, const ::rl::math::Vector& mean, const ::rl::math::Vector& sigma) const;
@@ -84,6 +107,13 @@ namespace rl
 			
 			::rl::math::Vector getAcceleration() const;
 			
+			/**
+			 * Get joint accelerations without allocating a new vector.
+			 *
+			 * @param[out] qdd Joint accelerations, column of a preallocated matrix
+			 */
+			void getAcceleration(::rl::math::VectorRef qdd) const;
+			
 			::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1> getAccelerationUnits() const;
 			
 			::std::size_t getBodies() const;
@@ -136,6 +166,13 @@ namespace rl
 			
 			::rl::math::Vector getPosition() const;
 			
+			/**
+			 * Get joint positions without allocating a new vector.
+			 *
+			 * @param[out] q Joint positions, column of a preallocated matrix
+			 */
+			void getPosition(::rl::math::VectorRef q) const;
+			
 			::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1> getPositionUnits() const;
 			
 			Transform* getTransform(const ::std::size_t& i) const;
@@ -148,10 +185,24 @@ namespace rl
 			
 			::rl::math::Vector getTorque() const;
 			
+			/**
+			 * Get joint torques without allocating a new vector.
+			 *
+			 * @param[out] tau Joint torques, column of a preallocated matrix
+			 */
+			void getTorque(::rl::math::VectorRef tau) const;
+			
 			::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1> getTorqueUnits() const;
 			
 			::rl::math::Vector getVelocity() const;
 			
+			/**
+			 * Get joint velocities without allocating a new vector.
+			 *
+			 * @param[out] qd Joint velocities, column of a preallocated matrix
+			 */
+			void getVelocity(::rl::math::VectorRef qd) const;
+			
 			::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1> getVelocityUnits() const;
 			
 			World* getWorld() const;
@@ -168,7 +219,7 @@ namespace rl
 			
 			void seed(const ::std::mt19937::result_type& value);
 			
-			void setAcceleration(const ::rl::math::Vector& qdd);
+			void setAcceleration(const ::rl::math::ConstVectorRef& qdd);
 			
 			void setGammaPosition(const ::rl::math::Matrix& gammaPosition);
 			
@@ -186,13 +237,13 @@ namespace rl
 			
 			void setOperationalVelocity(const ::std::size_t& i, const ::rl::math::MotionVector& v) const;
 			
-			void setPosition(const ::rl::math::Vector& q);
+			void setPosition(const ::rl::math::ConstVectorRef& q);
 			
 			void setSpeed(const ::rl::math::Vector& speed);
 			
-			void setTorque(const ::rl::math::Vector& tau);
+			void setTorque(const ::rl::math::ConstVectorRef& tau);
 			
-			void setVelocity(const ::rl::math::Vector& qd);
+			void setVelocity(const ::rl::math::ConstVectorRef& qd);
 			
 			void setWorldGravity(const ::rl::math::Vector3& gravity);
 			
@@ -237,6 +288,85 @@ namespace rl
 			
 			typedef ::std::pair<VertexIterator, VertexIterator> VertexIteratorPair;
 			
+			/**
+			 * Structure of a joint space coupling matrix.
+			 *
+			 * Identity and permutation matrices are detected when the matrix
+			 * is assigned, so the common uncoupled case costs a copy and
+			 * general couplings only pay for their nonzero entries.
+			 */
+			struct Coupling
+			{
+				enum class Type
+				{
+					identity,
+					permutation,
+					sparse
+				};
+				
+				Coupling();
+				
+				/**
+				 * Classify matrix and store it in its cheapest representation.
+				 *
+				 * Entries smaller than machine epsilon relative to the largest
+				 * entry are treated as zero.
+				 */
+				void assign(const ::rl::math::Matrix& matrix);
+				
+				/**
+				 * Calculate \f$\vec{y} = \matr{C} \vec{x}\f$.
+				 */
+				void multiply(const ::rl::math::ConstVectorRef& x, ::rl::math::VectorRef y) const;
+				
+				/**
+				 * Calculate \f$\vec{y} \mathrel{+}= \matr{C}_{:, j \ldots j + n - 1} \vec{x}\f$.
+				 *
+				 * For identity and permutation matrices, the affected entries of
+				 * y are overwritten, so y must be zero before the first call.
+				 */
+				void multiplyColumns(const ::std::size_t& j, const ::rl::math::ConstVectorRef& x, ::rl::math::VectorRef y) const;
+				
+				::Eigen::PermutationMatrix<::Eigen::Dynamic, ::Eigen::Dynamic, ::std::ptrdiff_t> permutation;
+				
+				::Eigen::SparseMatrix<::rl::math::Real> sparse;
+				
+				Type type;
+			};
+			
+			/**
+			 * Step of the traversal plan.
+			 *
+			 * Elements of the types provided by this library are tagged with
+			 * their type, so sweeps may call their passes non-virtually and
+			 * skip passes without effect. Elements of derived types are called
+			 * virtually.
+			 */
+			struct Operation
+			{
+				enum class Type
+				{
+					body,
+					element,
+					frame,
+					joint,
+					transform,
+					world
+				};
+				
+				Element* element;
+				
+				Type type;
+			};
+			
+			/**
+			 * Find last degree of freedom of nearest joint above a frame.
+			 *
+			 * @param[in] u Frame to start from
+			 * @return Degree of freedom or getDof() if none
+			 */
+			::std::size_t findParentDof(const Vertex& u) const;
+			
 			void update(const Vertex& u);
 			
 			::std::vector<Body*> bodies;
@@ -247,24 +377,60 @@ namespace rl
 			
 			::rl::math::Matrix gammaPosition;
 			
+			Coupling gammaPositionCoupling;
+			
 			::rl::math::Matrix gammaVelocity;
 			
+			Coupling gammaVelocityCoupling;
+			
 			::rl::math::Vector home;
 			
 			::rl::math::Matrix invGammaPosition;
 			
+			Coupling invGammaPositionCoupling;
+			
 			::rl::math::Matrix invGammaVelocity;
 			
+			Coupling invGammaVelocityCoupling;
+			
 			::std::vector<Joint*> joints;
 			
+			/**
+			 * Parent degree of freedom of each leaf.
+			 *
+			 * Leaves without a parent joint refer to getDof().
+			 */
+			::std::vector<::std::size_t> leafParents;
+			
 			::std::vector<Vertex> leaves;
 			
 			::std::string manufacturer;
 			
 			::std::string name;
 			
+			/**
+			 * Elements in topological order, built in update().
+			 */
+			::std::vector<Operation> operations;
+			
+			/**
+			 * Parent degree of freedom of each degree of freedom.
+			 *
+			 * Degrees of freedom are numbered in topological order, so the parent
+			 * of i is always less than i. Degrees of freedom without a parent joint
+			 * refer to getDof().
+			 */
+			::std::vector<::std::size_t> parents;
+			
 			Vertex root;
 			
+			/**
+			 * Scratch space for joint space conversions in setters.
+			 *
+			 * Allocated in update(), so setters do not allocate.
+			 */
+			::rl::math::Vector tmp;
+			
 			::std::vector<Edge> tools;
 			
 			::std::vector<Transform*> transforms;
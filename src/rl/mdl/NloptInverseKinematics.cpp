@@ -39,14 +39,14 @@ namespace rl
 			randEngine(::std::random_device()()),
 			ub(this->kinematic->getMaximum())
 		{
-			Exception::check(::nlopt_set_ftol_abs(opt.get(), ::std::numeric_limits<double>::epsilon()));
-			Exception::check(::nlopt_set_ftol_rel(opt.get(), ::std::numeric_limits<double>::epsilon()));
-			Exception::check(::nlopt_set_lower_bounds(opt.get(), this->lb.data()));
+			Exception::check(::nlopt_set_ftol_abs(opt.get(), ::std::numeric_limits<::rl::math::Real>::epsilon()));
+			Exception::check(::nlopt_set_ftol_rel(opt.get(), ::std::numeric_limits<::rl::math::Real>::epsilon()));
+			Exception::check(::nlopt_set_lower_bounds(opt.get(), this->lb.cast<double>().eval().data()));
 			Exception::check(::nlopt_set_min_objective(opt.get(), &NloptInverseKinematics::f, this));
 			Exception::check(::nlopt_set_stopval(opt.get(), ::std::pow(this->getEpsilon(), 2)));
-			Exception::check(::nlopt_set_upper_bounds(opt.get(), this->ub.data()));
-			Exception::check(::nlopt_set_xtol_abs1(opt.get(), ::std::numeric_limits<double>::epsilon()));
-			Exception::check(::nlopt_set_xtol_rel(opt.get(), ::std::numeric_limits<double>::epsilon()));
+			Exception::check(::nlopt_set_upper_bounds(opt.get(), this->ub.cast<double>().eval().data()));
+			Exception::check(::nlopt_set_xtol_abs1(opt.get(), ::std::numeric_limits<::rl::math::Real>::epsilon()));
+			Exception::check(::nlopt_set_xtol_rel(opt.get(), ::std::numeric_limits<::rl::math::Real>::epsilon()));
 		}
 		
 		NloptInverseKinematics::~NloptInverseKinematics()
@@ -59,6 +59,11 @@ namespace rl
 			NloptInverseKinematics* ik = static_cast<NloptInverseKinematics*>(data);
 			++ik->iteration;
 			
+			if (ik->isCanceled())
+			{
+				::nlopt_force_stop(ik->opt.get());
+			}
+			
 			::Eigen::Map<const ::Eigen::VectorXd> q(x, n, 1);
 			
 			if (!q.allFinite())
@@ -66,7 +71,7 @@ namespace rl
 				return ::std::numeric_limits<double>::infinity();
 			}
 			
-			ik->kinematic->setPosition(q);
+			ik->kinematic->setPosition(q.cast<::rl::math::Real>());
 			ik->kinematic->forwardPosition();
 			
 			::rl::math::Vector dx = ::rl::math::Vector::Zero(6 * ik->kinematic->getOperationalDof());
@@ -81,7 +86,7 @@ namespace rl
 			{
 				::Eigen::Map<::Eigen::VectorXd> grad2(grad, n, 1);
 				ik->kinematic->calculateJacobian();
-				grad2 = -2 * ik->kinematic->getJacobian().transpose() * dx;
+				grad2 = (-2 * ik->kinematic->getJacobian().transpose() * dx).cast<double>();
 			}
 			
 			return dx.squaredNorm();
@@ -108,9 +113,9 @@ namespace rl
 		::rl::math::Vector
 		NloptInverseKinematics::getOptimizationToleranceAbsolute() const
 		{
-			::rl::math::Vector tol(this->kinematic->getDofPosition());
+			::Eigen::VectorXd tol(this->kinematic->getDofPosition());
 			Exception::check(::nlopt_get_xtol_abs(this->opt.get(), tol.data()));
-			return tol;
+			return tol.cast<::rl::math::Real>();
 		}
 		
 		::rl::math::Real
@@ -153,7 +158,7 @@ namespace rl
 		void
 		NloptInverseKinematics::setLowerBound(const ::rl::math::Vector& lb)
 		{
-			Exception::check(::nlopt_set_lower_bounds(opt.get(), lb.data()));
+			Exception::check(::nlopt_set_lower_bounds(opt.get(), lb.cast<double>().eval().data()));
 			this->lb = lb;
 		}
 		
@@ -166,7 +171,7 @@ namespace rl
 		void
 		NloptInverseKinematics::setOptimizationToleranceAbsolute(const ::rl::math::Vector& optimizationToleranceAbsolute)
 		{
-			Exception::check(::nlopt_set_xtol_abs(opt.get(), optimizationToleranceAbsolute.data()));
+			Exception::check(::nlopt_set_xtol_abs(opt.get(), optimizationToleranceAbsolute.cast<double>().eval().data()));
 		}
 		
 		void
@@ -178,7 +183,7 @@ namespace rl
 		void
 		NloptInverseKinematics::setUpperBound(const ::rl::math::Vector& ub)
 		{
-			Exception::check(::nlopt_set_upper_bounds(opt.get(), ub.data()));
+			Exception::check(::nlopt_set_upper_bounds(opt.get(), ub.cast<double>().eval().data()));
 			this->ub = ub;
 		}
 		
@@ -189,8 +194,13 @@ namespace rl
 			double remaining = ::std::chrono::duration<double>(this->getDuration()).count();
 			this->iteration = 0;
 			
+			if (!this->warmStart())
+			{
+				return false;
+			}
+			
 			::rl::math::Vector rand(this->kinematic->getDof());
-			::rl::math::Vector q = this->kinematic->getPosition();
+			::Eigen::VectorXd q = this->kinematic->getPosition().cast<double>();
 			double optF;
 			
 			do
@@ -221,11 +231,11 @@ namespace rl
 					rand(i) = this->randDistribution(this->randEngine);
 				}
 				
-				q = this->kinematic->generatePositionUniform(rand, this->lb, this->ub);
+				q = this->kinematic->generatePositionUniform(rand, this->lb, this->ub).cast<double>();
 				
 				remaining = ::std::chrono::duration<double>(this->getDuration() - (::std::chrono::steady_clock::now() - start)).count();
 			}
-			while (remaining > 0 && this->iteration < this->getIterations());
+			while (remaining > 0 && this->iteration < this->getIterations() && !this->isCanceled());
 			
 			return false;
 		}
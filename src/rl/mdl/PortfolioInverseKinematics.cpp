@@ -0,0 +1,256 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#include "Exception.h"
+#include "JacobianInverseKinematics.h"
+#include "Kinematic.h"
+#include "PortfolioInverseKinematics.h"
+
+#ifdef RL_MDL_NLOPT
+#include "NloptInverseKinematics.h"
+#endif
+
+namespace rl
+{
+	namespace mdl
+	{
+		PortfolioInverseKinematics::PortfolioInverseKinematics(Kinematic* kinematic, const ::std::size_t& threads) :
+			IterativeInverseKinematics(kinematic),
+			copies(),
+			methods(1, Method::svd),
+			randEngine(::std::random_device()()),
+			solvers(),
+			threads(threads > 0 ? threads : ::std::max<::std::size_t>(::std::thread::hardware_concurrency(), 1))
+		{
+			this->update();
+		}
+		
+		PortfolioInverseKinematics::~PortfolioInverseKinematics()
+		{
+		}
+		
+		const ::std::vector<PortfolioInverseKinematics::Method>&
+		PortfolioInverseKinematics::getMethods() const
+		{
+			return this->methods;
+		}
+		
+		::std::size_t
+		PortfolioInverseKinematics::getThreads() const
+		{
+			return this->threads;
+		}
+		
+		void
+		PortfolioInverseKinematics::seed(const ::std::mt19937::result_type& value)
+		{
+			this->randEngine.seed(value);
+		}
+		
+		void
+		PortfolioInverseKinematics::setMethods(const ::std::vector<Method>& methods)
+		{
+			if (methods.empty())
+			{
+				throw Exception("rl::mdl::PortfolioInverseKinematics::setMethods() - No method given");
+			}
+			
+#ifndef RL_MDL_NLOPT
+			if (methods.end() != ::std::find(methods.begin(), methods.end(), Method::slsqp))
+			{
+				throw Exception("rl::mdl::PortfolioInverseKinematics::setMethods() - Method::slsqp requires NLopt support");
+			}
+#endif
+			
+			this->methods = methods;
+			this->update();
+		}
+		
+		bool
+		PortfolioInverseKinematics::solve()
+		{
+			if (!this->warmStart())
+			{
+				return false;
+			}
+			
+			::std::vector<::std::mt19937::result_type> seeds(this->threads);
+			
+			for (::std::size_t i = 0; i < this->threads; ++i)
+			{
+				seeds[i] = this->randEngine();
+			}
+			
+			::rl::math::Vector q = this->kinematic->getPosition();
+			
+			::std::atomic<bool> cancel(false);
+			::std::atomic<::std::size_t> winner(this->threads);
+			::std::vector<::std::exception_ptr> exceptions(this->threads);
+			
+			auto function = [&](const ::std::size_t& i) {
+				try
+				{
+					Kinematic* kinematic = this->copies[i].get();
+					IterativeInverseKinematics* solver = this->solvers[i].get();
+					
+					if (0 == i)
+					{
+						kinematic->setPosition(q);
+					}
+					else
+					{
+						::std::uniform_real_distribution<::rl::math::Real> distribution(0, 1);
+						::std::mt19937 engine(seeds[i]);
+						::rl::math::Vector rand(kinematic->getDof());
+						
+						for (::std::size_t j = 0; j < kinematic->getDof(); ++j)
+						{
+							rand(j) = distribution(engine);
+						}
+						
+						kinematic->setPosition(kinematic->generatePositionUniform(rand));
+					}
+					
+					switch (this->methods[i % this->methods.size()])
+					{
+#ifdef RL_MDL_NLOPT
+					case Method::slsqp:
+						static_cast<NloptInverseKinematics*>(solver)->seed(seeds[i]);
+						break;
+#endif
+					default:
+						static_cast<JacobianInverseKinematics*>(solver)->seed(seeds[i]);
+						break;
+					}
+					
+					solver->clearGoals();
+					
+					for (::std::size_t j = 0; j < this->goals.size(); ++j)
+					{
+						solver->addGoal(this->goals[j]);
+					}
+					
+					solver->setCancel(&cancel);
+					solver->setDuration(this->getDuration());
+					solver->setEpsilon(this->getEpsilon());
+					solver->setIterations(this->getIterations());
+					
+					if (solver->solve())
+					{
+						::std::size_t none = this->threads;
+						
+						if (winner.compare_exchange_strong(none, i))
+						{
+							cancel = true;
+						}
+					}
+				}
+				catch (...)
+				{
+					exceptions[i] = ::std::current_exception();
+					cancel = true;
+				}
+			};
+			
+			if (this->threads < 2)
+			{
+				function(0);
+			}
+			else
+			{
+				::std::vector<::std::thread> workers;
+				workers.reserve(this->threads);
+				
+				for (::std::size_t i = 0; i < this->threads; ++i)
+				{
+					workers.emplace_back(function, i);
+				}
+				
+				for (::std::size_t i = 0; i < workers.size(); ++i)
+				{
+					workers[i].join();
+				}
+			}
+			
+			for (::std::size_t i = 0; i < exceptions.size(); ++i)
+			{
+				if (exceptions[i])
+				{
+					::std::rethrow_exception(exceptions[i]);
+				}
+			}
+			
+			if (winner < this->threads)
+			{
+				this->kinematic->setPosition(this->copies[winner].get()->getPosition());
+				return true;
+			}
+			
+			return false;
+		}
+		
+		void
+		PortfolioInverseKinematics::update()
+		{
+			this->copies.clear();
+			this->copies.reserve(this->threads);
+			this->solvers.clear();
+			this->solvers.reserve(this->threads);
+			
+			for (::std::size_t i = 0; i < this->threads; ++i)
+			{
+				this->copies.emplace_back(static_cast<Kinematic*>(this->kinematic->clone()));
+				
+				switch (this->methods[i % this->methods.size()])
+				{
+				case Method::dls:
+					this->solvers.emplace_back(new JacobianInverseKinematics(this->copies[i].get()));
+					static_cast<JacobianInverseKinematics*>(this->solvers[i].get())->setMethod(JacobianInverseKinematics::Method::dls);
+					break;
+#ifdef RL_MDL_NLOPT
+				case Method::slsqp:
+					this->solvers.emplace_back(new NloptInverseKinematics(this->copies[i].get()));
+					break;
+#endif
+				case Method::transpose:
+					this->solvers.emplace_back(new JacobianInverseKinematics(this->copies[i].get()));
+					static_cast<JacobianInverseKinematics*>(this->solvers[i].get())->setMethod(JacobianInverseKinematics::Method::transpose);
+					break;
+				default:
+					this->solvers.emplace_back(new JacobianInverseKinematics(this->copies[i].get()));
+					static_cast<JacobianInverseKinematics*>(this->solvers[i].get())->setMethod(JacobianInverseKinematics::Method::svd);
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_PORTFOLIOINVERSEKINEMATICS_H
+#define RL_MDL_PORTFOLIOINVERSEKINEMATICS_H
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "IterativeInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Iterative inverse kinematics with concurrent restarts.
+		 *
+		 * Runs one iterative solver per thread, each on its own copy of
+		 * the model. The first thread starts from the current joint position,
+		 * all others from uniformly sampled positions, methods are assigned to
+		 * threads in round-robin order. The first valid solution cancels all
+		 * other threads and is copied back into the model. Duration and
+		 * iterations apply to each thread.
+		 *
+		 * Start positions and random restarts of all threads are derived from
+		 * the generator set via seed(), so the set of explored positions per
+		 * call is reproducible. Which thread wins may still depend on
+		 * scheduling.
+		 */
+		class RL_MDL_EXPORT PortfolioInverseKinematics : public IterativeInverseKinematics
+		{
+		public:
+			enum class Method
+			{
+				/** JacobianInverseKinematics::Method::dls */
+				dls,
+				/** NloptInverseKinematics, requires NLopt support */
+				slsqp,
+				/** JacobianInverseKinematics::Method::svd */
+				svd,
+				/** JacobianInverseKinematics::Method::transpose */
+				transpose
+			};
+			
+			/**
+			 * @param[in] kinematic Model copied for each thread
+			 * @param[in] threads Number of threads, hardware concurrency if zero
+			 */
+			PortfolioInverseKinematics(Kinematic* kinematic, const ::std::size_t& threads = 0);
+			
+			virtual ~PortfolioInverseKinematics();
+			
+			const ::std::vector<Method>& getMethods() const;
+			
+			::std::size_t getThreads() const;
+			
+			void seed(const ::std::mt19937::result_type& value);
+			
+			/**
+			 * @param[in] methods Methods assigned to threads in round-robin order
+			 *
+			 * @throw Exception If a method is not supported by this build
+			 */
+			void setMethods(const ::std::vector<Method>& methods);
+			
+			bool solve();
+			
+			/**
+			 * Update copies of model after it has been modified.
+			 */
+			void update();
+			
+		protected:
+			
+		private:
+			::std::vector<::std::unique_ptr<Kinematic>> copies;
+			
+			::std::vector<Method> methods;
+			
+			::std::mt19937 randEngine;
+			
+			::std::vector<::std::unique_ptr<IterativeInverseKinematics>> solvers;
+			
+			::std::size_t threads;
+		};
+	}
+}
+
+#endif // RL_MDL_PORTFOLIOINVERSEKINEMATICS_H
@@ -45,6 +45,12 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Transform>
+		Prismatic::clone() const
+		{
+			return ::std::make_shared<Prismatic>(*this);
+		}
+		
 		void
 		Prismatic::setPosition(const ::rl::math::ConstVectorRef& q)
 		{
@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~Prismatic();
 			
+			::std::shared_ptr<Transform> clone() const;
+			
 			void setPosition(const ::rl::math::ConstVectorRef& q);
 			
 		protected:
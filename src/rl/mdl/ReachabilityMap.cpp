@@ -0,0 +1,572 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Exception.h"
+#include "Kinematic.h"
+#include "ReachabilityMap.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		namespace
+		{
+			const char magic[8] = {'r', 'l', 'r', 'e', 'a', 'c', 'h', '1'};
+			
+			/** Number of samples drawn from one seed. */
+			const ::std::size_t block = 1024;
+			
+			struct Cell
+			{
+				::std::uint64_t count;
+				
+				::rl::math::Real distance;
+				
+				::rl::math::Vector q;
+			};
+		}
+		
+		ReachabilityMap::ReachabilityMap(Kinematic* kinematic, const ::std::size_t& frame) :
+			counts(nullptr),
+			frame(frame),
+			header(nullptr),
+			keys(nullptr),
+			kinematic(kinematic),
+			orientationResolution(3),
+			randSeed(::std::mt19937::default_seed),
+			resolution(static_cast<::rl::math::Real>(0.05)),
+			seeds(nullptr),
+			storage()
+		{
+		}
+		
+		ReachabilityMap::~ReachabilityMap()
+		{
+		}
+		
+		void
+		ReachabilityMap::build(const ::std::size_t& samples, const ::std::size_t& threads)
+		{
+			assert(this->frame < this->kinematic->getOperationalDof());
+			assert(this->orientationResolution > 0);
+			assert(this->resolution > 0);
+			
+			::std::size_t blocks = (samples + block - 1) / block;
+			::std::size_t n = threads > 0 ? threads : ::std::max<::std::size_t>(::std::thread::hardware_concurrency(), 1);
+			n = ::std::max<::std::size_t>(::std::min(n, blocks), 1);
+			
+			::std::vector<::std::unique_ptr<Kinematic>> copies;
+			copies.reserve(n);
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				copies.emplace_back(static_cast<Kinematic*>(this->kinematic->clone()));
+			}
+			
+			// same samples in both passes, independent of the assignment of blocks to threads
+			auto sample = [&](const ::std::function<void(const ::std::size_t&, Kinematic*, const ::rl::math::Vector&)>& function) {
+				::std::atomic<::std::size_t> next(0);
+				::std::vector<::std::exception_ptr> exceptions(n);
+				::std::vector<::std::thread> workers;
+				workers.reserve(n);
+				
+				for (::std::size_t i = 0; i < n; ++i)
+				{
+					workers.emplace_back([&, i]() {
+						try
+						{
+							Kinematic* kinematic = copies[i].get();
+							
+							for (::std::size_t j = next++; j < blocks; j = next++)
+							{
+								kinematic->seed(this->randSeed + static_cast<::std::mt19937::result_type>(j));
+								
+								for (::std::size_t k = j * block; k < ::std::min((j + 1) * block, samples); ++k)
+								{
+									::rl::math::Vector q = kinematic->generatePositionUniform();
+									kinematic->setPosition(q);
+									kinematic->forwardPosition();
+									function(i, kinematic, q);
+								}
+							}
+						}
+						catch (...)
+						{
+							exceptions[i] = ::std::current_exception();
+							next = blocks;
+						}
+					});
+				}
+				
+				for (::std::size_t i = 0; i < workers.size(); ++i)
+				{
+					workers[i].join();
+				}
+				
+				for (::std::size_t i = 0; i < exceptions.size(); ++i)
+				{
+					if (exceptions[i])
+					{
+						::std::rethrow_exception(exceptions[i]);
+					}
+				}
+			};
+			
+			// bounding box of operational positions
+			
+			::std::vector<::rl::math::Vector3> minimum(n, ::rl::math::Vector3::Constant(::std::numeric_limits<::rl::math::Real>::max()));
+			::std::vector<::rl::math::Vector3> maximum(n, ::rl::math::Vector3::Constant(-::std::numeric_limits<::rl::math::Real>::max()));
+			
+			sample([&](const ::std::size_t& i, Kinematic* kinematic, const ::rl::math::Vector&) {
+				minimum[i] = minimum[i].cwiseMin(kinematic->getOperationalPosition(this->frame).translation());
+				maximum[i] = maximum[i].cwiseMax(kinematic->getOperationalPosition(this->frame).translation());
+			});
+			
+			for (::std::size_t i = 1; i < n; ++i)
+			{
+				minimum.front() = minimum.front().cwiseMin(minimum[i]);
+				maximum.front() = maximum.front().cwiseMax(maximum[i]);
+			}
+			
+			Header header;
+			::std::memcpy(header.magic, magic, sizeof(magic));
+			header.dof = this->kinematic->getDofPosition();
+			header.frame = this->frame;
+			header.orientations = this->orientationResolution;
+			header.resolution = this->resolution;
+			header.samples = samples;
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				// margin of half a voxel on each side
+				header.min[i] = samples > 0 ? minimum.front()(i) - this->resolution / 2 : 0;
+				header.size[i] = samples > 0 ? static_cast<::std::uint64_t>(::std::ceil((maximum.front()(i) - minimum.front()(i)) / this->resolution + 1)) : 0;
+			}
+			
+			header.cells = 0;
+			
+			// occupied cells with sample closest to voxel center
+			
+			::std::vector<::std::unordered_map<::std::uint64_t, Cell>> cells(n);
+			
+			sample([&](const ::std::size_t& i, Kinematic* kinematic, const ::rl::math::Vector& q) {
+				const ::rl::math::Transform& x = kinematic->getOperationalPosition(this->frame);
+				::std::int64_t voxel[3];
+				::std::int64_t face;
+				::std::int64_t direction[2];
+				
+				if (!this->getCell(header, x, voxel, face, direction))
+				{
+					return;
+				}
+				
+				::rl::math::Real distance = 0;
+				
+				for (::std::size_t j = 0; j < 3; ++j)
+				{
+					distance += ::std::pow(x.translation()(j) - (header.min[j] + (voxel[j] + static_cast<::rl::math::Real>(0.5)) * header.resolution), 2);
+				}
+				
+				Cell& cell = cells[i][this->getKey(header, voxel, face, direction)];
+				
+				if (0 == cell.count++ || distance < cell.distance)
+				{
+					cell.distance = distance;
+					cell.q = q;
+				}
+			});
+			
+			::std::map<::std::uint64_t, Cell> merged;
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				for (::std::unordered_map<::std::uint64_t, Cell>::iterator j = cells[i].begin(); j != cells[i].end(); ++j)
+				{
+					::std::map<::std::uint64_t, Cell>::iterator k = merged.find(j->first);
+					
+					if (merged.end() == k)
+					{
+						merged.insert(*j);
+					}
+					else
+					{
+						k->second.count += j->second.count;
+						
+						if (j->second.distance < k->second.distance)
+						{
+							k->second.distance = j->second.distance;
+							k->second.q = j->second.q;
+						}
+					}
+				}
+				
+				cells[i].clear();
+			}
+			
+			// image with header, sorted keys, counts, and seeds
+			
+			header.cells = merged.size();
+			
+			::std::shared_ptr<::std::vector<char>> buffer = ::std::make_shared<::std::vector<char>>(
+				sizeof(Header) + header.cells * (2 * sizeof(::std::uint64_t) + header.dof * sizeof(double))
+			);
+			
+			::std::memcpy(buffer->data(), &header, sizeof(Header));
+			::std::uint64_t* keys = reinterpret_cast<::std::uint64_t*>(buffer->data() + sizeof(Header));
+			::std::uint64_t* counts = keys + header.cells;
+			double* seeds = reinterpret_cast<double*>(counts + header.cells);
+			
+			for (::std::map<::std::uint64_t, Cell>::const_iterator i = merged.begin(); i != merged.end(); ++i, ++keys, ++counts, seeds += header.dof)
+			{
+				*keys = i->first;
+				*counts = i->second.count;
+				::Eigen::Map<::Eigen::VectorXd>(seeds, header.dof) = i->second.q.cast<double>();
+			}
+			
+			this->setImage(buffer->data(), buffer);
+		}
+		
+		const ::std::uint64_t*
+		ReachabilityMap::find(const ::std::uint64_t& key) const
+		{
+			const ::std::uint64_t* i = ::std::lower_bound(this->keys, this->keys + this->header->cells, key);
+			return this->keys + this->header->cells != i && key == *i ? i : nullptr;
+		}
+		
+		const ::std::uint64_t*
+		ReachabilityMap::findNearest(const ::rl::math::Transform& x) const
+		{
+			::std::int64_t voxel[3];
+			::std::int64_t face;
+			::std::int64_t direction[2];
+			
+			if (nullptr == this->header || !this->getCell(*this->header, x, voxel, face, direction))
+			{
+				return nullptr;
+			}
+			
+			if (const ::std::uint64_t* i = this->find(this->getKey(*this->header, voxel, face, direction)))
+			{
+				return i;
+			}
+			
+			const ::std::uint64_t* nearest = nullptr;
+			::std::int64_t nearestDistance = ::std::numeric_limits<::std::int64_t>::max();
+			::std::int64_t n = static_cast<::std::int64_t>(this->header->orientations);
+			
+			for (::std::int64_t i = -1; i < 2; ++i)
+			{
+				for (::std::int64_t j = -1; j < 2; ++j)
+				{
+					for (::std::int64_t k = -1; k < 2; ++k)
+					{
+						::std::int64_t neighbor[3] = {voxel[0] + i, voxel[1] + j, voxel[2] + k};
+						
+						if (
+							neighbor[0] < 0 || neighbor[0] >= static_cast<::std::int64_t>(this->header->size[0]) ||
+							neighbor[1] < 0 || neighbor[1] >= static_cast<::std::int64_t>(this->header->size[1]) ||
+							neighbor[2] < 0 || neighbor[2] >= static_cast<::std::int64_t>(this->header->size[2])
+						)
+						{
+							continue;
+						}
+						
+						for (::std::int64_t l = -1; l < 2; ++l)
+						{
+							for (::std::int64_t m = -1; m < 2; ++m)
+							{
+								::std::int64_t neighborDirection[2] = {direction[0] + l, direction[1] + m};
+								
+								if (neighborDirection[0] < 0 || neighborDirection[0] >= n || neighborDirection[1] < 0 || neighborDirection[1] >= n)
+								{
+									continue;
+								}
+								
+								::std::int64_t distance = i * i + j * j + k * k + l * l + m * m;
+								
+								if (distance > nearestDistance)
+								{
+									continue;
+								}
+								
+								const ::std::uint64_t* cell = this->find(this->getKey(*this->header, neighbor, face, neighborDirection));
+								
+								// prefer cells with more samples among equally close ones
+								if (nullptr != cell && (distance < nearestDistance || this->counts[cell - this->keys] > this->counts[nearest - this->keys]))
+								{
+									nearest = cell;
+									nearestDistance = distance;
+								}
+							}
+						}
+					}
+				}
+			}
+			
+			return nearest;
+		}
+		
+		bool
+		ReachabilityMap::getCell(const Header& header, const ::rl::math::Transform& x, ::std::int64_t (&voxel)[3], ::std::int64_t& face, ::std::int64_t (&direction)[2]) const
+		{
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				double index = ::std::floor((x.translation()(i) - header.min[i]) / header.resolution);
+				
+				if (index < 0 || index >= header.size[i])
+				{
+					return false;
+				}
+				
+				voxel[i] = static_cast<::std::int64_t>(index);
+			}
+			
+			// face of cube intersected by approach direction and position on face
+			
+			::rl::math::Vector3 z = x.linear().col(2);
+			::std::ptrdiff_t axis;
+			z.cwiseAbs().maxCoeff(&axis);
+			face = 2 * axis + (z(axis) < 0 ? 1 : 0);
+			
+			::std::int64_t n = static_cast<::std::int64_t>(header.orientations);
+			
+			for (::std::size_t i = 0; i < 2; ++i)
+			{
+				::rl::math::Real u = z((axis + 1 + i) % 3) / ::std::abs(z(axis));
+				direction[i] = ::std::min(::std::max(static_cast<::std::int64_t>(::std::floor((u + 1) / 2 * n)), static_cast<::std::int64_t>(0)), n - 1);
+			}
+			
+			return true;
+		}
+		
+		::std::size_t
+		ReachabilityMap::getCells() const
+		{
+			return nullptr != this->header ? this->header->cells : 0;
+		}
+		
+		::std::size_t
+		ReachabilityMap::getCount(const ::rl::math::Transform& x) const
+		{
+			::std::int64_t voxel[3];
+			::std::int64_t face;
+			::std::int64_t direction[2];
+			
+			if (nullptr == this->header || !this->getCell(*this->header, x, voxel, face, direction))
+			{
+				return 0;
+			}
+			
+			const ::std::uint64_t* i = this->find(this->getKey(*this->header, voxel, face, direction));
+			
+			return nullptr != i ? this->counts[i - this->keys] : 0;
+		}
+		
+		const ::std::size_t&
+		ReachabilityMap::getFrame() const
+		{
+			return this->frame;
+		}
+		
+		::std::uint64_t
+		ReachabilityMap::getKey(const Header& header, const ::std::int64_t (&voxel)[3], const ::std::int64_t& face, const ::std::int64_t (&direction)[2]) const
+		{
+			::std::uint64_t key = (voxel[0] * header.size[1] + voxel[1]) * header.size[2] + voxel[2];
+			return ((key * 6 + face) * header.orientations + direction[0]) * header.orientations + direction[1];
+		}
+		
+		Kinematic*
+		ReachabilityMap::getKinematic() const
+		{
+			return this->kinematic;
+		}
+		
+		const ::std::size_t&
+		ReachabilityMap::getOrientationResolution() const
+		{
+			return this->orientationResolution;
+		}
+		
+		::rl::math::Real
+		ReachabilityMap::getReachability(const ::rl::math::Vector3& position) const
+		{
+			::std::int64_t voxel[3];
+			::std::int64_t face;
+			::std::int64_t direction[2] = {0, 0};
+			
+			if (nullptr == this->header || !this->getCell(*this->header, ::rl::math::Transform(::rl::math::Translation(position)), voxel, face, direction))
+			{
+				return 0;
+			}
+			
+			// all approach directions of a voxel are stored consecutively
+			::std::uint64_t orientations = 6 * this->header->orientations * this->header->orientations;
+			::std::int64_t first[2] = {0, 0};
+			::std::uint64_t key = this->getKey(*this->header, voxel, 0, first);
+			const ::std::uint64_t* begin = ::std::lower_bound(this->keys, this->keys + this->header->cells, key);
+			const ::std::uint64_t* end = ::std::lower_bound(begin, this->keys + this->header->cells, key + orientations);
+			
+			return static_cast<::rl::math::Real>(end - begin) / orientations;
+		}
+		
+		const ::rl::math::Real&
+		ReachabilityMap::getResolution() const
+		{
+			return this->resolution;
+		}
+		
+		::std::size_t
+		ReachabilityMap::getSamples() const
+		{
+			return nullptr != this->header ? this->header->samples : 0;
+		}
+		
+		bool
+		ReachabilityMap::getSeed(const ::rl::math::Transform& x, ::rl::math::VectorRef q) const
+		{
+			assert(q.size() == this->kinematic->getDofPosition());
+			
+			const ::std::uint64_t* i = this->findNearest(x);
+			
+			if (nullptr == i)
+			{
+				return false;
+			}
+			
+			q = ::Eigen::Map<const ::Eigen::VectorXd>(this->seeds + (i - this->keys) * this->header->dof, this->header->dof).cast<::rl::math::Real>();
+			
+			return true;
+		}
+		
+		bool
+		ReachabilityMap::isReachable(const ::rl::math::Transform& x) const
+		{
+			return nullptr != this->findNearest(x);
+		}
+		
+		void
+		ReachabilityMap::load(const ::std::string& filename)
+		{
+			::std::shared_ptr<::boost::interprocess::mapped_region> region;
+			
+			try
+			{
+				::boost::interprocess::file_mapping file(filename.c_str(), ::boost::interprocess::read_only);
+				region = ::std::make_shared<::boost::interprocess::mapped_region>(file, ::boost::interprocess::read_only);
+			}
+			catch (const ::boost::interprocess::interprocess_exception& e)
+			{
+				throw Exception("rl::mdl::ReachabilityMap::load() - " + ::std::string(e.what()));
+			}
+			
+			const char* image = static_cast<const char*>(region->get_address());
+			const Header* header = reinterpret_cast<const Header*>(image);
+			
+			if (region->get_size() < sizeof(Header) || 0 != ::std::memcmp(header->magic, magic, sizeof(magic)))
+			{
+				throw Exception("rl::mdl::ReachabilityMap::load() - Invalid file");
+			}
+			
+			if (region->get_size() != sizeof(Header) + header->cells * (2 * sizeof(::std::uint64_t) + header->dof * sizeof(double)))
+			{
+				throw Exception("rl::mdl::ReachabilityMap::load() - Invalid file size");
+			}
+			
+			if (header->dof != this->kinematic->getDofPosition() || header->frame != this->frame)
+			{
+				throw Exception("rl::mdl::ReachabilityMap::load() - File does not match model");
+			}
+			
+			this->orientationResolution = header->orientations;
+			this->resolution = static_cast<::rl::math::Real>(header->resolution);
+			this->setImage(image, region);
+		}
+		
+		void
+		ReachabilityMap::save(const ::std::string& filename) const
+		{
+			if (nullptr == this->header)
+			{
+				throw Exception("rl::mdl::ReachabilityMap::save() - Map is empty");
+			}
+			
+			::std::ofstream file(filename.c_str(), ::std::ios::binary | ::std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(this->header), sizeof(Header) + this->header->cells * (2 * sizeof(::std::uint64_t) + this->header->dof * sizeof(double)));
+			
+			if (!file)
+			{
+				throw Exception("rl::mdl::ReachabilityMap::save() - Could not write file " + filename);
+			}
+		}
+		
+		void
+		ReachabilityMap::seed(const ::std::mt19937::result_type& value)
+		{
+			this->randSeed = value;
+		}
+		
+		void
+		ReachabilityMap::setImage(const char* image, const ::std::shared_ptr<void>& storage)
+		{
+			this->header = reinterpret_cast<const Header*>(image);
+			this->keys = reinterpret_cast<const ::std::uint64_t*>(image + sizeof(Header));
+			this->counts = this->keys + this->header->cells;
+			this->seeds = reinterpret_cast<const double*>(this->counts + this->header->cells);
+			this->storage = storage;
+		}
+		
+		void
+		ReachabilityMap::setOrientationResolution(const ::std::size_t& orientationResolution)
+		{
+			this->orientationResolution = orientationResolution;
+		}
+		
+		void
+		ReachabilityMap::setResolution(const ::rl::math::Real& resolution)
+		{
+			this->resolution = resolution;
+		}
+	}
+}
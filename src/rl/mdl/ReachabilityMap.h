@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_REACHABILITYMAP_H
+#define RL_MDL_REACHABILITYMAP_H
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <rl/math/Transform.h>
+#include <rl/math/Vector.h>
+#include <rl/mdl/export.h>
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Kinematic;
+		
+		/**
+		 * Sampled reachability of an operational frame with joint seeds.
+		 *
+		 * Uniformly sampled joint positions are evaluated via
+		 * Kinematic::forwardPosition() in parallel and the resulting poses
+		 * are binned into cells of a voxel grid and a grid of approach
+		 * directions, i.e., of the z-axis of the frame, on the faces of a
+		 * cube. Rotations about the approach direction are not distinguished.
+		 * Each occupied cell stores its number of samples and the joint
+		 * position of the sample closest to the center of its voxel.
+		 *
+		 * Occupied cells are kept in a single binary image sorted by cell,
+		 * queries use binary search. save() writes this image to a file,
+		 * load() maps a file into memory without copying or parsing it.
+		 * Files use the byte order of the machine that created them.
+		 *
+		 * As sampling does not cover the whole workspace, queries consider
+		 * the neighboring voxels and approach directions of a cell as well.
+		 *
+		 * Nikolaus Vahrenkamp, Tamim Asfour, and R&uuml;diger Dillmann.
+		 * Robot placement based on reachability inversion. In Proceedings of
+		 * the IEEE International Conference on Robotics and Automation,
+		 * pages 1970-1975, 2013.
+		 */
+		class RL_MDL_EXPORT ReachabilityMap
+		{
+		public:
+			/**
+			 * @param[in] kinematic Model copied for each thread
+			 * @param[in] frame Index of operational frame
+			 */
+			ReachabilityMap(Kinematic* kinematic, const ::std::size_t& frame = 0);
+			
+			virtual ~ReachabilityMap();
+			
+			/**
+			 * Sample joint space and replace all cells.
+			 *
+			 * Each thread draws its samples from a generator seeded via seed(),
+			 * so the result does not depend on the number of threads.
+			 *
+			 * @param[in] samples Number of joint positions
+			 * @param[in] threads Number of threads, hardware concurrency if zero
+			 */
+			void build(const ::std::size_t& samples, const ::std::size_t& threads = 0);
+			
+			/**
+			 * @return Number of occupied cells
+			 */
+			::std::size_t getCells() const;
+			
+			/**
+			 * @return Number of samples in the cell of a pose, zero if unknown
+			 */
+			::std::size_t getCount(const ::rl::math::Transform& x) const;
+			
+			const ::std::size_t& getFrame() const;
+			
+			Kinematic* getKinematic() const;
+			
+			/**
+			 * Number of approach directions per edge of each face of the cube,
+			 * the number of approach directions is
+			 * \f$6 \, n^{2}\f$.
+			 */
+			const ::std::size_t& getOrientationResolution() const;
+			
+			/**
+			 * Fraction of approach directions with samples in the voxel of a
+			 * position.
+			 */
+			::rl::math::Real getReachability(const ::rl::math::Vector3& position) const;
+			
+			/**
+			 * Edge length of voxels.
+			 */
+			const ::rl::math::Real& getResolution() const;
+			
+			::std::size_t getSamples() const;
+			
+			/**
+			 * Joint position of the occupied cell closest to a pose.
+			 *
+			 * @param[in] x Pose of operational frame
+			 * @param[out] q Joint position
+			 * @return False if neither the cell nor its neighbors are occupied
+			 */
+			bool getSeed(const ::rl::math::Transform& x, ::rl::math::VectorRef q) const;
+			
+			/**
+			 * @return False if neither the cell of a pose nor its neighbors are
+			 * occupied
+			 */
+			bool isReachable(const ::rl::math::Transform& x) const;
+			
+			/**
+			 * Map a file written by save() into memory.
+			 *
+			 * @throws Exception if the file is invalid or does not match the
+			 * model
+			 */
+			void load(const ::std::string& filename);
+			
+			void save(const ::std::string& filename) const;
+			
+			void seed(const ::std::mt19937::result_type& value);
+			
+			/**
+			 * @param[in] orientationResolution Number of approach directions per
+			 * edge of each face of the cube, used by the next call of build()
+			 */
+			void setOrientationResolution(const ::std::size_t& orientationResolution);
+			
+			/**
+			 * @param[in] resolution Edge length of voxels, used by the next call
+			 * of build()
+			 */
+			void setResolution(const ::rl::math::Real& resolution);
+			
+		protected:
+			
+		private:
+			struct Header
+			{
+				char magic[8];
+				
+				::std::uint64_t cells;
+				
+				::std::uint64_t dof;
+				
+				::std::uint64_t frame;
+				
+				double min[3];
+				
+				::std::uint64_t orientations;
+				
+				double resolution;
+				
+				::std::uint64_t samples;
+				
+				::std::uint64_t size[3];
+			};
+			
+			const ::std::uint64_t* find(const ::std::uint64_t& key) const;
+			
+			/**
+			 * @return Occupied cell in the neighborhood of a pose closest to
+			 * its cell or nullptr
+			 */
+			const ::std::uint64_t* findNearest(const ::rl::math::Transform& x) const;
+			
+			/**
+			 * @return False if position is outside of the voxel grid
+			 */
+			bool getCell(const Header& header, const ::rl::math::Transform& x, ::std::int64_t (&voxel)[3], ::std::int64_t& face, ::std::int64_t (&direction)[2]) const;
+			
+			::std::uint64_t getKey(const Header& header, const ::std::int64_t (&voxel)[3], const ::std::int64_t& face, const ::std::int64_t (&direction)[2]) const;
+			
+			void setImage(const char* image, const ::std::shared_ptr<void>& storage);
+			
+			const ::std::uint64_t* counts;
+			
+			::std::size_t frame;
+			
+			const Header* header;
+			
+			const ::std::uint64_t* keys;
+			
+			Kinematic* kinematic;
+			
+			::std::size_t orientationResolution;
+			
+			::std::mt19937::result_type randSeed;
+			
+			::rl::math::Real resolution;
+			
+			const double* seeds;
+			
+			/** Owner of the image, either a buffer or a mapped file. */
+			::std::shared_ptr<void> storage;
+		};
+	}
+}
+
+#endif // RL_MDL_REACHABILITYMAP_H
@@ -48,6 +48,12 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Transform>
+		Revolute::clone() const
+		{
+			return ::std::make_shared<Revolute>(*this);
+		}
+		
 		::rl::math::Real
 		Revolute::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~Revolute();
 			
+			::std::shared_ptr<Transform> clone() const;
+			
 			::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			void interpolate(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2, const ::rl::math::Real& alpha, ::rl::math::VectorRef q) const;
@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+#include "DormandPrinceIntegrator.h"
+#include "Dynamic.h"
+#include "EulerCauchyIntegrator.h"
+#include "RolloutEvaluator.h"
+#include "RungeKuttaNystromIntegrator.h"
+#include "SymplecticEulerIntegrator.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		RolloutEvaluator::RolloutEvaluator(Dynamic* dynamic, const ::std::size_t& threads) :
+			copies(),
+			dynamic(dynamic),
+			integrators(),
+			method(Method::rungeKuttaNystrom),
+			pool(threads)
+		{
+			this->update();
+		}
+		
+		RolloutEvaluator::~RolloutEvaluator()
+		{
+		}
+		
+		Dynamic*
+		RolloutEvaluator::getDynamic() const
+		{
+			return this->dynamic;
+		}
+		
+		const RolloutEvaluator::Method&
+		RolloutEvaluator::getMethod() const
+		{
+			return this->method;
+		}
+		
+		::std::size_t
+		RolloutEvaluator::getThreads() const
+		{
+			return this->pool.size();
+		}
+		
+		void
+		RolloutEvaluator::rollout(
+			const ::rl::math::ConstVectorRef& q0,
+			const ::rl::math::ConstVectorRef& qd0,
+			const ::rl::math::Matrix& Tau,
+			const ::std::size_t& steps,
+			const ::rl::math::Real& dt,
+			::rl::math::Matrix& Q,
+			::rl::math::Matrix& Qd,
+			::std::vector<::std::size_t>& lengths,
+			const Termination& termination
+		)
+		{
+			assert(q0.size() == this->dynamic->getDofPosition());
+			assert(qd0.size() == this->dynamic->getDof());
+			assert(Tau.rows() == this->dynamic->getDof());
+			assert(steps > 0);
+			assert(0 == Tau.cols() % steps);
+			
+			::std::size_t n = Tau.cols() / steps;
+			
+			Q.resize(this->dynamic->getDofPosition(), Tau.cols());
+			Qd.resize(this->dynamic->getDof(), Tau.cols());
+			lengths.resize(n);
+			
+			::std::atomic<::std::size_t> next(0);
+			
+			::std::function<void(const ::std::size_t&)> function = [&](const ::std::size_t& i) {
+				Dynamic* dynamic = this->copies[i].get();
+				Integrator* integrator = this->integrators[i].get();
+				
+				try
+				{
+					for (::std::size_t k = next++; k < n; k = next++)
+					{
+						dynamic->setPosition(q0);
+						dynamic->setVelocity(qd0);
+						
+						// step size of previous rollout on this thread depends on scheduling
+						if (Method::dormandPrince == this->method)
+						{
+							static_cast<DormandPrinceIntegrator*>(integrator)->setStepSize(0);
+						}
+						
+						::std::size_t t = 0;
+						
+						while (t < steps)
+						{
+							dynamic->setTorque(Tau.col(k * steps + t));
+							integrator->integrate(dt);
+							dynamic->getPosition(Q.col(k * steps + t));
+							dynamic->getVelocity(Qd.col(k * steps + t));
+							++t;
+							
+							if (termination && termination(Q.col(k * steps + t - 1), Qd.col(k * steps + t - 1), k, t - 1))
+							{
+								break;
+							}
+						}
+						
+						lengths[k] = t;
+						
+						for (::std::size_t j = t; j < steps; ++j)
+						{
+							Q.col(k * steps + j) = Q.col(k * steps + t - 1);
+							Qd.col(k * steps + j) = Qd.col(k * steps + t - 1);
+						}
+					}
+				}
+				catch (...)
+				{
+					// stop remaining rollouts
+					next = n;
+					throw;
+				}
+			};
+			
+			this->pool.run(::std::min(this->pool.size(), n), function);
+		}
+		
+		void
+		RolloutEvaluator::setMethod(const Method& method)
+		{
+			this->method = method;
+			this->update();
+		}
+		
+		void
+		RolloutEvaluator::update()
+		{
+			this->integrators.clear();
+			this->copies.clear();
+			this->copies.reserve(this->pool.size());
+			
+			for (::std::size_t i = 0; i < this->pool.size(); ++i)
+			{
+				this->copies.emplace_back(static_cast<Dynamic*>(this->dynamic->clone()));
+				
+				switch (this->method)
+				{
+				case Method::dormandPrince:
+					this->integrators.emplace_back(new DormandPrinceIntegrator(this->copies.back().get()));
+					break;
+				case Method::eulerCauchy:
+					this->integrators.emplace_back(new EulerCauchyIntegrator(this->copies.back().get()));
+					break;
+				case Method::rungeKuttaNystrom:
+					this->integrators.emplace_back(new RungeKuttaNystromIntegrator(this->copies.back().get()));
+					break;
+				case Method::symplecticEuler:
+					this->integrators.emplace_back(new SymplecticEulerIntegrator(this->copies.back().get()));
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_ROLLOUTEVALUATOR_H
+#define RL_MDL_ROLLOUTEVALUATOR_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <rl/math/Matrix.h>
+#include <rl/math/Vector.h>
+#include <rl/mdl/export.h>
+#include <rl/util/ThreadPool.h>
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Dynamic;
+		class Integrator;
+		
+		/**
+		 * Forward simulation of a batch of torque sequences from a common
+		 * initial state, e.g., for sampling-based model predictive control.
+		 *
+		 * Torque sequences and resulting states are given as columns of
+		 * column-major matrices, step t of rollout k is stored in column
+		 * k * steps + t, so every rollout is stored contiguously. Rollouts are
+		 * distributed dynamically among the threads of a pool that is kept
+		 * alive between calls, each thread simulates on its own copy of the
+		 * model and integrator. Adaptive integrators start
+		 * every rollout with the interval as step size, so results do not
+		 * depend on the assignment of rollouts to threads. The original model
+		 * is not modified.
+		 */
+		class RL_MDL_EXPORT RolloutEvaluator
+		{
+		public:
+			enum class Method
+			{
+				/** Adaptive steps within each time step, see DormandPrinceIntegrator. */
+				dormandPrince,
+				/** See EulerCauchyIntegrator. */
+				eulerCauchy,
+				/** See RungeKuttaNystromIntegrator. */
+				rungeKuttaNystrom,
+				/** See SymplecticEulerIntegrator. */
+				symplecticEuler
+			};
+			
+			/**
+			 * Predicate for terminating a rollout early.
+			 *
+			 * Called from several threads with the joint position and velocity
+			 * after each step and the index of rollout and step, returns true
+			 * to stop the rollout.
+			 */
+			typedef ::std::function<bool(const ::rl::math::ConstVectorRef&, const ::rl::math::ConstVectorRef&, const ::std::size_t&, const ::std::size_t&)> Termination;
+			
+			/**
+			 * @param[in] dynamic Model copied for each thread
+			 * @param[in] threads Number of threads, hardware concurrency if zero
+			 */
+			RolloutEvaluator(Dynamic* dynamic, const ::std::size_t& threads = 0);
+			
+			virtual ~RolloutEvaluator();
+			
+			Dynamic* getDynamic() const;
+			
+			const Method& getMethod() const;
+			
+			::std::size_t getThreads() const;
+			
+			/**
+			 * Simulate a batch of torque sequences.
+			 *
+			 * Terminated rollouts repeat their last state in the remaining
+			 * columns of Q and Qd.
+			 *
+			 * @param[in] q0 Initial joint position
+			 * @param[in] qd0 Initial joint velocity
+			 * @param[in] Tau Joint torques, steps columns per rollout
+			 * @param[in] steps Number of time steps per rollout
+			 * @param[in] dt Time step \f$\Delta t\f$
+			 * @param[out] Q Joint positions after each step
+			 * @param[out] Qd Joint velocities after each step
+			 * @param[out] lengths Number of simulated steps of each rollout
+			 * @param[in] termination Predicate for early termination, optional
+			 */
+			void rollout(
+				const ::rl::math::ConstVectorRef& q0,
+				const ::rl::math::ConstVectorRef& qd0,
+				const ::rl::math::Matrix& Tau,
+				const ::std::size_t& steps,
+				const ::rl::math::Real& dt,
+				::rl::math::Matrix& Q,
+				::rl::math::Matrix& Qd,
+				::std::vector<::std::size_t>& lengths,
+				const Termination& termination = Termination()
+			);
+			
+			void setMethod(const Method& method);
+			
+			/**
+			 * Update copies of model after it has been modified.
+			 */
+			void update();
+			
+		protected:
+			
+		private:
+			::std::vector<::std::unique_ptr<Dynamic>> copies;
+			
+			Dynamic* dynamic;
+			
+			::std::vector<::std::unique_ptr<Integrator>> integrators;
+			
+			Method method;
+			
+			::rl::util::ThreadPool pool;
+		};
+	}
+}
+
+#endif // RL_MDL_ROLLOUTEVALUATOR_H
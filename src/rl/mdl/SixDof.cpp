@@ -90,6 +90,12 @@ namespace rl
 			::Eigen::Map<::rl::math::Quaternion>(q.tail<4>().data()).normalize();
 		}
 		
+		::std::shared_ptr<Transform>
+		SixDof::clone() const
+		{
+			return ::std::make_shared<SixDof>(*this);
+		}
+		
 		::rl::math::Real
 		SixDof::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
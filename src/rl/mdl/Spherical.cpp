@@ -68,6 +68,12 @@ namespace rl
 			::Eigen::Map<::rl::math::Quaternion>(q.data()).normalize();
 		}
 		
+		::std::shared_ptr<Transform>
+		Spherical::clone() const
+		{
+			return ::std::make_shared<Spherical>(*this);
+		}
+		
 		::rl::math::Real
 		Spherical::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
@@ -42,6 +42,8 @@ namespace rl
 			
 			void clamp(::rl::math::VectorRef q) const;
 			
+			::std::shared_ptr<Transform> clone() const;
+			
 			::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			void generatePositionGaussian(const ::rl::math::ConstVectorRef& rand, const ::rl::math::ConstVectorRef& mean, const ::rl::math::ConstVectorRef& sigma, ::rl::math::VectorRef q) const;
@@ -0,0 +1,605 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <ostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include <rl/math/Rotation.h>
+
+#include "Exception.h"
+#include "Kinematic.h"
+#include "Revolute.h"
+#include "SphericalWristInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		namespace
+		{
+			/** Distance below which points and axes are considered identical. */
+			constexpr ::rl::math::Real tolerance = static_cast<::rl::math::Real>(1.0e-9);
+			
+			::std::string literal(const ::rl::math::Real& x)
+			{
+				::std::ostringstream stream;
+				stream.imbue(::std::locale::classic());
+				stream << ::std::setprecision(::std::numeric_limits<::rl::math::Real>::max_digits10) << x;
+				::std::string s = stream.str();
+				return ::std::string::npos == s.find_first_of(".e") ? s + ".0" : s;
+			}
+			
+			/**
+			 * Linear combination of expressions with constant coefficients,
+			 * an empty expression denotes a constant term.
+			 */
+			::std::string sum(const ::std::vector<::std::pair<::std::string, ::rl::math::Real>>& terms, const ::std::string& zero = "0")
+			{
+				::std::string s;
+				
+				for (::std::size_t i = 0; i < terms.size(); ++i)
+				{
+					if (0 == terms[i].second)
+					{
+						continue;
+					}
+					
+					if (s.empty())
+					{
+						s += terms[i].second < 0 ? "-" : "";
+					}
+					else
+					{
+						s += terms[i].second < 0 ? " - " : " + ";
+					}
+					
+					if (terms[i].first.empty())
+					{
+						s += literal(::std::abs(terms[i].second));
+					}
+					else if (1 == ::std::abs(terms[i].second))
+					{
+						s += terms[i].first;
+					}
+					else
+					{
+						s += literal(::std::abs(terms[i].second)) + " * " + terms[i].first;
+					}
+				}
+				
+				return s.empty() ? zero : s;
+			}
+			
+			::std::string parenthesize(const ::std::string& s)
+			{
+				return ::std::string::npos == s.find(' ') ? s : "(" + s + ")";
+			}
+			
+			::std::string dot(const ::rl::math::Vector3& c, const ::std::string& v)
+			{
+				return parenthesize(sum({{v + "(0)", c(0)}, {v + "(1)", c(1)}, {v + "(2)", c(2)}}));
+			}
+			
+			::std::string vector(const ::rl::math::Vector3& c)
+			{
+				return "::rl::math::Vector3(" + literal(c(0)) + ", " + literal(c(1)) + ", " + literal(c(2)) + ")";
+			}
+			
+			/**
+			 * Round components close to 0 or 1 to avoid rounding errors of the
+			 * model description in the generated code.
+			 */
+			void snap(::rl::math::Real& x)
+			{
+				if (::std::abs(x) < tolerance)
+				{
+					x = 0;
+				}
+				else if (::std::abs(::std::abs(x) - 1) < tolerance)
+				{
+					x = x < 0 ? -1 : 1;
+				}
+			}
+			
+			template<typename T>
+			void snap(T& x)
+			{
+				for (::std::ptrdiff_t i = 0; i < x.size(); ++i)
+				{
+					snap(x.data()[i]);
+				}
+			}
+		}
+		
+		SphericalWristInverseKinematics::SphericalWristInverseKinematics(Kinematic* kinematic) :
+			AnalyticalInverseKinematics(kinematic),
+			a1(),
+			a3(),
+			b1(),
+			b3(),
+			c1(),
+			c45(),
+			c56(),
+			d1(),
+			homeRotation(),
+			k3(),
+			n45(),
+			o1(),
+			o12(),
+			p56(),
+			s0(),
+			s1(),
+			s2(),
+			sign23(),
+			w1(),
+			w2(),
+			w4(),
+			w45(),
+			w5(),
+			w56(),
+			w6(),
+			w6y(),
+			wristTool(),
+			y6()
+		{
+			this->update();
+		}
+		
+		SphericalWristInverseKinematics::~SphericalWristInverseKinematics()
+		{
+		}
+		
+		::rl::math::Real
+		SphericalWristInverseKinematics::angle(const ::rl::math::Vector3& axis, const ::rl::math::Vector3& a, const ::rl::math::Vector3& b)
+		{
+			return ::std::atan2(axis.dot(a.cross(b)), a.dot(b) - axis.dot(a) * axis.dot(b));
+		}
+		
+		void
+		SphericalWristInverseKinematics::generate(::std::ostream& stream, const ::std::string& name) const
+		{
+			::std::string guard = name;
+			::std::transform(guard.begin(), guard.end(), guard.begin(), [](char c){ return ::std::toupper(c, ::std::locale::classic()); });
+			
+			::std::string w1xv[3] = {
+				sum({{"v(2)", this->w1(1)}, {"v(1)", -this->w1(2)}}),
+				sum({{"v(0)", this->w1(2)}, {"v(2)", -this->w1(0)}}),
+				sum({{"v(1)", this->w1(0)}, {"v(0)", -this->w1(1)}})
+			};
+			
+			stream << "// Generated by rl::mdl::SphericalWristInverseKinematics::generate()";
+			stream << (this->kinematic->getName().empty() ? "" : " for " + this->kinematic->getName()) << "." << ::std::endl;
+			stream << ::std::endl;
+			stream << "#ifndef " << guard << "_H" << ::std::endl;
+			stream << "#define " << guard << "_H" << ::std::endl;
+			stream << ::std::endl;
+			stream << "#include <algorithm>" << ::std::endl;
+			stream << "#include <cassert>" << ::std::endl;
+			stream << "#include <cmath>" << ::std::endl;
+			stream << "#include <cstddef>" << ::std::endl;
+			stream << "#include <rl/math/Matrix.h>" << ::std::endl;
+			stream << "#include <rl/math/Rotation.h>" << ::std::endl;
+			stream << "#include <rl/math/Vector.h>" << ::std::endl;
+			stream << "#include <rl/mdl/AnalyticalInverseKinematics.h>" << ::std::endl;
+			stream << "#include <rl/mdl/Kinematic.h>" << ::std::endl;
+			stream << ::std::endl;
+			stream << "class " << name << " : public ::rl::mdl::AnalyticalInverseKinematics" << ::std::endl;
+			stream << "{" << ::std::endl;
+			stream << "public:" << ::std::endl;
+			stream << "\t" << name << "(::rl::mdl::Kinematic* kinematic) :" << ::std::endl;
+			stream << "\t\tAnalyticalInverseKinematics(kinematic)" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "\tvirtual ~" << name << "()" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "\tbool solve()" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t\tassert(1 == this->goals.size());" << ::std::endl;
+			stream << "\t\tassert(0 == this->goals[0].second);" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\tconst ::rl::math::Transform& goal = this->goals[0].first;" << ::std::endl;
+			stream << "\t\t::rl::math::Vector q = this->kinematic->getPosition();" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\tthis->solutions.clear();" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			
+			if (this->homeRotation.isIdentity())
+			{
+				stream << "\t\tconst ::rl::math::Matrix33& goalRotation = goal.linear();" << ::std::endl;
+			}
+			else
+			{
+				stream << "\t\t::rl::math::Matrix33 homeRotation;" << ::std::endl;
+				stream << "\t\thomeRotation <<" << ::std::endl;
+				
+				for (::std::size_t i = 0; i < 3; ++i)
+				{
+					stream << "\t\t\t" << literal(this->homeRotation(i, 0)) << ", " << literal(this->homeRotation(i, 1)) << ", " << literal(this->homeRotation(i, 2)) << (i < 2 ? "," : ";") << ::std::endl;
+				}
+				
+				stream << "\t\t::rl::math::Matrix33 goalRotation = goal.linear() * homeRotation;" << ::std::endl;
+			}
+			
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\t// wrist center relative to axis 1" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\t::rl::math::Vector3 v = " << sum({{"goal.linear().col(0)", this->wristTool(0)}, {"goal.linear().col(1)", this->wristTool(1)}, {"goal.linear().col(2)", this->wristTool(2)}, {"goal.translation()", 1}});
+			stream << (this->o1.isZero() ? "" : " - " + vector(this->o1)) << ";" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\t::rl::math::Real theta1[2];" << ::std::endl;
+			stream << "\t\t::std::size_t n1 = solve(" << sum({{"v(0)", this->a1(0)}, {"v(1)", this->a1(1)}, {"v(2)", this->a1(2)}}) << ", ";
+			stream << sum({{"v(0)", this->b1(0)}, {"v(1)", this->b1(1)}, {"v(2)", this->b1(2)}}) << ", ";
+			stream << sum({{"", this->d1}, {"v(0)", -this->c1(0)}, {"v(1)", -this->c1(1)}, {"v(2)", -this->c1(2)}}) << ", q(0), theta1);" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\tfor (::std::size_t i1 = 0; i1 < n1; ++i1)" << ::std::endl;
+			stream << "\t\t{" << ::std::endl;
+			stream << "\t\t\t::rl::math::Real cos1 = ::std::cos(theta1[i1]);" << ::std::endl;
+			stream << "\t\t\t::rl::math::Real sin1 = ::std::sin(theta1[i1]);" << ::std::endl;
+			stream << "\t\t\t" << ::std::endl;
+			stream << "\t\t\t// wrist center relative to axis 2 before rotation of joint 1" << ::std::endl;
+			stream << "\t\t\t" << ::std::endl;
+			stream << "\t\t\t::rl::math::Real w1v = " << sum({{"v(0)", this->w1(0)}, {"v(1)", this->w1(1)}, {"v(2)", this->w1(2)}}) << ";" << ::std::endl;
+			stream << "\t\t\t::rl::math::Vector3 w1xv(" << w1xv[0] << ", " << w1xv[1] << ", " << w1xv[2] << ");" << ::std::endl;
+			stream << "\t\t\t::rl::math::Vector3 x = cos1 * v - sin1 * w1xv + ::rl::math::Vector3(";
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				stream << sum({{"(1 - cos1) * w1v", this->w1(i)}, {"", this->o12(i)}}) << (i < 2 ? ", " : ");");
+			}
+			
+			stream << ::std::endl;
+			stream << "\t\t\t::rl::math::Real w2x = " << sum({{"x(0)", this->w2(0)}, {"x(1)", this->w2(1)}, {"x(2)", this->w2(2)}}) << ";" << ::std::endl;
+			stream << "\t\t\t" << ::std::endl;
+			stream << "\t\t\t::rl::math::Real theta3[2];" << ::std::endl;
+			stream << "\t\t\t::std::size_t n3 = solve(" << literal(this->a3) << ", " << literal(this->b3) << ", (x.squaredNorm() - w2x * w2x - " << literal(this->k3) << ") / 2, q(2), theta3);" << ::std::endl;
+			stream << "\t\t\t" << ::std::endl;
+			stream << "\t\t\tfor (::std::size_t i3 = 0; i3 < n3; ++i3)" << ::std::endl;
+			stream << "\t\t\t{" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Real cos3 = ::std::cos(theta3[i3]);" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Real sin3 = ::std::sin(theta3[i3]);" << ::std::endl;
+			stream << "\t\t\t\t" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Vector3 s(";
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				stream << sum({{"cos3", this->s1(i)}, {"sin3", this->s2(i)}, {"", this->s0(i)}}) << (i < 2 ? ", " : ");");
+			}
+			
+			stream << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Vector3 sx = s.cross(x);" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Real theta2 = ::std::atan2(" << sum({{"sx(0)", this->w2(0)}, {"sx(1)", this->w2(1)}, {"sx(2)", this->w2(2)}}) << ", s.dot(x) - " << dot(this->w2, "s") << " * w2x);" << ::std::endl;
+			stream << "\t\t\t\t" << ::std::endl;
+			stream << "\t\t\t\t// rotation of joints 4 to 6" << ::std::endl;
+			stream << "\t\t\t\t" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Matrix33 R = (::rl::math::AngleAxis(theta1[i1], " << vector(this->w1) << ") * ::rl::math::AngleAxis(theta2 " << (this->sign23 > 0 ? "+" : "-") << " theta3[i3], " << vector(this->w2) << ")).toRotationMatrix().transpose() * goalRotation;" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Vector3 t = " << sum({{"R.col(0)", this->w6(0)}, {"R.col(1)", this->w6(1)}, {"R.col(2)", this->w6(2)}}) << ";" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Real w4t = " << sum({{"t(0)", this->w4(0)}, {"t(1)", this->w4(1)}, {"t(2)", this->w4(2)}}) << ";" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Real alpha = " << sum({{"", this->c45 * this->c56 / (this->c45 * this->c45 - 1)}, {"w4t", -1 / (this->c45 * this->c45 - 1)}}) << ";" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Real beta = " << sum({{"w4t", this->c45 / (this->c45 * this->c45 - 1)}, {"", -this->c56 / (this->c45 * this->c45 - 1)}}) << ";" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Real gamma2 = " << sum({{"", 1 / this->n45}, {"alpha * alpha", -1 / this->n45}, {"beta * beta", -1 / this->n45}, {"alpha * beta", -2 * this->c45 / this->n45}}) << ";" << ::std::endl;
+			stream << "\t\t\t\t" << ::std::endl;
+			stream << "\t\t\t\tif (gamma2 < " << literal(-tolerance) << ")" << ::std::endl;
+			stream << "\t\t\t\t{" << ::std::endl;
+			stream << "\t\t\t\t\tcontinue;" << ::std::endl;
+			stream << "\t\t\t\t}" << ::std::endl;
+			stream << "\t\t\t\t" << ::std::endl;
+			stream << "\t\t\t\t::rl::math::Real gamma = ::std::sqrt(::std::max(gamma2, static_cast<::rl::math::Real>(0)));" << ::std::endl;
+			stream << "\t\t\t\t" << ::std::endl;
+			stream << "\t\t\t\tfor (::std::size_t i5 = 0; i5 < (gamma > 0 ? 2 : 1); ++i5)" << ::std::endl;
+			stream << "\t\t\t\t{" << ::std::endl;
+			stream << "\t\t\t\t\t::rl::math::Real g = 0 == i5 ? gamma : -gamma;" << ::std::endl;
+			stream << "\t\t\t\t\t::rl::math::Vector3 z(";
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				stream << sum({{"alpha", this->w4(i)}, {"beta", this->w5(i)}, {"g", this->w45(i)}}) << (i < 2 ? ", " : ");");
+			}
+			
+			stream << ::std::endl;
+			stream << "\t\t\t\t\t::rl::math::Real theta5 = ::std::atan2(" << sum({{"z(0)", this->w56(0)}, {"z(1)", this->w56(1)}, {"z(2)", this->w56(2)}}) << ", " << sum({{"z(0)", this->p56(0)}, {"z(1)", this->p56(1)}, {"z(2)", this->p56(2)}}) << ");" << ::std::endl;
+			stream << "\t\t\t\t\t::rl::math::Vector3 zt = z.cross(t);" << ::std::endl;
+			stream << "\t\t\t\t\t::rl::math::Real theta4 = ::std::atan2(" << sum({{"zt(0)", this->w4(0)}, {"zt(1)", this->w4(1)}, {"zt(2)", this->w4(2)}}) << ", z.dot(t) - " << dot(this->w4, "z") << " * w4t);" << ::std::endl;
+			stream << "\t\t\t\t\t::rl::math::Vector3 y = ::rl::math::AngleAxis(-theta5, " << vector(this->w5) << ") * (::rl::math::AngleAxis(-theta4, " << vector(this->w4) << ") * " << parenthesize(sum({{"R.col(0)", this->y6(0)}, {"R.col(1)", this->y6(1)}, {"R.col(2)", this->y6(2)}})) << ");" << ::std::endl;
+			stream << "\t\t\t\t\t::rl::math::Real theta6 = ::std::atan2(" << sum({{"y(0)", this->w6y(0)}, {"y(1)", this->w6y(1)}, {"y(2)", this->w6y(2)}}) << ", " << sum({{"y(0)", this->y6(0)}, {"y(1)", this->y6(1)}, {"y(2)", this->y6(2)}}) << ");" << ::std::endl;
+			stream << "\t\t\t\t\t" << ::std::endl;
+			stream << "\t\t\t\t\t::rl::math::Vector solution(6);" << ::std::endl;
+			stream << "\t\t\t\t\tsolution << theta1[i1], theta2, theta3[i3], theta4, theta5, theta6;" << ::std::endl;
+			stream << "\t\t\t\t\tthis->addSolution(solution);" << ::std::endl;
+			stream << "\t\t\t\t}" << ::std::endl;
+			stream << "\t\t\t}" << ::std::endl;
+			stream << "\t\t}" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\treturn this->setClosestSolution();" << ::std::endl;
+			stream << "\t}" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "protected:" << ::std::endl;
+			stream << "\t" << ::std::endl;
+			stream << "private:" << ::std::endl;
+			stream << "\tstatic ::std::size_t solve(const ::rl::math::Real& a, const ::rl::math::Real& b, const ::rl::math::Real& c, const ::rl::math::Real& fallback, ::rl::math::Real (&theta)[2])" << ::std::endl;
+			stream << "\t{" << ::std::endl;
+			stream << "\t\t::rl::math::Real r = ::std::sqrt(a * a + b * b);" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\tif (r < " << literal(tolerance) << ")" << ::std::endl;
+			stream << "\t\t{" << ::std::endl;
+			stream << "\t\t\ttheta[0] = fallback;" << ::std::endl;
+			stream << "\t\t\treturn ::std::abs(c) < " << literal(tolerance) << " ? 1 : 0;" << ::std::endl;
+			stream << "\t\t}" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\tif (::std::abs(c) > r + " << literal(tolerance) << ")" << ::std::endl;
+			stream << "\t\t{" << ::std::endl;
+			stream << "\t\t\treturn 0;" << ::std::endl;
+			stream << "\t\t}" << ::std::endl;
+			stream << "\t\t" << ::std::endl;
+			stream << "\t\t::rl::math::Real phi = ::std::atan2(b, a);" << ::std::endl;
+			stream << "\t\t::rl::math::Real delta = ::std::acos(::std::max(::std::min(c / r, static_cast<::rl::math::Real>(1)), static_cast<::rl::math::Real>(-1)));" << ::std::endl;
+			stream << "\t\ttheta[0] = phi + delta;" << ::std::endl;
+			stream << "\t\ttheta[1] = phi - delta;" << ::std::endl;
+			stream << "\t\treturn delta > 0 ? 2 : 1;" << ::std::endl;
+			stream << "\t}" << ::std::endl;
+			stream << "};" << ::std::endl;
+			stream << ::std::endl;
+			stream << "#endif // " << guard << "_H" << ::std::endl;
+		}
+		
+		bool
+		SphericalWristInverseKinematics::solve()
+		{
+			assert(1 == this->goals.size());
+			assert(0 == this->goals[0].second);
+			
+			const ::rl::math::Transform& goal = this->goals[0].first;
+			::rl::math::Vector q = this->kinematic->getPosition();
+			
+			this->solutions.clear();
+			
+			::rl::math::Matrix33 goalRotation = goal.linear() * this->homeRotation;
+			
+			// wrist center relative to axis 1
+			
+			::rl::math::Vector3 v = goal * this->wristTool - this->o1;
+			
+			// rotation of joint 1 keeps wrist center at constant distance to plane of joints 2 and 3
+			
+			::rl::math::Real theta1[2];
+			::std::size_t n1 = solve(this->a1.dot(v), this->b1.dot(v), this->d1 - this->c1.dot(v), q(0), theta1);
+			
+			for (::std::size_t i1 = 0; i1 < n1; ++i1)
+			{
+				// wrist center relative to axis 2 before rotation of joint 1
+				
+				::rl::math::Vector3 x = ::rl::math::AngleAxis(-theta1[i1], this->w1) * v + this->o12;
+				::rl::math::Real w2x = this->w2.dot(x);
+				
+				// joint 3 determines distance of wrist center to axis 2
+				
+				::rl::math::Real theta3[2];
+				::std::size_t n3 = solve(this->a3, this->b3, (x.squaredNorm() - w2x * w2x - this->k3) / 2, q(2), theta3);
+				
+				for (::std::size_t i3 = 0; i3 < n3; ++i3)
+				{
+					::rl::math::Vector3 s = this->s0 + ::std::cos(theta3[i3]) * this->s1 + ::std::sin(theta3[i3]) * this->s2;
+					::rl::math::Real theta2 = angle(this->w2, s, x);
+					
+					// rotation of joints 4 to 6
+					
+					::rl::math::Matrix33 R = (::rl::math::AngleAxis(theta1[i1], this->w1) * ::rl::math::AngleAxis(theta2 + this->sign23 * theta3[i3], this->w2)).toRotationMatrix().transpose() * goalRotation;
+					
+					// joints 4 and 5 rotate axis 6 onto t
+					
+					::rl::math::Vector3 t = R * this->w6;
+					::rl::math::Real w4t = this->w4.dot(t);
+					::rl::math::Real alpha = (this->c45 * this->c56 - w4t) / (this->c45 * this->c45 - 1);
+					::rl::math::Real beta = (this->c45 * w4t - this->c56) / (this->c45 * this->c45 - 1);
+					::rl::math::Real gamma2 = (1 - alpha * alpha - beta * beta - 2 * this->c45 * alpha * beta) / this->n45;
+					
+					if (gamma2 < -tolerance)
+					{
+						continue;
+					}
+					
+					::rl::math::Real gamma = ::std::sqrt(::std::max(gamma2, static_cast<::rl::math::Real>(0)));
+					
+					for (::std::size_t i5 = 0; i5 < (gamma > 0 ? 2 : 1); ++i5)
+					{
+						::rl::math::Vector3 z = alpha * this->w4 + beta * this->w5 + (0 == i5 ? gamma : -gamma) * this->w45;
+						::rl::math::Real theta5 = ::std::atan2(this->w56.dot(z), this->p56.dot(z));
+						::rl::math::Real theta4 = angle(this->w4, z, t);
+						::rl::math::Vector3 y = ::rl::math::AngleAxis(-theta5, this->w5) * (::rl::math::AngleAxis(-theta4, this->w4) * (R * this->y6));
+						::rl::math::Real theta6 = ::std::atan2(this->w6y.dot(y), this->y6.dot(y));
+						
+						::rl::math::Vector solution(6);
+						solution << theta1[i1], theta2, theta3[i3], theta4, theta5, theta6;
+						this->addSolution(solution);
+					}
+				}
+			}
+			
+			return this->setClosestSolution();
+		}
+		
+		::std::size_t
+		SphericalWristInverseKinematics::solve(const ::rl::math::Real& a, const ::rl::math::Real& b, const ::rl::math::Real& c, const ::rl::math::Real& fallback, ::rl::math::Real (&theta)[2])
+		{
+			::rl::math::Real r = ::std::sqrt(a * a + b * b);
+			
+			if (r < tolerance)
+			{
+				theta[0] = fallback;
+				return ::std::abs(c) < tolerance ? 1 : 0;
+			}
+			
+			if (::std::abs(c) > r + tolerance)
+			{
+				return 0;
+			}
+			
+			::rl::math::Real phi = ::std::atan2(b, a);
+			::rl::math::Real delta = ::std::acos(::std::max(::std::min(c / r, static_cast<::rl::math::Real>(1)), static_cast<::rl::math::Real>(-1)));
+			theta[0] = phi + delta;
+			theta[1] = phi - delta;
+			return delta > 0 ? 2 : 1;
+		}
+		
+		void
+		SphericalWristInverseKinematics::update()
+		{
+			if (6 != this->kinematic->getJoints() || 6 != this->kinematic->getDof() || 6 != this->kinematic->getDofPosition() || this->kinematic->getOperationalDof() < 1)
+			{
+				throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Model does not have six joints and an operational frame");
+			}
+			
+			for (::std::size_t i = 0; i < 6; ++i)
+			{
+				if (nullptr == dynamic_cast<Revolute*>(this->kinematic->getJoint(i)))
+				{
+					throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Joint " + ::std::to_string(i) + " is not revolute");
+				}
+			}
+			
+			if (!this->kinematic->getGammaPosition().isIdentity())
+			{
+				throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Coupled joints are not supported");
+			}
+			
+			// joint axes at zero position
+			
+			::rl::math::Vector q = this->kinematic->getPosition();
+			this->kinematic->setPosition(::rl::math::Vector::Zero(6));
+			this->kinematic->forwardPosition();
+			
+			::rl::math::Vector3 o[6];
+			::rl::math::Vector3 w[6];
+			
+			for (::std::size_t i = 0; i < 6; ++i)
+			{
+				Joint* joint = this->kinematic->getJoint(i);
+				::rl::math::Transform x = joint->out->x.transform();
+				o[i] = x.translation();
+				w[i] = x.linear() * joint->S.block<3, 1>(0, 0).normalized();
+				snap(o[i]);
+				snap(w[i]);
+			}
+			
+			::rl::math::Transform home = this->kinematic->getOperationalPosition(0);
+			
+			this->kinematic->setPosition(q);
+			this->kinematic->forwardPosition();
+			
+			if (w[0].cross(w[1]).norm() < tolerance || w[1].cross(w[2]).norm() > tolerance || w[3].cross(w[4]).norm() < tolerance || w[4].cross(w[5]).norm() < tolerance)
+			{
+				throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Joint axes are not supported");
+			}
+			
+			// closest point of axes 4 and 5
+			
+			::rl::math::Real c = w[3].dot(w[4]);
+			::rl::math::Real d = w[3].dot(o[3] - o[4]);
+			::rl::math::Real e = w[4].dot(o[3] - o[4]);
+			::rl::math::Vector3 wrist = (o[3] + (c * e - d) / (1 - c * c) * w[3] + o[4] + (e - c * d) / (1 - c * c) * w[4]) / 2;
+			snap(wrist);
+			
+			for (::std::size_t i = 3; i < 6; ++i)
+			{
+				::rl::math::Vector3 r = wrist - o[i];
+				
+				if ((r - w[i] * w[i].dot(r)).norm() > ::std::sqrt(tolerance))
+				{
+					throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Axes of joints 4 to 6 do not intersect");
+				}
+			}
+			
+			this->o1 = o[0];
+			this->w1 = w[0];
+			this->w2 = w[1];
+			this->sign23 = w[1].dot(w[2]) > 0 ? 1 : -1;
+			this->w4 = w[3];
+			this->w5 = w[4];
+			this->w6 = w[5];
+			
+			this->c1 = this->w1 * this->w1.dot(this->w2);
+			this->a1 = this->w2 - this->c1;
+			this->b1 = this->w1.cross(this->w2);
+			this->d1 = this->w2.dot(wrist - this->o1);
+			
+			this->o12 = this->o1 - o[1];
+			
+			::rl::math::Vector3 m = wrist - o[2];
+			::rl::math::Vector3 o23 = o[2] - o[1];
+			this->s0 = o23 + w[2] * w[2].dot(m);
+			this->s1 = m - w[2] * w[2].dot(m);
+			this->s2 = w[2].cross(m);
+			::rl::math::Vector3 u = o23 - this->w2 * this->w2.dot(o23);
+			this->a3 = u.dot(this->s1);
+			this->b3 = u.dot(this->s2);
+			this->k3 = u.squaredNorm() + this->s1.squaredNorm();
+			
+			this->homeRotation = home.linear().transpose();
+			this->wristTool = home.inverse() * wrist;
+			
+			this->c45 = this->w4.dot(this->w5);
+			this->c56 = this->w5.dot(this->w6);
+			this->w45 = this->w4.cross(this->w5);
+			this->n45 = this->w45.squaredNorm();
+			this->w56 = this->w5.cross(this->w6);
+			this->p56 = this->w6 - this->w5 * this->c56;
+			this->y6 = this->w6.unitOrthogonal();
+			this->w6y = this->w6.cross(this->y6);
+			
+			snap(this->a1);
+			snap(this->a3);
+			snap(this->b1);
+			snap(this->b3);
+			snap(this->c1);
+			snap(this->c45);
+			snap(this->c56);
+			snap(this->d1);
+			snap(this->homeRotation);
+			snap(this->k3);
+			snap(this->n45);
+			snap(this->o12);
+			snap(this->p56);
+			snap(this->s0);
+			snap(this->s1);
+			snap(this->s2);
+			snap(this->w45);
+			snap(this->w56);
+			snap(this->w6y);
+			snap(this->wristTool);
+			snap(this->y6);
+		}
+	}
+}
@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_SPHERICALWRISTINVERSEKINEMATICS_H
+#define RL_MDL_SPHERICALWRISTINVERSEKINEMATICS_H
+
+#include <iosfwd>
+#include <string>
+#include <rl/math/Matrix.h>
+#include <rl/math/Vector.h>
+
+#include "AnalyticalInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Closed-form inverse kinematics for six revolute joints with a
+		 * spherical wrist.
+		 *
+		 * Joint axes are taken from the model at zero joint position, which
+		 * requires parallel axes for joints 2 and 3, a non-parallel axis for
+		 * joint 1, and intersecting axes for joints 4 to 6. This includes
+		 * most industrial arms with or without shoulder and elbow offsets.
+		 * The wrist center determines joints 1 to 3, the remaining rotation
+		 * joints 4 to 6, with up to eight solutions in getSolutions().
+		 * The model is set to the solution closest to its current joint
+		 * position.
+		 *
+		 * Richard M. Murray, Zexiang Li, and S. Shankar Sastry. A
+		 * Mathematical Introduction to Robotic Manipulation. CRC Press,
+		 * 1994, Section 3.3.
+		 */
+		class RL_MDL_EXPORT SphericalWristInverseKinematics : public AnalyticalInverseKinematics
+		{
+		public:
+			SphericalWristInverseKinematics(Kinematic* kinematic);
+			
+			virtual ~SphericalWristInverseKinematics();
+			
+			/**
+			 * Write a header with a solver for the current geometry.
+			 *
+			 * All geometric quantities are inserted as constants and terms
+			 * with zero coefficients are omitted, so the generated class does
+			 * not depend on the model description.
+			 *
+			 * @param[in] name Name of generated class
+			 */
+			void generate(::std::ostream& stream, const ::std::string& name) const;
+			
+			/**
+			 * Only supports a single goal for operational frame 0.
+			 */
+			bool solve();
+			
+			/**
+			 * Extract joint axes from model, required after changes to its
+			 * geometry or tool frame.
+			 *
+			 * @throws Exception If model does not consist of six revolute
+			 * joints with a spherical wrist
+			 */
+			void update();
+			
+		protected:
+			
+		private:
+			/**
+			 * Angle that rotates a onto b around axis.
+			 */
+			static ::rl::math::Real angle(const ::rl::math::Vector3& axis, const ::rl::math::Vector3& a, const ::rl::math::Vector3& b);
+			
+			/**
+			 * Solve \f$a \cos(\theta) + b \sin(\theta) = c\f$.
+			 *
+			 * @param[in] fallback Solution if equation does not depend on \f$\theta\f$
+			 * @return Number of solutions
+			 */
+			static ::std::size_t solve(const ::rl::math::Real& a, const ::rl::math::Real& b, const ::rl::math::Real& c, const ::rl::math::Real& fallback, ::rl::math::Real (&theta)[2]);
+			
+			/** Coefficients of joint 1 equation for axis 2 after rotation. */
+			::rl::math::Vector3 a1;
+			
+			/** Constant coefficient of joint 3 equation. */
+			::rl::math::Real a3;
+			
+			::rl::math::Vector3 b1;
+			
+			::rl::math::Real b3;
+			
+			::rl::math::Vector3 c1;
+			
+			/** Product of axes 4 and 5. */
+			::rl::math::Real c45;
+			
+			/** Product of axes 5 and 6. */
+			::rl::math::Real c56;
+			
+			::rl::math::Real d1;
+			
+			/** Transposed rotation of operational frame at zero position. */
+			::rl::math::Matrix33 homeRotation;
+			
+			::rl::math::Real k3;
+			
+			/** Squared norm of cross product of axes 4 and 5. */
+			::rl::math::Real n45;
+			
+			/** Point on axis 1. */
+			::rl::math::Vector3 o1;
+			
+			/** Offset from axis 2 to axis 1. */
+			::rl::math::Vector3 o12;
+			
+			/** Component of axis 6 orthogonal to axis 5. */
+			::rl::math::Vector3 p56;
+			
+			/** Wrist center relative to axis 2 as function of joint 3. */
+			::rl::math::Vector3 s0;
+			
+			::rl::math::Vector3 s1;
+			
+			::rl::math::Vector3 s2;
+			
+			/** Sign of joint 3 rotation with respect to axis 2. */
+			::rl::math::Real sign23;
+			
+			::rl::math::Vector3 w1;
+			
+			::rl::math::Vector3 w2;
+			
+			::rl::math::Vector3 w4;
+			
+			::rl::math::Vector3 w45;
+			
+			::rl::math::Vector3 w5;
+			
+			::rl::math::Vector3 w56;
+			
+			::rl::math::Vector3 w6;
+			
+			::rl::math::Vector3 w6y;
+			
+			/** Wrist center in operational frame. */
+			::rl::math::Vector3 wristTool;
+			
+			/** Unit vector orthogonal to axis 6. */
+			::rl::math::Vector3 y6;
+		};
+	}
+}
+
+#endif // RL_MDL_SPHERICALWRISTINVERSEKINEMATICS_H
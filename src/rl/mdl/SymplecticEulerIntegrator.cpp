@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include "Dynamic.h"
+#include "SymplecticEulerIntegrator.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		SymplecticEulerIntegrator::SymplecticEulerIntegrator(Dynamic* dynamic) :
+			Integrator(dynamic),
+			dy(),
+			f(),
+			y()
+		{
+			this->resize();
+		}
+		
+		SymplecticEulerIntegrator::~SymplecticEulerIntegrator()
+		{
+		}
+		
+		void
+		SymplecticEulerIntegrator::integrate(const ::rl::math::Real& dt)
+		{
+			this->resize();
+			
+			this->dynamic->getPosition(this->y);
+			this->dynamic->getVelocity(this->dy);
+			
+			this->dynamic->forwardDynamics();
+			
+			// f
+			this->dynamic->getAcceleration(this->f);
+			
+			// dy_0 + f * dt
+			this->dy += dt * this->f;
+			// y_0 + dy_1 * dt
+			this->y += dt * this->dy;
+			
+			this->dynamic->setPosition(this->y);
+			this->dynamic->setVelocity(this->dy);
+			this->dynamic->setAcceleration(this->f);
+		}
+		
+		void
+		SymplecticEulerIntegrator::resize()
+		{
+			this->dy.resize(this->dynamic->getDof());
+			this->f.resize(this->dynamic->getDof());
+			this->y.resize(this->dynamic->getDofPosition());
+		}
+	}
+}
@@ -0,0 +1,304 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Kinematic.h"
+#include "TrackingInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		TrackingInverseKinematics::TrackingInverseKinematics(Kinematic* kinematic) :
+			IterativeInverseKinematics(kinematic),
+			A(),
+			best(),
+			bestError(::std::numeric_limits<::rl::math::Real>::infinity()),
+			cache(),
+			cacheResolution(static_cast<::rl::math::Real>(0.1)),
+			capacity(16),
+			damping(static_cast<::rl::math::Real>(1.0e-3)),
+			dq(),
+			dx(),
+			dx2(),
+			J(),
+			J2(),
+			Jtdx(),
+			llt(),
+			next(0),
+			previous(),
+			q(),
+			q2(),
+			size(0)
+		{
+			this->setDuration(::std::chrono::milliseconds(1));
+			this->setIterations(100);
+		}
+		
+		TrackingInverseKinematics::~TrackingInverseKinematics()
+		{
+		}
+		
+		void
+		TrackingInverseKinematics::clear()
+		{
+			this->next = 0;
+			this->size = 0;
+		}
+		
+		::rl::math::Real
+		TrackingInverseKinematics::distance(const Solution& solution) const
+		{
+			if (solution.goals.size() != this->goals.size())
+			{
+				return ::std::numeric_limits<::rl::math::Real>::infinity();
+			}
+			
+			::rl::math::Real distance = 0;
+			
+			for (::std::size_t i = 0; i < this->goals.size(); ++i)
+			{
+				if (solution.goals[i].second != this->goals[i].second)
+				{
+					return ::std::numeric_limits<::rl::math::Real>::infinity();
+				}
+				
+				distance += solution.goals[i].first.toDelta(this->goals[i].first).squaredNorm();
+			}
+			
+			return distance;
+		}
+		
+		::rl::math::Real
+		TrackingInverseKinematics::evaluate(const ::rl::math::Vector& q, ::rl::math::Matrix& J, ::rl::math::Vector& dx)
+		{
+			this->kinematic->setPosition(q);
+			this->kinematic->calculateJacobian(J);
+			
+			dx.setZero();
+			
+			for (::std::size_t i = 0; i < this->goals.size(); ++i)
+			{
+				dx.segment<6>(6 * this->goals[i].second) = this->kinematic->getOperationalPosition(this->goals[i].second).toDelta(this->goals[i].first);
+			}
+			
+			::rl::math::Real error = dx.squaredNorm();
+			
+			if (error < this->bestError)
+			{
+				this->best = q;
+				this->bestError = error;
+			}
+			
+			return error;
+		}
+		
+		::std::size_t
+		TrackingInverseKinematics::getCacheSize() const
+		{
+			return this->size;
+		}
+		
+		const ::rl::math::Real&
+		TrackingInverseKinematics::getCacheResolution() const
+		{
+			return this->cacheResolution;
+		}
+		
+		const ::std::size_t&
+		TrackingInverseKinematics::getCapacity() const
+		{
+			return this->capacity;
+		}
+		
+		const ::rl::math::Real&
+		TrackingInverseKinematics::getDamping() const
+		{
+			return this->damping;
+		}
+		
+		bool
+		TrackingInverseKinematics::iterate(const ::rl::math::Vector& start, ::std::size_t& iteration, const ::std::chrono::steady_clock::time_point& begin)
+		{
+			this->q = start;
+			::rl::math::Real error = this->evaluate(this->q, this->J, this->dx);
+			::rl::math::Real lambda = this->damping;
+			
+			while (true)
+			{
+				if (error < ::std::pow(this->getEpsilon(), 2))
+				{
+					this->kinematic->normalize(this->q);
+					this->best = this->q;
+					this->bestError = error;
+					return this->kinematic->isValid(this->q);
+				}
+				
+				if (iteration >= this->getIterations() || ::std::chrono::steady_clock::now() - begin >= this->getDuration() || this->isCanceled())
+				{
+					return false;
+				}
+				
+				++iteration;
+				
+				// (J^T * J + lambda * 1)^-1 * J^T * dx
+				this->A.noalias() = this->J.transpose() * this->J;
+				this->A.diagonal().array() += lambda;
+				this->Jtdx.noalias() = this->J.transpose() * this->dx;
+				this->llt.compute(this->A);
+				this->dq = this->llt.solve(this->Jtdx);
+				
+				this->kinematic->step(this->q, this->dq, this->q2);
+				this->kinematic->clamp(this->q2);
+				
+				::rl::math::Real error2 = this->evaluate(this->q2, this->J2, this->dx2);
+				
+				if (error2 < error)
+				{
+					this->q.swap(this->q2);
+					this->J.swap(this->J2);
+					this->dx.swap(this->dx2);
+					error = error2;
+					lambda = ::std::max(lambda / 10, ::std::numeric_limits<::rl::math::Real>::epsilon());
+				}
+				else if (lambda < 1 / ::std::numeric_limits<::rl::math::Real>::epsilon())
+				{
+					lambda *= 10;
+				}
+				else
+				{
+					return false;
+				}
+			}
+		}
+		
+		void
+		TrackingInverseKinematics::setCacheResolution(const ::rl::math::Real& cacheResolution)
+		{
+			this->cacheResolution = cacheResolution;
+		}
+		
+		void
+		TrackingInverseKinematics::setCapacity(const ::std::size_t& capacity)
+		{
+			this->capacity = capacity;
+			this->cache.clear();
+			this->next = 0;
+			this->size = 0;
+		}
+		
+		void
+		TrackingInverseKinematics::setDamping(const ::rl::math::Real& damping)
+		{
+			this->damping = damping;
+		}
+		
+		bool
+		TrackingInverseKinematics::solve()
+		{
+			::std::chrono::steady_clock::time_point begin = ::std::chrono::steady_clock::now();
+			::std::size_t iteration = 0;
+			
+			// keep warm start from current joint position, only reject goals
+			if (!this->isReachable())
+			{
+				return false;
+			}
+			
+			this->A.resize(this->kinematic->getDof(), this->kinematic->getDof());
+			this->dq.resize(this->kinematic->getDof());
+			this->dx.resize(6 * this->kinematic->getOperationalDof());
+			this->dx2.resize(6 * this->kinematic->getOperationalDof());
+			this->J.resize(6 * this->kinematic->getOperationalDof(), this->kinematic->getDof());
+			this->J2.resize(6 * this->kinematic->getOperationalDof(), this->kinematic->getDof());
+			this->Jtdx.resize(this->kinematic->getDof());
+			this->q.resize(this->kinematic->getDofPosition());
+			this->q2.resize(this->kinematic->getDofPosition());
+			
+			this->previous.resize(this->kinematic->getDofPosition());
+			
+			// preallocate cache slots on first call after construction or setCapacity()
+			if (this->cache.size() != this->capacity)
+			{
+				this->cache.resize(this->capacity);
+				
+				for (::std::size_t i = 0; i < this->cache.size(); ++i)
+				{
+					this->cache[i].goals.reserve(this->kinematic->getOperationalDof());
+					this->cache[i].q.resize(this->kinematic->getDofPosition());
+				}
+			}
+			
+			// previous solution unless joint position was set in between
+			this->kinematic->getPosition(this->previous);
+			
+			this->bestError = ::std::numeric_limits<::rl::math::Real>::infinity();
+			
+			// start from cached solution if its goal is closer than the previous solution
+			
+			const Solution* nearest = nullptr;
+			::rl::math::Real nearestDistance = ::std::numeric_limits<::rl::math::Real>::infinity();
+			
+			for (::std::size_t i = 0; i < this->size; ++i)
+			{
+				::rl::math::Real distance = this->distance(this->cache[i]);
+				
+				if (distance < nearestDistance)
+				{
+					nearest = &this->cache[i];
+					nearestDistance = distance;
+				}
+			}
+			
+			const ::rl::math::Vector* start = &this->previous;
+			const ::rl::math::Vector* fallback = nullptr != nearest ? &nearest->q : nullptr;
+			
+			if (nullptr != nearest && nearestDistance < this->evaluate(this->previous, this->J, this->dx))
+			{
+				::std::swap(start, fallback);
+			}
+			
+			bool solved = this->iterate(*start, iteration, begin) || (nullptr != fallback && this->iterate(*fallback, iteration, begin));
+			
+			this->kinematic->setPosition(this->best);
+			
+			if (solved && this->capacity > 0 && nearestDistance > ::std::pow(this->cacheResolution, 2))
+			{
+				// copy in place, slots hold at least one goal per operational frame
+				this->cache[this->next].goals.assign(this->goals.begin(), this->goals.end());
+				this->cache[this->next].q = this->best;
+				this->next = (this->next + 1) % this->capacity;
+				this->size = ::std::min(this->size + 1, this->capacity);
+			}
+			
+			return solved;
+		}
+	}
+}
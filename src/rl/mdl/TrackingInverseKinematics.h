@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_TRACKINGINVERSEKINEMATICS_H
+#define RL_MDL_TRACKINGINVERSEKINEMATICS_H
+
+#include <vector>
+#include <rl/math/Matrix.h>
+#include <rl/math/Vector.h>
+#include <Eigen/Cholesky>
+
+#include "IterativeInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Iterative inverse kinematics for streams of slowly moving goals.
+		 *
+		 * Each call starts from the current joint position of the model, i.e.,
+		 * the previous solution unless the joint position was set in between,
+		 * and performs
+		 * Levenberg-Marquardt steps
+		 * \f$\Delta\vec{q} = (\matr{J}^{\mathrm{T}} \matr{J} + \lambda \matr{1})^{-1} \matr{J}^{\mathrm{T}} \Delta\vec{x}\f$,
+		 * decreasing the damping \f$\lambda\f$ after steps that reduce the
+		 * error and increasing it otherwise. There are no random restarts,
+		 * work per call is bounded by getIterations() and getDuration().
+		 *
+		 * Solutions that differ sufficiently from all stored ones are kept in
+		 * a small cache. If the goal is closer to a cached goal than the
+		 * previous solution is to the new goal, e.g., after a jump back to a
+		 * previously visited pose, the cached joint position is used as start
+		 * instead.
+		 *
+		 * If no solution is found within the budget, the model keeps the
+		 * joint position with the smallest error.
+		 *
+		 * Donald W. Marquardt. An algorithm for least-squares estimation of
+		 * nonlinear parameters. Journal of the Society for Industrial and
+		 * Applied Mathematics, 11(2):431-441, 1963.
+		 */
+		class RL_MDL_EXPORT TrackingInverseKinematics : public IterativeInverseKinematics
+		{
+		public:
+			TrackingInverseKinematics(Kinematic* kinematic);
+			
+			virtual ~TrackingInverseKinematics();
+			
+			/**
+			 * Remove all cached solutions.
+			 */
+			void clear();
+			
+			/**
+			 * @return Number of cached solutions
+			 */
+			::std::size_t getCacheSize() const;
+			
+			/**
+			 * Minimum distance of a goal to all cached goals for its solution
+			 * to be added to the cache.
+			 */
+			const ::rl::math::Real& getCacheResolution() const;
+			
+			const ::std::size_t& getCapacity() const;
+			
+			/**
+			 * Damping at start of each call.
+			 */
+			const ::rl::math::Real& getDamping() const;
+			
+			void setCacheResolution(const ::rl::math::Real& cacheResolution);
+			
+			/**
+			 * @param[in] capacity Maximum number of cached solutions, oldest
+			 * solutions are replaced first
+			 */
+			void setCapacity(const ::std::size_t& capacity);
+			
+			void setDamping(const ::rl::math::Real& damping);
+			
+			bool solve();
+			
+		protected:
+			
+		private:
+			struct Solution
+			{
+				::std::vector<Goal> goals;
+				
+				::rl::math::Vector q;
+			};
+			
+			/**
+			 * Squared distance of current goals to goals of a cached solution.
+			 *
+			 * @return Infinity if goals refer to different operational frames
+			 */
+			::rl::math::Real distance(const Solution& solution) const;
+			
+			/**
+			 * Set joint position and calculate Jacobian and squared error.
+			 */
+			::rl::math::Real evaluate(const ::rl::math::Vector& q, ::rl::math::Matrix& J, ::rl::math::Vector& dx);
+			
+			bool iterate(const ::rl::math::Vector& start, ::std::size_t& iteration, const ::std::chrono::steady_clock::time_point& begin);
+			
+			::rl::math::Matrix A;
+			
+			::rl::math::Vector best;
+			
+			::rl::math::Real bestError;
+			
+			/** Preallocated slots for getCapacity() solutions. */
+			::std::vector<Solution> cache;
+			
+			::rl::math::Real cacheResolution;
+			
+			::std::size_t capacity;
+			
+			::rl::math::Real damping;
+			
+			::rl::math::Vector dq;
+			
+			::rl::math::Vector dx;
+			
+			::rl::math::Vector dx2;
+			
+			::rl::math::Matrix J;
+			
+			::rl::math::Matrix J2;
+			
+			::rl::math::Vector Jtdx;
+			
+			::Eigen::LLT<::rl::math::Matrix> llt;
+			
+			::std::size_t next;
+			
+			/** Joint position at start of call. */
+			::rl::math::Vector previous;
+			
+			::rl::math::Vector q;
+			
+			::rl::math::Vector q2;
+			
+			/** Number of valid solutions in cache. */
+			::std::size_t size;
+		};
+	}
+}
+
+#endif // RL_MDL_TRACKINGINVERSEKINEMATICS_H
@@ -44,6 +44,25 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Transform>
+		Transform::clone() const
+		{
+			return ::std::make_shared<Transform>(*this);
+		}
+		
+		void
+		Transform::compositeRigidBody1()
+		{
+			this->forwardPosition();
+		}
+		
+		void
+		Transform::compositeRigidBody2()
+		{
+			// I^c + I^c
+			this->in->iC = this->in->iC + this->out->iC;
+		}
+		
 		void
 		Transform::forwardAcceleration()
 		{
@@ -108,6 +127,25 @@ namespace rl
 			this->inverseForce();
 		}
 		
+		void
+		Transform::inverseDynamicsDerivatives1()
+		{
+			this->forwardPosition();
+			this->inverseDynamics1();
+		}
+		
+		void
+		Transform::inverseDynamicsDerivatives2()
+		{
+			this->inverseDynamics2();
+			// B^c + B^c
+			this->in->bC += this->out->bC;
+			// f^c + f^c
+			this->in->fC = this->in->fC + this->out->fC;
+			// I^c + I^c
+			this->in->iC = this->in->iC + this->out->iC;
+		}
+		
 		void
 		Transform::inverseForce()
 		{
@@ -27,6 +27,7 @@
 #ifndef RL_MDL_TRANSFORM_H
 #define RL_MDL_TRANSFORM_H
 
+#include <memory>
 #include <boost/graph/adjacency_list.hpp>
 #include <rl/math/Spatial.h>
 #include <rl/math/Transform.h>
@@ -57,6 +58,12 @@ namespace rl
 			
 			virtual ~Transform();
 			
+			virtual ::std::shared_ptr<Transform> clone() const;
+			
+			virtual void compositeRigidBody1();
+			
+			virtual void compositeRigidBody2();
+			
 			virtual void forwardAcceleration();
 			
 			virtual void forwardDynamics1();
@@ -75,6 +82,10 @@ namespace rl
 			
 			virtual void inverseDynamics2();
 			
+			virtual void inverseDynamicsDerivatives1();
+			
+			virtual void inverseDynamicsDerivatives2();
+			
 			virtual void inverseForce();
 			
 			void setEdgeDescriptor(const Edge& descriptor);
@@ -40,6 +40,12 @@ namespace rl
 		{
 		}
 		
+		::std::shared_ptr<Frame>
+		World::clone() const
+		{
+			return ::std::make_shared<World>(*this);
+		}
+		
 		void
 		World::forwardAcceleration()
 		{
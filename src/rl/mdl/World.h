@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~World();
 			
+			::std::shared_ptr<Frame> clone() const;
+			
 			void forwardAcceleration();
 			
 			void forwardDynamics1();
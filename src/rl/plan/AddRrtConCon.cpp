@@ -26,7 +26,6 @@
 
 #include "AddRrtConCon.h"
 #include "SimpleModel.h"
-#include "Viewer.h"
 
 namespace rl
 {
@@ -36,7 +35,8 @@ namespace rl
 			RrtConCon(),
 			alpha(static_cast<::rl::math::Real>(0.05)),
 			lower(2),
-			radius(20)
+			radius(20),
+			radii(2)
 		{
 		}
 		
@@ -45,32 +45,13 @@ namespace rl
 		}
 		
 		Rrt::Vertex
-		AddRrtConCon::addVertex(Tree& tree, const VectorPtr& q)
+		AddRrtConCon::addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q)
 		{
-			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
-			bundle->index = ::boost::num_vertices(tree) - 1;
-			bundle->q = q;
-			bundle->radius = ::std::numeric_limits<::rl::math::Real>::max();
-			
-			Vertex v = ::boost::add_vertex(tree);
-			tree[v] = bundle;
-			
-			tree[::boost::graph_bundle].nn->push(Metric::Value(q.get(), v));
-			
-			if (nullptr != this->getViewer())
-			{
-				this->getViewer()->drawConfigurationVertex(*get(tree, v)->q);
-			}
-			
+			Vertex v = RrtConCon::addVertex(tree, q);
+			this->radii[&tree - this->tree.data()].push_back(::std::numeric_limits<::rl::math::Real>::max());
 			return v;
 		}
 		
-		AddRrtConCon::VertexBundle*
-		AddRrtConCon::get(const Tree& tree, const Vertex& v)
-		{
-			return static_cast<VertexBundle*>(tree[v].get());
-		}
-		
 		::rl::math::Real
 		AddRrtConCon::getAlpha() const
 		{
@@ -95,6 +76,23 @@ namespace rl
 			return this->radius;
 		}
 		
+		::rl::math::Real&
+		AddRrtConCon::getRadius(const Tree& tree, const Vertex& v)
+		{
+			return this->radii[&tree - this->tree.data()][v->index];
+		}
+		
+		void
+		AddRrtConCon::reset()
+		{
+			RrtConCon::reset();
+			
+			for (::std::size_t i = 0; i < this->radii.size(); ++i)
+			{
+				this->radii[i].clear();
+			}
+		}
+		
 		void
 		AddRrtConCon::setAlpha(const ::rl::math::Real& alpha)
 		{
@@ -118,8 +116,8 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart());
+			this->begin[1] = this->addVertex(this->tree[1], *this->getGoal());
 			
 			Tree* a = &this->tree[0];
 			Tree* b = &this->tree[1];
@@ -137,23 +135,23 @@ namespace rl
 						chosen = this->choose();
 						aNearest = this->nearest(*a, chosen);
 					}
-					while (aNearest.first > get(*a, aNearest.second)->radius);
+					while (aNearest.first > this->getRadius(*a, aNearest.second));
 					
 					Vertex aConnected = this->connect(*a, aNearest, chosen);
 					
 					if (nullptr != aConnected)
 					{
-						if (get(*a, aNearest.second)->radius < ::std::numeric_limits<::rl::math::Real>::max())
+						if (this->getRadius(*a, aNearest.second) < ::std::numeric_limits<::rl::math::Real>::max())
 						{
-							get(*a, aNearest.second)->radius *= (1 + this->alpha);
+							this->getRadius(*a, aNearest.second) *= (1 + this->alpha);
 						}
 						
 						Neighbor bNearest = this->nearest(*b, chosen);
-						Vertex bConnected = this->connect(*b, bNearest, *get(*a, aConnected)->q);
+						Vertex bConnected = this->connect(*b, bNearest, get(*a, aConnected)->q);
 						
 						if (nullptr != bConnected)
 						{
-							if (this->areEqual(*get(*a, aConnected)->q, *get(*b, bConnected)->q))
+							if (this->areEqual(get(*a, aConnected)->q, get(*b, bConnected)->q))
 							{
 								this->end[0] = &this->tree[0] == a ? aConnected : bConnected;
 								this->end[1] = &this->tree[1] == b ? bConnected : aConnected;
@@ -163,14 +161,14 @@ namespace rl
 					}
 					else
 					{
-						if (get(*a, aNearest.second)->radius < ::std::numeric_limits<::rl::math::Real>::max())
+						if (this->getRadius(*a, aNearest.second) < ::std::numeric_limits<::rl::math::Real>::max())
 						{
-							get(*a, aNearest.second)->radius *= (1 - this->alpha);
-							get(*a, aNearest.second)->radius = ::std::max(this->lower, get(*a, aNearest.second)->radius);
+							this->getRadius(*a, aNearest.second) *= (1 - this->alpha);
+							this->getRadius(*a, aNearest.second) = ::std::max(this->lower, this->getRadius(*a, aNearest.second));
 						}
 						else
 						{
-							get(*a, aNearest.second)->radius = this->radius;
+							this->getRadius(*a, aNearest.second) = this->radius;
 						}
 					}
 					
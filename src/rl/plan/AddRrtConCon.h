@@ -58,6 +58,8 @@ namespace rl
 			
 			::rl::math::Real getRadius() const;
 			
+			void reset();
+			
 			void setAlpha(const ::rl::math::Real& alpha);
 			
 			void setLower(const ::rl::math::Real& lower);
@@ -76,14 +78,12 @@ namespace rl
 			::rl::math::Real radius;
 			
 		protected:
-			struct VertexBundle : Rrt::VertexBundle
-			{
-				::rl::math::Real radius;
-			};
+			Vertex addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q);
 			
-			Vertex addVertex(Tree& tree, const VectorPtr& q);
+			::rl::math::Real& getRadius(const Tree& tree, const Vertex& v);
 			
-			static VertexBundle* get(const Tree& tree, const Vertex& v);
+			/** Vertex radii of each tree, indexed by vertex index. */
+			::std::vector<::std::vector<::rl::math::Real>> radii;
 			
 		private:
 			
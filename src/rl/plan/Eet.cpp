@@ -76,19 +76,6 @@ namespace rl
 		{
 		}
 		
-		Rrt::Edge
-		Eet::addEdge(const Vertex& u, const Vertex& v, Tree& tree)
-		{
-			Edge e = ::boost::add_edge(u, v, tree).first;
-			
-			if (nullptr != this->getViewer())
-			{
-				this->getViewer()->drawConfigurationEdge(*get(tree, u)->q, *get(tree, v)->q);
-			}
-			
-			return e;
-		}
-		
 		void
 		Eet::addExplorer(WorkspaceSphereExplorer* explorer)
 		{
@@ -102,18 +89,20 @@ namespace rl
 		}
 		
 		Eet::Vertex
-		Eet::addVertex(Tree& tree, const VectorPtr& q)
+		Eet::addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q)
 		{
-			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
-			bundle->index = ::boost::num_vertices(tree) - 1;
-			bundle->q = q;
-			
-			Vertex v = ::boost::add_vertex(tree);
-			tree[v] = bundle;
+			return this->addVertex(tree, q, ::rl::math::Transform::Identity());
+		}
+		
+		Eet::Vertex
+		Eet::addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q, const ::rl::math::Transform& t)
+		{
+			Vertex v = tree.add(q);
+			this->transforms.push_back(t);
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfigurationVertex(*get(tree, v)->q);
+				this->getViewer()->drawConfigurationVertex(get(tree, v)->q);
 			}
 			
 			return v;
@@ -134,28 +123,26 @@ namespace rl
 		Rrt::Vertex
 		Eet::connect(Tree& tree, const Neighbor& nearest, const ::rl::math::Transform& chosen)
 		{
-			::rl::math::Real distance = this->distance(*get(tree, nearest.second)->t, chosen);
+			::rl::math::Real distance = this->distance(this->getTransform(nearest.second), chosen);
 			
 			Vertex connected = nullptr;
 			Vertex n = nearest.second;
 			int state = 1;
 			
+			::rl::math::Vector q(this->getModel()->getDofPosition());
+			::rl::math::Transform t;
+			
 			do
 			{
-				VertexBundle best;
-				best.q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
-				best.t = ::std::make_shared<::rl::math::Transform>();
-				
-				state = this->expand(get(tree, n), *get(tree, nearest.second)->t, chosen, distance, best); // TODO
+				state = this->expand(n, this->getTransform(nearest.second), chosen, distance, q, t); // TODO
 				
 				if (state >= 0)
 				{
-					connected = this->addVertex(tree, best.q);
-					get(tree, connected)->t = best.t;
+					connected = this->addVertex(tree, q, t);
 					this->addEdge(n, connected, tree);
 					n = connected;
 					
-					::rl::math::Real distance2 = this->distance(*get(tree, n)->t, chosen);
+					::rl::math::Real distance2 = this->distance(this->getTransform(n), chosen);
 					
 					if (distance2 > distance)
 					{
@@ -173,7 +160,7 @@ namespace rl
 			
 			if (nullptr != connected)
 			{
-				this->nn.push(WorkspaceMetric::Value(get(tree, connected)->t.get(), connected));
+				this->nn.push(WorkspaceMetric::Value(&this->getTransform(connected), connected));
 			}
 			
 			return connected;
@@ -194,13 +181,14 @@ namespace rl
 		}
 		
 		int
-		Eet::expand(const VertexBundle* nearest, const ::rl::math::Transform& nearest2, const ::rl::math::Transform& chosen, const ::rl::math::Real& distance, VertexBundle& expanded)
+		Eet::expand(const Vertex& nearest, const ::rl::math::Transform& nearest2, const ::rl::math::Transform& chosen, const ::rl::math::Real& distance, ::rl::math::Vector& q, ::rl::math::Transform& t)
 		{
 			int state = 1;
 			
 			::rl::math::Vector6 tdot = nearest2.toDelta(chosen, true);
+			::rl::math::Vector q0 = nearest->q;
 			
-			this->getModel()->setPosition(*nearest->q);
+			this->getModel()->setPosition(q0);
 			this->getModel()->updateFrames();
 			this->getModel()->updateJacobian();
 			this->getModel()->updateJacobianInverse();
@@ -222,31 +210,31 @@ namespace rl
 				qdot *= this->getDelta();
 			}
 			
-			this->getModel()->step(*nearest->q, qdot, *expanded.q);
+			this->getModel()->step(q0, qdot, q);
 			
 			if (this->getModel()->getManipulabilityMeasure() < static_cast<::rl::math::Real>(1.0e-3)) // within singularity
 			{
-				*expanded.q = this->getSampler()->generate(); // uniform sampling for singularities
-				::rl::math::Real tmp = this->getModel()->distance(*nearest->q, *expanded.q);
-				this->getModel()->interpolate(*nearest->q, *expanded.q, this->getDelta() / tmp, *expanded.q);
+				q = this->getSampler()->generate(); // uniform sampling for singularities
+				::rl::math::Real tmp = this->getModel()->distance(q0, q);
+				this->getModel()->interpolate(q0, q, this->getDelta() / tmp, q);
 			}
 			
-			if (!this->getModel()->isValid(*expanded.q))
+			if (!this->getModel()->isValid(q))
 			{
 				return -1;
 			}
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfiguration(*expanded.q);
+				this->getViewer()->drawConfiguration(q);
 			}
 			
-			if (this->getModel()->isColliding(*expanded.q))
+			if (this->getModel()->isColliding(q))
 			{
 				return -1;
 			}
 			
-			*expanded.t = this->getModel()->forwardPosition();
+			t = this->getModel()->forwardPosition();
 			
 			return state;
 		}
@@ -254,18 +242,16 @@ namespace rl
 		Rrt::Vertex
 		Eet::extend(Tree& tree, const Neighbor& nearest, const ::rl::math::Transform& chosen)
 		{
-			::rl::math::Real distance = this->distance(*get(tree, nearest.second)->t, chosen);
+			::rl::math::Real distance = this->distance(this->getTransform(nearest.second), chosen);
 			
 			Vertex extended = nullptr;
 			
-			VertexBundle best;
-			best.q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
-			best.t = ::std::make_shared<::rl::math::Transform>();
+			::rl::math::Vector q(this->getModel()->getDofPosition());
+			::rl::math::Transform t;
 			
-			if (this->expand(get(tree, nearest.second), *get(tree, nearest.second)->t, chosen, distance, best) >= 0)
+			if (this->expand(nearest.second, this->getTransform(nearest.second), chosen, distance, q, t) >= 0)
 			{
-				extended = this->addVertex(tree, best.q);
-				get(tree, extended)->t = best.t;
+				extended = this->addVertex(tree, q, t);
 				this->addEdge(nearest.second, extended, tree);
 			}
 			
@@ -278,10 +264,10 @@ namespace rl
 			return this->gaussDistribution(this->gaussEngine);
 		}
 		
-		Eet::VertexBundle*
-		Eet::get(const Tree& tree, const Vertex& v)
+		::rl::math::Transform&
+		Eet::getTransform(const Vertex& v)
 		{
-			return static_cast<VertexBundle*>(tree[v].get());
+			return this->transforms[v->index];
 		}
 		
 		::rl::math::Real
@@ -384,7 +370,7 @@ namespace rl
 		Eet::nearest(const Tree& tree, const ::rl::math::Transform& chosen)
 		{
 			::std::vector<::rl::math::GnatNearestNeighbors<WorkspaceMetric>::Neighbor> neighbors = this->nn.nearest(WorkspaceMetric::Value(&chosen, Vertex()), 1);
-			return Neighbor(neighbors.front().first, neighbors.front().second.second);
+			return Neighbor(neighbors.front().first, static_cast<Vertex>(neighbors.front().second.second));
 		}
 		
 		::std::uniform_real_distribution<::rl::math::Real>::result_type
@@ -404,6 +390,7 @@ namespace rl
 			}
 			
 			this->nn.clear();
+			this->transforms.clear();
 		}
 		
 		void
@@ -546,11 +533,10 @@ namespace rl
 			
 			// tree initialization with start configuration
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
 			this->getModel()->setPosition(*this->getStart());
 			this->getModel()->updateFrames();
-			get(this->tree[0], this->begin[0])->t = ::std::make_shared<::rl::math::Transform>(this->getModel()->forwardPosition());
-			this->nn.push(WorkspaceMetric::Value(get(this->tree[0], this->begin[0])->t.get(), begin[0]));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart(), this->getModel()->forwardPosition());
+			this->nn.push(WorkspaceMetric::Value(&this->getTransform(this->begin[0]), this->begin[0]));
 			
 			::rl::math::Transform chosen;
 			chosen.setIdentity();
@@ -599,7 +585,7 @@ namespace rl
 							
 							chosen.linear() = ::rl::math::Quaternion::Random(
 								::rl::math::Vector3(this->gauss(), this->gauss(), this->gauss()),
-								::rl::math::Quaternion((*get(this->tree[0], nearest.second)->t).linear()),
+								::rl::math::Quaternion(this->getTransform(nearest.second).linear()),
 								::rl::math::Vector3::Constant(sigma / this->beta)
 							).toRotationMatrix();
 						}
@@ -616,7 +602,7 @@ namespace rl
 					{
 						if (this->goalEpsilonUseOrientation)
 						{
-							if (this->distance(*get(this->tree[0], connected)->t, goal) < this->goalEpsilon)
+							if (this->distance(this->getTransform(connected), goal) < this->goalEpsilon)
 							{
 								this->end[0] = connected;
 								return true;
@@ -624,7 +610,7 @@ namespace rl
 						}
 						else
 						{
-							if ((get(this->tree[0], connected)->t->translation() - goal.translation()).norm() < this->goalEpsilon)
+							if ((this->getTransform(connected).translation() - goal.translation()).norm() < this->goalEpsilon)
 							{
 								this->end[0] = connected;
 								return true;
@@ -636,7 +622,7 @@ namespace rl
 						
 						for (WorkspaceSphereVector::reverse_iterator k = ++path.rbegin(); k.base() != i; ++k) // search spheres backwards
 						{
-							if (((*get(this->tree[0], connected)->t).translation() - *k->center).norm() < k->radius) // position is within sphere
+							if ((this->getTransform(connected).translation() - *k->center).norm() < k->radius) // position is within sphere
 							{
 								i = k.base(); // advance to matching sphere
 								sigma = gamma; // reset exploration/exploitation balance
@@ -31,7 +31,6 @@
 #include <rl/math/GnatNearestNeighbors.h>
 
 #include "RrtCon.h"
-#include "TransformPtr.h"
 #include "WorkspaceMetric.h"
 
 namespace rl
@@ -171,14 +170,9 @@ namespace rl
 			::rl::math::Vector3 min;
 			
 		protected:
-			struct VertexBundle : Rrt::VertexBundle
-			{
-				TransformPtr t;
-			};
+			Vertex addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q);
 			
-			Edge addEdge(const Vertex& u, const Vertex& v, Tree& tree);
-			
-			Vertex addVertex(Tree& tree, const VectorPtr& q);
+			Vertex addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q, const ::rl::math::Transform& t);
 			
 			using RrtCon::connect;
 			
@@ -186,7 +180,7 @@ namespace rl
 			
 			::rl::math::Real distance(const ::rl::math::Transform& t1, const ::rl::math::Transform& t2) const;
 			
-			int expand(const VertexBundle* nearest, const ::rl::math::Transform& nearest2, const ::rl::math::Transform& chosen, const ::rl::math::Real& distance, VertexBundle& expanded);
+			int expand(const Vertex& nearest, const ::rl::math::Transform& nearest2, const ::rl::math::Transform& chosen, const ::rl::math::Real& distance, ::rl::math::Vector& q, ::rl::math::Transform& t);
 			
 			using RrtCon::extend;
 			
@@ -194,7 +188,7 @@ namespace rl
 			
 			::std::normal_distribution<::rl::math::Real>::result_type gauss();
 			
-			static VertexBundle* get(const Tree& tree, const Vertex& v);
+			::rl::math::Transform& getTransform(const Vertex& v);
 			
 			using RrtCon::nearest;
 			
@@ -210,6 +204,9 @@ namespace rl
 			
 			::std::mt19937 randEngine;
 			
+			/** Frame transforms of tree vertices, indexed by vertex index. */
+			::std::deque<::rl::math::Transform, ::Eigen::aligned_allocator<::rl::math::Transform>> transforms;
+			
 		private:
 			::std::chrono::steady_clock::time_point explorationTimeStart;
 			
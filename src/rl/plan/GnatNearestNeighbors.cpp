@@ -83,6 +83,15 @@ namespace rl
 			return this->container.getNodeDegreeMin();
 		}
 		
+		void
+		GnatNearestNeighbors::insert(const ::std::vector<NearestNeighbors::Value>& values)
+		{
+			if (!values.empty())
+			{
+				this->container.insert(values.begin(), values.end());
+			}
+		}
+		
 		::std::vector<NearestNeighbors::Neighbor>
 		GnatNearestNeighbors::nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted) const
 		{
@@ -65,6 +65,17 @@ namespace rl
 			return this->container.getSamples();
 		}
 		
+		void
+		KdtreeNearestNeighbors::insert(const ::std::vector<NearestNeighbors::Value>& values)
+		{
+			if (!values.empty())
+			{
+				// values are partitioned in place while building the tree
+				::std::vector<NearestNeighbors::Value> data(values);
+				this->container.insert(data.begin(), data.end());
+			}
+		}
+		
 		::std::vector<NearestNeighbors::Neighbor>
 		KdtreeNearestNeighbors::nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted) const
 		{
@@ -52,6 +52,8 @@ namespace rl
 			
 			::std::size_t getSamples() const;
 			
+			void insert(const ::std::vector<NearestNeighbors::Value>& values);
+			
 			::std::vector<NearestNeighbors::Neighbor> nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted = true) const;
 			
 			void push(const NearestNeighbors::Value& value);
@@ -53,6 +53,15 @@ namespace rl
 			return this->container.empty();
 		}
 		
+		void
+		LinearNearestNeighbors::insert(const ::std::vector<NearestNeighbors::Value>& values)
+		{
+			if (!values.empty())
+			{
+				this->container.insert(values.begin(), values.end());
+			}
+		}
+		
 		::std::vector<NearestNeighbors::Neighbor>
 		LinearNearestNeighbors::nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted) const
 		{
@@ -48,6 +48,8 @@ namespace rl
 			
 			bool empty() const;
 			
+			void insert(const ::std::vector<NearestNeighbors::Value>& values);
+			
 			::std::vector<NearestNeighbors::Neighbor> nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted = true) const;
 			
 			::std::vector<NearestNeighbors::Neighbor> radius(const Value& query, const Distance& radius, const bool& sorted = true) const;
@@ -24,6 +24,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <cmath>
+
 #include "Metric.h"
 #include "Model.h"
 
@@ -33,8 +35,15 @@ namespace rl
 	{
 		Metric::Metric(Model* model, const bool& transformed) :
 			model(model),
-			transformed(transformed)
+			periods(),
+			transformed(transformed),
+			weighted(false),
+			weights()
 		{
+			if (nullptr != this->model)
+			{
+				this->weighted = this->model->getWeightedMetric(this->weights, this->periods);
+			}
 		}
 		
 		Metric::~Metric()
@@ -44,50 +53,110 @@ namespace rl
 		Metric::Distance
 		Metric::operator()(const Value& lhs, const Value& rhs) const
 		{
+			if (this->weighted)
+			{
+				::rl::math::Real d = this->weightedDistance(lhs.first, rhs.first);
+				return this->transformed ? d : this->model->inverseOfTransformedDistance(d);
+			}
+			
+			::Eigen::Map<const ::rl::math::Vector> q1(lhs.first, lhs.dof);
+			::Eigen::Map<const ::rl::math::Vector> q2(rhs.first, rhs.dof);
+			
 			if (this->transformed)
 			{
-				return this->model->transformedDistance(*lhs.first, *rhs.first);
+				return this->model->transformedDistance(q1, q2);
 			}
 			else
 			{
-				return this->model->distance(*lhs.first, *rhs.first);
+				return this->model->distance(q1, q2);
 			}
 		}
 		
 		Metric::Distance
 		Metric::operator()(const Distance& lhs, const Distance& rhs, const ::std::size_t& index) const
 		{
+			if (this->weighted)
+			{
+				::rl::math::Real delta = ::std::abs(lhs - rhs);
+				
+				if (::std::isfinite(this->periods(index)))
+				{
+					delta = ::std::max(delta, ::std::abs(this->periods(index) - delta));
+				}
+				
+				return this->weights(index) * delta * delta;
+			}
+			
 			return this->model->transformedDistance(lhs, rhs, index);
 		}
 		
+		void
+		Metric::operator()(const Value& query, const Value* first, const Value* last, Distance* distances) const
+		{
+			if (this->weighted && this->transformed)
+			{
+				for (; first != last; ++first, ++distances)
+				{
+					*distances = this->weightedDistance(query.first, first->first);
+				}
+			}
+			else
+			{
+				for (; first != last; ++first, ++distances)
+				{
+					*distances = (*this)(query, *first);
+				}
+			}
+		}
+		
+		::rl::math::Real
+		Metric::weightedDistance(const ::rl::math::Real* q1, const ::rl::math::Real* q2) const
+		{
+			::Eigen::Map<const ::rl::math::Vector> a(q1, this->weights.size());
+			::Eigen::Map<const ::rl::math::Vector> b(q2, this->weights.size());
+			
+			return (
+				this->weights.array() * (a - b).array().abs().min((this->periods.array() - (a - b).array().abs()).abs()).square()
+			).sum();
+		}
+		
 		Metric::Value::Value() :
 			first(),
-			second()
+			second(),
+			dof()
 		{
 		}
 		
-		Metric::Value::Value(const ::rl::math::Vector* first, void* second) :
+		Metric::Value::Value(const ::rl::math::Real* first, const ::std::size_t& dof, void* second) :
 			first(first),
-			second(second)
+			second(second),
+			dof(dof)
+		{
+		}
+		
+		Metric::Value::Value(const ::rl::math::Vector* first, void* second) :
+			first(first->data()),
+			second(second),
+			dof(first->size())
 		{
 		}
 		
 		const ::rl::math::Real*
 		Metric::Value::begin() const
 		{
-			return this->first->data();
+			return this->first;
 		}
 		
 		const ::rl::math::Real*
 		Metric::Value::end() const
 		{
-			return this->first->data() + this->first->size();
+			return this->first + this->dof;
 		}
 		
 		::std::size_t
 		Metric::Value::size() const
 		{
-			return this->first->size();
+			return this->dof;
 		}
 	}
 }
@@ -50,6 +50,8 @@ namespace rl
 				
 				Value();
 				
+				Value(const ::rl::math::Real* first, const ::std::size_t& dof, void* second);
+				
 				Value(const ::rl::math::Vector* first, void* second);
 				
 				const ::rl::math::Real* begin() const;
@@ -58,9 +60,13 @@ namespace rl
 				
 				::std::size_t size() const;
 				
-				const ::rl::math::Vector* first;
+				/** First coordinate of the configuration. */
+				const ::rl::math::Real* first;
 				
 				void* second;
+				
+				/** Number of coordinates of the configuration. */
+				::std::size_t dof;
 			};
 			
 			Metric(Model* model, const bool& transformed);
@@ -71,12 +77,30 @@ namespace rl
 			
 			Distance operator()(const Distance& lhs, const Distance& rhs, const ::std::size_t& index) const;
 			
+			/**
+			 * Distances of query to all values in [first, last).
+			 *
+			 * @param[out] distances One distance per value
+			 */
+			void operator()(const Value& query, const Value* first, const Value* last, Distance* distances) const;
+			
 		protected:
 			
 		private:
+			::rl::math::Real weightedDistance(const ::rl::math::Real* q1, const ::rl::math::Real* q2) const;
+			
 			Model* model;
 			
+			/** Periods of coordinates of the weighted metric, infinite without wraparound. */
+			::rl::math::Vector periods;
+			
 			bool transformed;
+			
+			/** Model metric is available as weighted metric. */
+			bool weighted;
+			
+			/** Weights of coordinates of the weighted metric. */
+			::rl::math::Vector weights;
 		};
 	}
 }
@@ -24,6 +24,10 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <limits>
+#include <rl/mdl/Helical.h>
+#include <rl/mdl/Prismatic.h>
+#include <rl/mdl/Revolute.h>
 #include <rl/sg/Body.h>
 
 #include "Model.h"
@@ -71,7 +75,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Model::distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Model::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			if (nullptr != this->kin)
 			{
@@ -328,6 +332,49 @@ namespace rl
 			}
 		}
 		
+		bool
+		Model::getWeightedMetric(::rl::math::Vector& weights, ::rl::math::Vector& periods) const
+		{
+			if (nullptr == this->kin && nullptr == this->mdl)
+			{
+				return false;
+			}
+			
+			if (nullptr != this->mdl)
+			{
+				for (::std::size_t i = 0; i < this->mdl->getJoints(); ++i)
+				{
+					::rl::mdl::Joint* joint = this->mdl->getJoint(i);
+					
+					if (nullptr == dynamic_cast<::rl::mdl::Revolute*>(joint) && nullptr == dynamic_cast<::rl::mdl::Prismatic*>(joint) && nullptr == dynamic_cast<::rl::mdl::Helical*>(joint))
+					{
+						return false;
+					}
+				}
+			}
+			
+			::rl::math::Vector maximum = this->getMaximum();
+			::rl::math::Vector minimum = this->getMinimum();
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> wraparounds = this->getWraparounds();
+			
+			weights = ::rl::math::Vector::Ones(this->getDofPosition());
+			periods.resize(this->getDofPosition());
+			
+			for (::std::size_t i = 0; i < this->getDofPosition(); ++i)
+			{
+				if (wraparounds(i) && (nullptr != this->kin || nullptr != dynamic_cast<::rl::mdl::Revolute*>(this->mdl->getJoint(i))))
+				{
+					periods(i) = ::std::abs(maximum(i) - minimum(i));
+				}
+				else
+				{
+					periods(i) = ::std::numeric_limits<::rl::math::Real>::infinity();
+				}
+			}
+			
+			return true;
+		}
+		
 		::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>
 		Model::getWraparounds() const
 		{
@@ -487,7 +534,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Model::transformedDistance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Model::transformedDistance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			if (nullptr != this->kin)
 			{
@@ -50,7 +50,7 @@ namespace rl
 			
 			virtual void clamp(::rl::math::Vector& q) const;
 			
-			virtual ::rl::math::Real distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const;
+			virtual ::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			virtual void forwardForce(const ::rl::math::Vector& tau, ::rl::math::Vector& f) const;
 			
@@ -92,6 +92,17 @@ namespace rl
 			
 			virtual ::Eigen::Matrix<::rl::math::Units, ::Eigen::Dynamic, 1> getPositionUnits() const;
 			
+			/**
+			 * Get the distance metric as a weighted Euclidean metric.
+			 *
+			 * The transformed distance is then the sum of weights(i) * min(d, |periods(i) - d|)^2
+			 * over all coordinates, with d the absolute coordinate difference. Coordinates
+			 * without wraparound have an infinite period.
+			 *
+			 * @return false if the metric of the model is not of this form
+			 */
+			virtual bool getWeightedMetric(::rl::math::Vector& weights, ::rl::math::Vector& periods) const;
+			
 			virtual ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> getWraparounds() const;
 			
 			virtual void inverseForce(const ::rl::math::Vector& f, ::rl::math::Vector& tau) const;
@@ -118,7 +129,7 @@ namespace rl
 			
 			virtual ::rl::math::Real transformedDistance(const ::rl::math::Real& d) const;
 			
-			virtual ::rl::math::Real transformedDistance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const;
+			virtual ::rl::math::Real transformedDistance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			virtual ::rl::math::Real transformedDistance(const ::rl::math::Real& q1, const ::rl::math::Real& q2, const ::std::size_t& i) const;
 			
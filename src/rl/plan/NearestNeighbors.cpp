@@ -39,6 +39,15 @@ namespace rl
 		{
 		}
 		
+		void
+		NearestNeighbors::insert(const ::std::vector<Value>& values)
+		{
+			for (::std::size_t i = 0; i < values.size(); ++i)
+			{
+				this->push(values[i]);
+			}
+		}
+		
 		bool
 		NearestNeighbors::isTransformedDistance() const
 		{
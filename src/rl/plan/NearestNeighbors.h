@@ -57,6 +57,14 @@ namespace rl
 			
 			bool isTransformedDistance() const;
 			
+			/**
+			 * Insert several values at once.
+			 *
+			 * Implementations build a balanced structure when empty, which is
+			 * faster than pushing the values one by one.
+			 */
+			virtual void insert(const ::std::vector<Value>& values);
+			
 			virtual ::std::vector<Neighbor> nearest(const Value& query, const ::std::size_t& k, const bool& sorted = true) const = 0;
 			
 			virtual void push(const Value& value) = 0;
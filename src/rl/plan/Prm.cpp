@@ -24,10 +24,19 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/incremental_components.hpp>
+#include <rl/util/ThreadPool.h>
 
 #include "BridgeSampler.h"
+#include "Exception.h"
 #include "GaussianSampler.h"
 #include "Prm.h"
 #include "Sampler.h"
@@ -40,21 +49,77 @@ namespace rl
 {
 	namespace plan
 	{
+		namespace
+		{
+			const char magic[8] = {'r', 'l', 'p', 'l', 'p', 'r', 'm', '1'};
+			
+			/**
+			 * Calls function for indices 0 to n - 1 in one thread per worker,
+			 * indices are handed out in increasing order.
+			 */
+			void
+			parallelFor(::rl::util::ThreadPool& pool, const ::std::size_t& n, const ::std::function<void(const ::std::size_t&, const ::std::size_t&)>& function)
+			{
+				::std::atomic<::std::size_t> next(0);
+				
+				pool.run(pool.size(), [&](const ::std::size_t& i) {
+					try
+					{
+						for (::std::size_t j = next++; j < n; j = next++)
+						{
+							function(i, j);
+						}
+					}
+					catch (...)
+					{
+						next = n;
+						throw;
+					}
+				});
+			}
+			
+			template<typename T>
+			T
+			readValue(::std::istream& stream)
+			{
+				T value;
+				stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+				
+				if (!stream)
+				{
+					throw Exception("rl::plan::Prm::load() - Unexpected end of file");
+				}
+				
+				return value;
+			}
+			
+			template<typename T>
+			void
+			writeValue(::std::ostream& stream, const T& value)
+			{
+				stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+			}
+		}
+		
 		Prm::Prm() :
 			Planner(),
 			astar(true),
 			degree(::std::numeric_limits<::std::size_t>::max()),
 			k(30),
+			lazy(false),
 			radius(::std::numeric_limits<::rl::math::Real>::max()),
 			sampler(nullptr),
+			samplers(),
 			verifier(nullptr),
+			verifiers(),
 			begin(nullptr),
 			ds(
 				::boost::get(&VertexBundle::rank, graph),
 				::boost::get(&VertexBundle::parent, graph)
 			),
 			end(nullptr),
-			graph()
+			graph(),
+			pool()
 		{
 		}
 		
@@ -66,6 +131,7 @@ namespace rl
 		Prm::addEdge(const Vertex& u, const Vertex& v, const ::rl::math::Real& weight)
 		{
 			Edge e = ::boost::add_edge(u, v, this->graph).first;
+			this->graph[e].verified = !this->lazy;
 			this->graph[e].weight = weight;
 			
 			this->ds.union_set(u, v);
@@ -94,9 +160,25 @@ namespace rl
 			return v;
 		}
 		
+		void
+		Prm::connectQuery()
+		{
+			this->begin = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->getStart()));
+			this->insert(this->begin);
+			
+			this->end = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->insert(this->end);
+		}
+		
 		void
 		Prm::construct(const ::std::size_t& steps)
 		{
+			if (this->samplers.size() > 1 && !this->lazy)
+			{
+				this->constructParallel(steps);
+				return;
+			}
+			
 			for (::std::size_t i = 0; i < steps; ++i)
 			{
 				VectorPtr q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
@@ -106,6 +188,178 @@ namespace rl
 			}
 		}
 		
+		void
+		Prm::constructParallel(const ::std::size_t& steps)
+		{
+			struct Candidate
+			{
+				bool colliding;
+				
+				::rl::math::Real distance;
+				
+				bool tried;
+				
+				Vertex u;
+				
+				Vertex v;
+			};
+			
+			::std::size_t workers = this->samplers.size();
+			::std::size_t chunk = 16 * workers;
+			
+			if (nullptr == this->pool || this->pool->size() != workers)
+			{
+				this->pool.reset(new ::rl::util::ThreadPool(workers));
+			}
+			
+			::std::vector<VectorPtr> q;
+			::std::vector<::std::vector<Candidate>> candidates;
+			::std::vector<Candidate*> batch;
+			::std::unordered_map<Vertex, Vertex> roots;
+			
+			for (::std::size_t step = 0; step < steps; step += chunk)
+			{
+				::std::size_t n = ::std::min(chunk, steps - step);
+				
+				// every worker draws a fixed share of samples from its own sampler
+				
+				q.resize(n);
+				
+				parallelFor(*this->pool, workers, [&](const ::std::size_t&, const ::std::size_t& i) {
+					for (::std::size_t j = i; j < n; j += workers)
+					{
+						q[j] = ::std::make_shared<::rl::math::Vector>(this->samplers[i]->generateCollisionFree());
+					}
+				});
+				
+				candidates.resize(n);
+				
+				for (::std::size_t i = 0; i < n; ++i)
+				{
+					Vertex v = this->addVertex(q[i]);
+					
+					::std::vector<Neighbor> neighbors = this->graph[::boost::graph_bundle].nn->nearest(Metric::Value(this->graph[v].q.get(), v), this->k);
+					
+					candidates[i].clear();
+					
+					for (::std::size_t j = 0; j < neighbors.size(); ++j)
+					{
+						::rl::math::Real d = this->graph[::boost::graph_bundle].nn->isTransformedDistance() ? this->getModel()->inverseOfTransformedDistance(neighbors[j].first) : neighbors[j].first;
+						
+						if (d < this->radius)
+						{
+							candidates[i].push_back({false, d, false, neighbors[j].second.second, v});
+						}
+					}
+					
+					this->graph[::boost::graph_bundle].nn->push(Metric::Value(this->graph[v].q.get(), v));
+				}
+				
+				// check candidate edges in passes, each pass assumes that all
+				// edges of the previous candidates succeed
+				
+				for (;;)
+				{
+					batch.clear();
+					roots.clear();
+					
+					for (::std::size_t i = 0; i < n; ++i)
+					{
+						for (::std::size_t j = 0; j < candidates[i].size(); ++j)
+						{
+							Candidate& candidate = candidates[i][j];
+							
+							if (candidate.tried)
+							{
+								continue;
+							}
+							
+							if (
+								::boost::degree(candidate.u, this->graph) >= this->degree ||
+								::boost::degree(candidate.v, this->graph) >= this->degree ||
+								::boost::same_component(candidate.u, candidate.v, this->ds)
+							)
+							{
+								candidate.tried = true;
+								continue;
+							}
+							
+							Vertex u = this->ds.find_set(candidate.u);
+							Vertex v = this->ds.find_set(candidate.v);
+							
+							for (::std::unordered_map<Vertex, Vertex>::iterator k = roots.find(u); roots.end() != k; k = roots.find(u))
+							{
+								u = k->second;
+							}
+							
+							for (::std::unordered_map<Vertex, Vertex>::iterator k = roots.find(v); roots.end() != k; k = roots.find(v))
+							{
+								v = k->second;
+							}
+							
+							if (u != v)
+							{
+								roots[u] = v;
+								batch.push_back(&candidate);
+							}
+						}
+					}
+					
+					if (batch.empty())
+					{
+						break;
+					}
+					
+					parallelFor(*this->pool, batch.size(), [&](const ::std::size_t& i, const ::std::size_t& j) {
+						batch[j]->colliding = this->verifiers[i]->isColliding(*this->graph[batch[j]->u].q, *this->graph[batch[j]->v].q, batch[j]->distance);
+					});
+					
+					for (::std::size_t i = 0; i < batch.size(); ++i)
+					{
+						batch[i]->tried = true;
+						
+						if (
+							!batch[i]->colliding &&
+							::boost::degree(batch[i]->u, this->graph) < this->degree &&
+							::boost::degree(batch[i]->v, this->graph) < this->degree &&
+							!::boost::same_component(batch[i]->u, batch[i]->v, this->ds)
+						)
+						{
+							this->addEdge(batch[i]->u, batch[i]->v, batch[i]->distance);
+						}
+					}
+				}
+			}
+		}
+		
+		bool
+		Prm::findPath()
+		{
+			while (::boost::same_component(this->begin, this->end, this->ds))
+			{
+				if (!this->lazy)
+				{
+					return this->search();
+				}
+				
+				if (this->search() && this->verifyPath())
+				{
+					return true;
+				}
+				
+				::boost::initialize_incremental_components(this->graph, this->ds);
+				::boost::incremental_components(this->graph, this->ds);
+			}
+			
+			return false;
+		}
+		
+		Prm::Evaluation
+		Prm::getEvaluation() const
+		{
+			return this->lazy ? Evaluation::lazy : Evaluation::eager;
+		}
+		
 		::std::size_t
 		Prm::getMaxDegree() const
 		{
@@ -160,6 +414,12 @@ namespace rl
 			return ::boost::num_vertices(this->graph);
 		}
 		
+		::std::size_t
+		Prm::getNumWorkers() const
+		{
+			return this->samplers.size();
+		}
+		
 		VectorList
 		Prm::getPath()
 		{
@@ -211,7 +471,11 @@ namespace rl
 					
 					if (d < this->radius)
 					{
-						if (!::boost::same_component(u, v, this->ds))
+						if (this->lazy)
+						{
+							this->addEdge(u, v, d);
+						}
+						else if (!::boost::same_component(u, v, this->ds))
 						{
 							if (!this->verifier->isColliding(*this->graph[u].q, *this->graph[v].q, d))
 							{
@@ -225,6 +489,190 @@ namespace rl
 			this->graph[::boost::graph_bundle].nn->push(Metric::Value(this->graph[v].q.get(), v));
 		}
 		
+		void
+		Prm::invalidate()
+		{
+			::std::vector<Vertex> vertices;
+			VertexIteratorPair vertexIteratorPair = ::boost::vertices(this->graph);
+			
+			for (VertexIterator i = vertexIteratorPair.first; i != vertexIteratorPair.second; ++i)
+			{
+				if (this->getModel()->isColliding(*this->graph[*i].q))
+				{
+					vertices.push_back(*i);
+				}
+			}
+			
+			for (::std::size_t i = 0; i < vertices.size(); ++i)
+			{
+				::boost::clear_vertex(vertices[i], this->graph);
+				::boost::remove_vertex(vertices[i], this->graph);
+			}
+			
+			::std::vector<Edge> edges;
+			EdgeIteratorPair edgeIteratorPair = ::boost::edges(this->graph);
+			
+			for (EdgeIterator i = edgeIteratorPair.first; i != edgeIteratorPair.second; ++i)
+			{
+				if (this->lazy)
+				{
+					this->graph[*i].verified = false;
+				}
+				else if (this->verifier->isColliding(*this->graph[::boost::source(*i, this->graph)].q, *this->graph[::boost::target(*i, this->graph)].q, this->graph[*i].weight))
+				{
+					edges.push_back(*i);
+				}
+			}
+			
+			for (::std::size_t i = 0; i < edges.size(); ++i)
+			{
+				::boost::remove_edge(edges[i], this->graph);
+			}
+			
+			this->begin = nullptr;
+			this->end = nullptr;
+			
+			this->rebuild();
+		}
+		
+		void
+		Prm::load(const ::std::string& filename)
+		{
+			struct EdgeData
+			{
+				::std::uint64_t u;
+				
+				::std::uint64_t v;
+				
+				::rl::math::Real weight;
+				
+				bool verified;
+			};
+			
+			::std::ifstream file(filename.c_str(), ::std::ios::binary);
+			
+			if (!file)
+			{
+				throw Exception("rl::plan::Prm::load() - Could not read file " + filename);
+			}
+			
+			char header[sizeof(magic)];
+			file.read(header, sizeof(header));
+			
+			if (!file || 0 != ::std::memcmp(header, magic, sizeof(magic)))
+			{
+				throw Exception("rl::plan::Prm::load() - Invalid roadmap file " + filename);
+			}
+			
+			::std::size_t dof = this->getModel()->getDofPosition();
+			
+			if (readValue<::std::uint64_t>(file) != dof)
+			{
+				throw Exception("rl::plan::Prm::load() - Degrees of freedom of roadmap and model differ");
+			}
+			
+			::std::uint64_t numVertices = readValue<::std::uint64_t>(file);
+			::std::vector<VectorPtr> q;
+			::std::vector<::std::uint64_t> components;
+			
+			for (::std::uint64_t i = 0; i < numVertices; ++i)
+			{
+				q.push_back(::std::make_shared<::rl::math::Vector>(dof));
+				
+				for (::std::size_t j = 0; j < dof; ++j)
+				{
+					(*q.back())(j) = static_cast<::rl::math::Real>(readValue<double>(file));
+				}
+				
+				components.push_back(readValue<::std::uint64_t>(file));
+				
+				if (components.back() >= numVertices)
+				{
+					throw Exception("rl::plan::Prm::load() - Invalid component");
+				}
+			}
+			
+			::std::uint64_t numEdges = readValue<::std::uint64_t>(file);
+			::std::vector<EdgeData> edges;
+			
+			for (::std::uint64_t i = 0; i < numEdges; ++i)
+			{
+				EdgeData edge;
+				edge.u = readValue<::std::uint64_t>(file);
+				edge.v = readValue<::std::uint64_t>(file);
+				edge.weight = static_cast<::rl::math::Real>(readValue<double>(file));
+				edge.verified = 0 != readValue<::std::uint8_t>(file);
+				
+				if (edge.u >= numVertices || edge.v >= numVertices)
+				{
+					throw Exception("rl::plan::Prm::load() - Invalid edge");
+				}
+				
+				edges.push_back(edge);
+			}
+			
+			this->reset();
+			
+			::std::vector<Vertex> vertices;
+			vertices.reserve(q.size());
+			::std::vector<NearestNeighbors::Value> values;
+			values.reserve(q.size());
+			
+			for (::std::size_t i = 0; i < q.size(); ++i)
+			{
+				vertices.push_back(this->addVertex(q[i]));
+				values.push_back(Metric::Value(q[i].get(), vertices[i]));
+			}
+			
+			for (::std::size_t i = 0; i < vertices.size(); ++i)
+			{
+				this->ds.union_set(vertices[i], vertices[components[i]]);
+			}
+			
+			for (::std::size_t i = 0; i < edges.size(); ++i)
+			{
+				Edge e = ::boost::add_edge(vertices[edges[i].u], vertices[edges[i].v], this->graph).first;
+				this->graph[e].verified = edges[i].verified;
+				this->graph[e].weight = edges[i].weight;
+				
+				if (nullptr != this->getViewer())
+				{
+					this->getViewer()->drawConfigurationEdge(*q[edges[i].u], *q[edges[i].v]);
+				}
+			}
+			
+			this->graph[::boost::graph_bundle].nn->insert(values);
+		}
+		
+		bool
+		Prm::query()
+		{
+			this->connectQuery();
+			return this->findPath();
+		}
+		
+		void
+		Prm::rebuild()
+		{
+			::std::vector<NearestNeighbors::Value> values;
+			values.reserve(::boost::num_vertices(this->graph));
+			
+			::std::size_t index = 0;
+			VertexIteratorPair vertexIteratorPair = ::boost::vertices(this->graph);
+			
+			for (VertexIterator i = vertexIteratorPair.first; i != vertexIteratorPair.second; ++i)
+			{
+				this->graph[*i].index = index++;
+				values.push_back(Metric::Value(this->graph[*i].q.get(), *i));
+			}
+			
+			::boost::initialize_incremental_components(this->graph, this->ds);
+			::boost::incremental_components(this->graph, this->ds);
+			
+			this->graph[::boost::graph_bundle].nn->clear();
+			this->graph[::boost::graph_bundle].nn->insert(values);
+		}
+		
 		void
 		Prm::reset()
 		{
@@ -234,6 +682,51 @@ namespace rl
 			this->end = nullptr;
 		}
 		
+		void
+		Prm::save(const ::std::string& filename)
+		{
+			::std::ofstream file(filename.c_str(), ::std::ios::binary | ::std::ios::trunc);
+			file.write(magic, sizeof(magic));
+			
+			writeValue<::std::uint64_t>(file, this->getModel()->getDofPosition());
+			writeValue<::std::uint64_t>(file, ::boost::num_vertices(this->graph));
+			
+			VertexIteratorPair vertexIteratorPair = ::boost::vertices(this->graph);
+			
+			for (VertexIterator i = vertexIteratorPair.first; i != vertexIteratorPair.second; ++i)
+			{
+				for (::std::ptrdiff_t j = 0; j < this->graph[*i].q->size(); ++j)
+				{
+					writeValue<double>(file, (*this->graph[*i].q)(j));
+				}
+				
+				writeValue<::std::uint64_t>(file, this->graph[this->ds.find_set(*i)].index);
+			}
+			
+			writeValue<::std::uint64_t>(file, ::boost::num_edges(this->graph));
+			
+			EdgeIteratorPair edgeIteratorPair = ::boost::edges(this->graph);
+			
+			for (EdgeIterator i = edgeIteratorPair.first; i != edgeIteratorPair.second; ++i)
+			{
+				writeValue<::std::uint64_t>(file, this->graph[::boost::source(*i, this->graph)].index);
+				writeValue<::std::uint64_t>(file, this->graph[::boost::target(*i, this->graph)].index);
+				writeValue<double>(file, this->graph[*i].weight);
+				writeValue<::std::uint8_t>(file, this->graph[*i].verified ? 1 : 0);
+			}
+			
+			if (!file)
+			{
+				throw Exception("rl::plan::Prm::save() - Could not write file " + filename);
+			}
+		}
+		
+		void
+		Prm::setEvaluation(const Evaluation& evaluation)
+		{
+			this->lazy = Evaluation::lazy == evaluation ? true : false;
+		}
+		
 		void
 		Prm::setMaxDegree(const ::std::size_t& degree)
 		{
@@ -276,27 +769,41 @@ namespace rl
 			this->verifier = verifier;
 		}
 		
+		void
+		Prm::setWorkers(const ::std::vector<Sampler*>& samplers, const ::std::vector<Verifier*>& verifiers)
+		{
+			if (samplers.size() != verifiers.size())
+			{
+				throw Exception("rl::plan::Prm::setWorkers() - Number of samplers and verifiers differ");
+			}
+			
+			this->samplers = samplers;
+			this->verifiers = verifiers;
+		}
+		
 		bool
 		Prm::solve()
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->getStart()));
-			this->insert(this->begin);
+			this->connectQuery();
 			
-			this->end = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->getGoal()));
-			this->insert(this->end);
-			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration() && !::boost::same_component(this->begin, this->end, this->ds))
+			while (!this->findPath())
 			{
-				this->construct(1);
-			}
-			
-			if (!::boost::same_component(this->begin, this->end, this->ds))
-			{
-				return false;
+				if ((::std::chrono::steady_clock::now() - this->time) >= this->getDuration())
+				{
+					return false;
+				}
+				
+				this->construct(this->lazy ? 1 : ::std::max<::std::size_t>(this->samplers.size(), 1));
 			}
 			
+			return true;
+		}
+		
+		bool
+		Prm::search()
+		{
 			if (this->astar)
 			{
 				::boost::astar_search(
@@ -333,7 +840,34 @@ namespace rl
 				);
 			}
 			
-			return true;
+			return this->graph[this->end].distance < ::std::numeric_limits<::rl::math::Real>::max();
+		}
+		
+		bool
+		Prm::verifyPath()
+		{
+			bool valid = true;
+			
+			for (Vertex v = this->end; v != this->begin; v = this->graph[v].predecessor)
+			{
+				Vertex u = this->graph[v].predecessor;
+				Edge e = ::boost::edge(u, v, this->graph).first;
+				
+				if (!this->graph[e].verified)
+				{
+					if (this->verifier->isColliding(*this->graph[u].q, *this->graph[v].q, this->graph[e].weight))
+					{
+						::boost::remove_edge(e, this->graph);
+						valid = false;
+					}
+					else
+					{
+						this->graph[e].verified = true;
+					}
+				}
+			}
+			
+			return valid;
 		}
 		
 		Prm::AStarHeuristic::AStarHeuristic(const Model* model, const Graph& graph, const Vertex& goal) :
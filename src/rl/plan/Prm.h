@@ -30,6 +30,9 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/astar_search.hpp>
 #include <boost/pending/disjoint_sets.hpp>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "Metric.h"
 #include "NearestNeighbors.h"
@@ -38,6 +41,11 @@
 
 namespace rl
 {
+	namespace util
+	{
+		class ThreadPool;
+	}
+	
 	namespace plan
 	{
 		class Model;
@@ -60,10 +68,35 @@ namespace rl
 		 * 12(4):566-580, August 1996.
 		 *
 		 * http://dx.doi.org/10.1109/70.508439
+		 *
+		 * With more than one worker, construct() draws samples and checks
+		 * candidate edges in one thread per worker. The threads are kept
+		 * alive between calls. Vertices, edges and
+		 * connected components are merged in a fixed order by the calling
+		 * thread, so the roadmap only depends on the seeds of the worker
+		 * samplers and on the number of workers.
+		 *
+		 * With lazy evaluation, edges enter the roadmap without collision
+		 * checks. solve() searches the roadmap and only checks the edges of
+		 * the resulting path. Colliding edges are removed, the connected
+		 * components are recomputed and the search is repeated. Edges found
+		 * to be free are not checked again.
+		 *
+		 * Robert Bohlin and Lydia E. Kavraki. Path planning using lazy PRM.
+		 * In Proceedings of the IEEE International Conference on Robotics and
+		 * Automation, pages 521-528, San Francisco, CA, USA, April 2000.
+		 *
+		 * http://dx.doi.org/10.1109/ROBOT.2000.844107
 		 */
 		class RL_PLAN_EXPORT Prm : public Planner
 		{
 		public:
+			enum class Evaluation
+			{
+				eager,
+				lazy
+			};
+			
 			enum class Search
 			{
 				astar,
@@ -76,6 +109,8 @@ namespace rl
 			
 			virtual void construct(const ::std::size_t& steps);
 			
+			Evaluation getEvaluation() const;
+			
 			::std::size_t getMaxDegree() const;
 			
 			::std::size_t getMaxNeighbors() const;
@@ -90,6 +125,8 @@ namespace rl
 			
 			::std::size_t getNumVertices() const;
 			
+			::std::size_t getNumWorkers() const;
+			
 			VectorList getPath();
 			
 			Sampler* getSampler() const;
@@ -98,8 +135,57 @@ namespace rl
 			
 			Verifier* getVerifier() const;
 			
+			/**
+			 * Remove vertices and edges that collide with the current scene.
+			 *
+			 * Call this after adding obstacles to the scene to keep the
+			 * remaining roadmap instead of constructing a new one. Colliding
+			 * vertices are removed together with their edges. With eager
+			 * evaluation, all remaining edges are checked with the verifier.
+			 * With lazy evaluation, they are only marked as unverified and are
+			 * checked once they are part of a path.
+			 */
+			void invalidate();
+			
+			/**
+			 * Load a roadmap saved with save().
+			 *
+			 * Replaces the current roadmap and rebuilds the nearest-neighbor
+			 * index in a single pass.
+			 *
+			 * @throw Exception If the file cannot be read, is not a roadmap,
+			 * or does not match the degrees of freedom of the model
+			 */
+			void load(const ::std::string& filename);
+			
+			/**
+			 * Answer a query on the existing roadmap.
+			 *
+			 * Connects start and goal to the roadmap and searches it without
+			 * sampling new vertices. Start and goal remain part of the roadmap,
+			 * so a roadmap can be constructed once and queried repeatedly.
+			 *
+			 * @return True if a path was found
+			 */
+			bool query();
+			
 			void reset();
 			
+			/**
+			 * Save the roadmap in a binary file.
+			 *
+			 * Stores configurations, connected components, edge weights, and
+			 * whether edges have been verified.
+			 *
+			 * @throw Exception If the file cannot be written
+			 */
+			void save(const ::std::string& filename);
+			
+			/**
+			 * Lazy evaluation always constructs the roadmap sequentially.
+			 */
+			void setEvaluation(const Evaluation& evaluation);
+			
 			void setMaxDegree(const ::std::size_t& degree);
 			
 			void setMaxNeighbors(const ::std::size_t& k);
@@ -114,6 +200,18 @@ namespace rl
 			
 			void setVerifier(Verifier* verifier);
 			
+			/**
+			 * Set samplers and verifiers for parallel construction.
+			 *
+			 * Each sampler and verifier pair must refer to its own model with
+			 * its own kinematics and scene, as they are used concurrently.
+			 * Empty vectors or a single worker revert to sequential
+			 * construction with sampler and verifier.
+			 *
+			 * @throw Exception If the number of samplers and verifiers differ
+			 */
+			void setWorkers(const ::std::vector<Sampler*>& samplers, const ::std::vector<Verifier*>& verifiers);
+			
 			bool solve();
 			
 			bool astar;
@@ -124,16 +222,27 @@ namespace rl
 			/** Maximum number of tested neighbors. */
 			::std::size_t k;
 			
+			bool lazy;
+			
 			/** Maximum radius for connecting neighbors. */
 			::rl::math::Real radius;
 			
 			Sampler* sampler;
 			
+			/** Samplers of parallel workers. */
+			::std::vector<Sampler*> samplers;
+			
 			Verifier* verifier;
 			
+			/** Verifiers of parallel workers. */
+			::std::vector<Verifier*> verifiers;
+			
 		protected:
 			struct EdgeBundle
 			{
+				/** Edge has been checked and is free of collisions. */
+				bool verified;
+				
 				::rl::math::Real weight;
 			};
 			
@@ -216,8 +325,47 @@ namespace rl
 			
 			Vertex addVertex(const VectorPtr& q);
 			
+			/**
+			 * Add start and goal as begin and end of the roadmap.
+			 */
+			void connectQuery();
+			
+			void constructParallel(const ::std::size_t& steps);
+			
+			/**
+			 * Search a path from begin to end in the current roadmap.
+			 *
+			 * With lazy evaluation, colliding edges on found paths are removed
+			 * until a path is free of collisions or begin and end are no longer
+			 * connected.
+			 *
+			 * @return True if a path was found
+			 */
+			bool findPath();
+			
 			void insert(const Vertex& vertex);
 			
+			/**
+			 * Update vertex indices, connected components, and the
+			 * nearest-neighbor index after removing vertices.
+			 */
+			void rebuild();
+			
+			/**
+			 * Search path from begin to end.
+			 *
+			 * @return True if end is reachable
+			 */
+			bool search();
+			
+			/**
+			 * Check unverified edges of the current path and remove all
+			 * colliding ones.
+			 *
+			 * @return True if all edges of the path are free of collisions
+			 */
+			bool verifyPath();
+			
 			Vertex begin;
 			
 			::boost::disjoint_sets<VertexRankMap, VertexParentMap> ds;
@@ -227,7 +375,8 @@ namespace rl
 			Graph graph;
 			
 		private:
-			
+			/** Threads of parallel workers, kept alive between calls. */
+			::std::unique_ptr<::rl::util::ThreadPool> pool;
 		};
 	}
 }
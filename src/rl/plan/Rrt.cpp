@@ -48,41 +48,34 @@ namespace rl
 		{
 		}
 		
-		Rrt::Edge
+		void
 		Rrt::addEdge(const Vertex& u, const Vertex& v, Tree& tree)
 		{
-			Edge e = ::boost::add_edge(u, v, tree).first;
+			tree.setParent(u, v);
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfigurationEdge(*get(tree, u)->q, *get(tree, v)->q);
+				this->getViewer()->drawConfigurationEdge(get(tree, u)->q, get(tree, v)->q);
 			}
-			
-			return e;
 		}
 		
 		Rrt::Vertex
-		Rrt::addVertex(Tree& tree, const VectorPtr& q)
+		Rrt::addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q)
 		{
-			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
-			bundle->index = ::boost::num_vertices(tree) - 1;
-			bundle->q = q;
-			
-			Vertex v = ::boost::add_vertex(tree);
-			tree[v] = bundle;
+			Vertex v = tree.add(q);
 			
-			tree[::boost::graph_bundle].nn->push(Metric::Value(q.get(), v));
+			tree.nn->push(Metric::Value(v->q.data(), v->q.size(), v));
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfigurationVertex(*get(tree, v)->q);
+				this->getViewer()->drawConfigurationVertex(get(tree, v)->q);
 			}
 			
 			return v;
 		}
 		
 		bool
-		Rrt::areEqual(const ::rl::math::Vector& lhs, const ::rl::math::Vector& rhs) const
+		Rrt::areEqual(const ::rl::math::ConstVectorRef& lhs, const ::rl::math::ConstVectorRef& rhs) const
 		{
 			if (this->getModel()->distance(lhs, rhs) > this->epsilon)
 			{
@@ -117,16 +110,17 @@ namespace rl
 				step = this->delta;
 			}
 			
-			VectorPtr last = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
+			::rl::math::Vector q = get(tree, nearest.second)->q;
+			::rl::math::Vector last(this->getModel()->getDofPosition());
 			
-			this->getModel()->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, *last);
+			this->getModel()->interpolate(q, chosen, step / distance, last);
 			
 			if (nullptr != this->getViewer())
 			{
-//				this->getViewer()->drawConfiguration(*last);
+//				this->getViewer()->drawConfiguration(last);
 			}
 			
-			if (this->getModel()->isColliding(*last))
+			if (this->getModel()->isColliding(last))
 			{
 				return nullptr;
 			}
@@ -143,7 +137,7 @@ namespace rl
 					step = distance;
 				}
 				
-				this->getModel()->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, next);
+				this->getModel()->interpolate(q, chosen, step / distance, next);
 				
 				if (nullptr != this->getViewer())
 				{
@@ -155,7 +149,7 @@ namespace rl
 					break;
 				}
 				
-				*last = next;
+				last = next;
 			}
 			
 			Vertex connected = this->addVertex(tree, last);
@@ -169,11 +163,11 @@ namespace rl
 			::rl::math::Real distance = nearest.first;
 			::rl::math::Real step = ::std::min(distance, this->delta);
 			
-			VectorPtr next = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
+			::rl::math::Vector next(this->getModel()->getDofPosition());
 			
-			this->getModel()->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, *next);
+			this->getModel()->interpolate(get(tree, nearest.second)->q, chosen, step / distance, next);
 			
-			if (!this->getModel()->isColliding(*next))
+			if (!this->getModel()->isColliding(next))
 			{
 				Vertex extended = this->addVertex(tree, next);
 				this->addEdge(nearest.second, extended, tree);
@@ -184,9 +178,9 @@ namespace rl
 		}
 		
 		Rrt::VertexBundle*
-		Rrt::get(const Tree& tree, const Vertex& v)
+		Rrt::get(const Tree&, const Vertex& v)
 		{
-			return tree[v].get();
+			return v;
 		}
 		
 		::rl::math::Real
@@ -210,7 +204,7 @@ namespace rl
 		NearestNeighbors*
 		Rrt::getNearestNeighbors(const ::std::size_t& i) const
 		{
-			return this->tree[i][::boost::graph_bundle].nn;
+			return this->tree[i].nn;
 		}
 		
 		::std::size_t
@@ -220,7 +214,7 @@ namespace rl
 			
 			for (::std::size_t i = 0; i < this->tree.size(); ++i)
 			{
-				edges += ::boost::num_edges(this->tree[i]);
+				edges += this->tree[i].getNumEdges();
 			}
 			
 			return edges;
@@ -233,7 +227,7 @@ namespace rl
 			
 			for (::std::size_t i = 0; i < this->tree.size(); ++i)
 			{
-				vertices += ::boost::num_vertices(this->tree[i]);
+				vertices += this->tree[i].getNumVertices();
 			}
 			
 			return vertices;
@@ -246,13 +240,13 @@ namespace rl
 			
 			Vertex i = this->end[0];
 			
-			while (::boost::in_degree(i, this->tree[0]) > 0)
+			while (i->parent != i->index)
 			{
-				path.push_front(*get(this->tree[0], i)->q);
-				i = ::boost::source(*::boost::in_edges(i, this->tree[0]).first, this->tree[0]);
+				path.push_front(get(this->tree[0], i)->q);
+				i = this->tree[0].getParent(i);
 			}
 			
-			path.push_front(*get(this->tree[0], i)->q);
+			path.push_front(get(this->tree[0], i)->q);
 			
 			return path;
 		}
@@ -266,10 +260,10 @@ namespace rl
 		Rrt::Neighbor
 		Rrt::nearest(const Tree& tree, const ::rl::math::Vector& chosen)
 		{
-			::std::vector<NearestNeighbors::Neighbor> neighbors = tree[::boost::graph_bundle].nn->nearest(Metric::Value(&chosen, Vertex()), 1);
+			::std::vector<NearestNeighbors::Neighbor> neighbors = tree.nn->nearest(Metric::Value(&chosen, nullptr), 1);
 			return Neighbor(
-				tree[::boost::graph_bundle].nn->isTransformedDistance() ? this->getModel()->inverseOfTransformedDistance(neighbors.front().first) : neighbors.front().first,
-				neighbors.front().second.second
+				tree.nn->isTransformedDistance() ? this->getModel()->inverseOfTransformedDistance(neighbors.front().first) : neighbors.front().first,
+				static_cast<Vertex>(neighbors.front().second.second)
 			);
 		}
 		
@@ -279,11 +273,12 @@ namespace rl
 			for (::std::size_t i = 0; i < this->tree.size(); ++i)
 			{
 				this->tree[i].clear();
-				this->tree[i][::boost::graph_bundle].nn->clear();
+				this->tree[i].nn->clear();
 				this->begin[i] = nullptr;
 				this->end[i] = nullptr;
 			}
 		}
+		
 		void
 		Rrt::setDelta(const ::rl::math::Real& delta)
 		{
@@ -299,7 +294,7 @@ namespace rl
 		void
 		Rrt::setNearestNeighbors(NearestNeighbors* nearestNeighbors, const ::std::size_t& i)
 		{
-			this->tree[i][::boost::graph_bundle].nn = nearestNeighbors;
+			this->tree[i].nn = nearestNeighbors;
 		}
 		
 		void
@@ -313,7 +308,7 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart());
 			
 			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration())
 			{
@@ -323,7 +318,7 @@ namespace rl
 				
 				if (nullptr != extended)
 				{
-					if (this->areEqual(*get(this->tree[0], extended)->q, *this->getGoal()))
+					if (this->areEqual(get(this->tree[0], extended)->q, *this->getGoal()))
 					{
 						this->end[0] = extended;
 						return true;
@@ -333,5 +328,79 @@ namespace rl
 			
 			return false;
 		}
+		
+		const ::std::size_t Rrt::Tree::blockSize = 1024;
+		
+		Rrt::Tree::Tree() :
+			nn(nullptr),
+			blocks(),
+			edges(0),
+			vertices()
+		{
+		}
+		
+		Rrt::Vertex
+		Rrt::Tree::add(const ::rl::math::ConstVectorRef& q)
+		{
+			::std::size_t index = this->vertices.size();
+			::std::size_t dof = q.size();
+			
+			if (0 == index % blockSize)
+			{
+				this->blocks.emplace_back();
+				this->blocks.back().reserve(blockSize * dof);
+			}
+			
+			::std::vector<::rl::math::Real, ::Eigen::aligned_allocator<::rl::math::Real>>& block = this->blocks.back();
+			block.insert(block.end(), q.data(), q.data() + dof);
+			
+			this->vertices.emplace_back(index, index, block.data() + block.size() - dof, dof);
+			
+			return &this->vertices.back();
+		}
+		
+		void
+		Rrt::Tree::clear()
+		{
+			this->blocks.clear();
+			this->edges = 0;
+			this->vertices.clear();
+		}
+		
+		Rrt::Vertex
+		Rrt::Tree::getParent(const Vertex& v)
+		{
+			return &this->vertices[v->parent];
+		}
+		
+		::std::size_t
+		Rrt::Tree::getNumEdges() const
+		{
+			return this->edges;
+		}
+		
+		::std::size_t
+		Rrt::Tree::getNumVertices() const
+		{
+			return this->vertices.size();
+		}
+		
+		void
+		Rrt::Tree::setParent(const Vertex& u, const Vertex& v)
+		{
+			if (v->parent == v->index)
+			{
+				++this->edges;
+			}
+			
+			v->parent = u->index;
+		}
+		
+		Rrt::VertexBundle::VertexBundle(const ::std::size_t& index, const ::std::size_t& parent, const ::rl::math::Real* q, const ::std::size_t& dof) :
+			index(index),
+			parent(parent),
+			q(q, dof)
+		{
+		}
 	}
 }
@@ -27,13 +27,13 @@
 #ifndef RL_PLAN_RRT_H
 #define RL_PLAN_RRT_H
 
-#include <memory>
-#include <boost/graph/adjacency_list.hpp>
+#include <deque>
+#include <vector>
+#include <Eigen/Core>
 
 #include "Metric.h"
 #include "NearestNeighbors.h"
 #include "Planner.h"
-#include "VectorPtr.h"
 
 namespace rl
 {
@@ -97,51 +97,65 @@ namespace rl
 		protected:
 			struct VertexBundle
 			{
+				VertexBundle(const ::std::size_t& index, const ::std::size_t& parent, const ::rl::math::Real* q, const ::std::size_t& dof);
+				
 				::std::size_t index;
 				
-				VectorPtr q;
+				/** Index of parent vertex, equal to index for the root. */
+				::std::size_t parent;
+				
+				/** Configuration stored in the arena of the tree. */
+				::Eigen::Map<const ::rl::math::Vector> q;
 			};
 			
-			struct TreeBundle;
-			
-			typedef ::boost::adjacency_list<
-				::boost::listS,
-				::boost::listS,
-				::boost::bidirectionalS,
-				::std::shared_ptr<VertexBundle>,
-				::boost::no_property,
-				TreeBundle
-			> Tree;
-			
-			typedef ::boost::adjacency_list_traits<
-				::boost::listS,
-				::boost::listS,
-				::boost::bidirectionalS,
-				::boost::listS
-			>::vertex_descriptor Vertex;
-			
-			struct TreeBundle
+			typedef VertexBundle* Vertex;
+			
+			/**
+			 * Tree with vertices stored by index.
+			 *
+			 * Configurations are copied row by row into contiguous aligned
+			 * blocks of a fixed number of vertices. Blocks are never
+			 * reallocated, so configuration pointers handed to the nearest
+			 * neighbors remain valid while the tree grows. Edges are stored
+			 * as parent indices.
+			 */
+			class Tree
 			{
+			public:
+				Tree();
+				
+				Vertex add(const ::rl::math::ConstVectorRef& q);
+				
+				void clear();
+				
+				Vertex getParent(const Vertex& v);
+				
+				::std::size_t getNumEdges() const;
+				
+				::std::size_t getNumVertices() const;
+				
+				void setParent(const Vertex& u, const Vertex& v);
+				
+				/** Number of vertices per block. */
+				static const ::std::size_t blockSize;
+				
 				NearestNeighbors* nn;
+				
+			private:
+				::std::vector<::std::vector<::rl::math::Real, ::Eigen::aligned_allocator<::rl::math::Real>>> blocks;
+				
+				::std::size_t edges;
+				
+				::std::deque<VertexBundle> vertices;
 			};
 			
-			typedef ::boost::graph_traits<Tree>::edge_descriptor Edge;
-			
-			typedef ::boost::graph_traits<Tree>::edge_iterator EdgeIterator;
-			
-			typedef ::std::pair<EdgeIterator, EdgeIterator> EdgeIteratorPair;
-			
 			typedef ::std::pair<::rl::math::Real, Vertex> Neighbor;
 			
-			typedef ::boost::graph_traits<Tree>::vertex_iterator VertexIterator;
-			
-			typedef ::std::pair<VertexIterator, VertexIterator> VertexIteratorPair;
-			
-			virtual Edge addEdge(const Vertex& u, const Vertex& v, Tree& tree);
+			virtual void addEdge(const Vertex& u, const Vertex& v, Tree& tree);
 			
-			virtual Vertex addVertex(Tree& tree, const VectorPtr& q);
+			virtual Vertex addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q);
 			
-			bool areEqual(const ::rl::math::Vector& lhs, const ::rl::math::Vector& rhs) const;
+			bool areEqual(const ::rl::math::ConstVectorRef& lhs, const ::rl::math::ConstVectorRef& rhs) const;
 			
 			virtual ::rl::math::Vector choose();
 			
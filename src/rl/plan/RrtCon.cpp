@@ -51,7 +51,7 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart());
 			
 			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration())
 			{
@@ -61,7 +61,7 @@ namespace rl
 				
 				if (nullptr != connected)
 				{
-					if (this->areEqual(*get(this->tree[0], connected)->q, *this->getGoal()))
+					if (this->areEqual(get(this->tree[0], connected)->q, *this->getGoal()))
 					{
 						this->end[0] = connected;
 						return true;
@@ -51,8 +51,8 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart());
+			this->begin[1] = this->addVertex(this->tree[1], *this->getGoal());
 			
 			Tree* a = &this->tree[0];
 			Tree* b = &this->tree[1];
@@ -67,12 +67,12 @@ namespace rl
 					
 					if (nullptr != aExtended)
 					{
-						Neighbor bNearest = this->nearest(*b, *get(*a, aExtended)->q);
-						Vertex bConnected = this->connect(*b, bNearest, *get(*a, aExtended)->q);
+						Neighbor bNearest = this->nearest(*b, get(*a, aExtended)->q);
+						Vertex bConnected = this->connect(*b, bNearest, get(*a, aExtended)->q);
 						
 						if (nullptr != bConnected)
 						{
-							if (this->areEqual(*get(*a, aExtended)->q, *get(*b, bConnected)->q))
+							if (this->areEqual(get(*a, aExtended)->q, get(*b, bConnected)->q))
 							{
 								this->end[0] = &this->tree[0] == a ? aExtended : bConnected;
 								this->end[1] = &this->tree[1] == b ? bConnected : aExtended;
@@ -201,9 +201,9 @@ namespace rl
 			::rl::math::Transform
 			Shape::getTransform() const
 			{
-				::Eigen::Transform<::rl::math::Real, 3, ::Eigen::Affine, ::Eigen::ColMajor> frame;
+				::Eigen::Transform<double, 3, ::Eigen::Affine, ::Eigen::ColMajor> frame;
 				::DT_GetMatrixd(this->object, frame.data());
-				return static_cast<Body*>(this->getBody())->frame.inverse() * frame;
+				return static_cast<Body*>(this->getBody())->frame.inverse() * frame.cast<::rl::math::Real>();
 			}
 			
 			void
@@ -225,7 +225,7 @@ namespace rl
 			{
 				this->frame = static_cast<Body*>(this->getBody())->frame * this->transform;
 				
-				::DT_SetMatrixd(this->object, this->frame.data());
+				::DT_SetMatrixd(this->object, this->frame.cast<double>().data());
 				::DT_GetBBox(this->object, this->min, this->max);
 				::BP_SetBBox(this->proxy, this->min, this->max);
 			}
@@ -0,0 +1,233 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_UTIL_THREADPOOL_H
+#define RL_UTIL_THREADPOOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rl
+{
+	namespace util
+	{
+		/**
+		 * Fixed set of worker threads that are kept alive between calls.
+		 *
+		 * run() hands out one index per thread, the calling thread takes part
+		 * as index zero. Only one thread may call run() at a time and calls
+		 * must not be nested.
+		 */
+		class ThreadPool
+		{
+		public:
+			/**
+			 * @param[in] threads Number of threads including the calling
+			 * thread, hardware concurrency if zero
+			 */
+			explicit ThreadPool(const ::std::size_t& threads = 0) :
+				condition(),
+				count(0),
+				done(),
+				exceptions(threads > 0 ? threads : ::std::max<::std::size_t>(::std::thread::hardware_concurrency(), 1)),
+				function(nullptr),
+				generation(0),
+				mutex(),
+				pending(0),
+				stop(false),
+				workers()
+			{
+				this->workers.reserve(this->exceptions.size() - 1);
+				
+				for (::std::size_t i = 1; i < this->exceptions.size(); ++i)
+				{
+					this->workers.emplace_back(&ThreadPool::work, this, i);
+				}
+			}
+			
+			ThreadPool(const ThreadPool&) = delete;
+			
+			~ThreadPool()
+			{
+				{
+					::std::lock_guard<::std::mutex> lock(this->mutex);
+					this->stop = true;
+				}
+				
+				this->condition.notify_all();
+				
+				for (::std::size_t i = 0; i < this->workers.size(); ++i)
+				{
+					this->workers[i].join();
+				}
+			}
+			
+			ThreadPool& operator=(const ThreadPool&) = delete;
+			
+			/**
+			 * Call function concurrently with indices 0 to n - 1 and wait for
+			 * all calls to return.
+			 *
+			 * @param[in] n Number of calls, at most size()
+			 * @param[in] function Called with the index of its thread
+			 * @throw Exception of the call with the lowest index that failed
+			 */
+			void run(const ::std::size_t& n, const ::std::function<void(const ::std::size_t&)>& function)
+			{
+				if (n < 1)
+				{
+					return;
+				}
+				
+				if (n > 1)
+				{
+					{
+						::std::lock_guard<::std::mutex> lock(this->mutex);
+						this->count = ::std::min(n, this->size());
+						this->function = &function;
+						this->pending = this->count - 1;
+						++this->generation;
+					}
+					
+					this->condition.notify_all();
+				}
+				
+				try
+				{
+					function(0);
+				}
+				catch (...)
+				{
+					this->exceptions[0] = ::std::current_exception();
+				}
+				
+				if (n > 1)
+				{
+					::std::unique_lock<::std::mutex> lock(this->mutex);
+					this->done.wait(lock, [this]() { return 0 == this->pending; });
+					this->function = nullptr;
+				}
+				
+				for (::std::size_t i = 0; i < this->exceptions.size(); ++i)
+				{
+					if (this->exceptions[i])
+					{
+						::std::exception_ptr exception = this->exceptions[i];
+						::std::fill(this->exceptions.begin(), this->exceptions.end(), nullptr);
+						::std::rethrow_exception(exception);
+					}
+				}
+			}
+			
+			/**
+			 * @return Number of threads including the calling thread
+			 */
+			::std::size_t size() const
+			{
+				return this->exceptions.size();
+			}
+			
+		protected:
+			
+		private:
+			void work(const ::std::size_t& i)
+			{
+				::std::size_t generation = 0;
+				
+				while (true)
+				{
+					const ::std::function<void(const ::std::size_t&)>* function = nullptr;
+					
+					{
+						::std::unique_lock<::std::mutex> lock(this->mutex);
+						this->condition.wait(lock, [this, &generation]() { return this->stop || this->generation != generation; });
+						
+						if (this->stop)
+						{
+							return;
+						}
+						
+						generation = this->generation;
+						
+						if (i >= this->count)
+						{
+							continue;
+						}
+						
+						function = this->function;
+					}
+					
+					try
+					{
+						(*function)(i);
+					}
+					catch (...)
+					{
+						this->exceptions[i] = ::std::current_exception();
+					}
+					
+					{
+						::std::lock_guard<::std::mutex> lock(this->mutex);
+						--this->pending;
+					}
+					
+					this->done.notify_one();
+				}
+			}
+			
+			::std::condition_variable condition;
+			
+			/** Number of threads taking part in current call. */
+			::std::size_t count;
+			
+			::std::condition_variable done;
+			
+			::std::vector<::std::exception_ptr> exceptions;
+			
+			const ::std::function<void(const ::std::size_t&)>* function;
+			
+			/** Incremented for every call distributed to workers. */
+			::std::size_t generation;
+			
+			::std::mutex mutex;
+			
+			/** Number of workers still running current call. */
+			::std::size_t pending;
+			
+			bool stop;
+			
+			::std::vector<::std::thread> workers;
+		};
+	}
+}
+
+#endif // RL_UTIL_THREADPOOL_H
@@ -0,0 +1,298 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/CacheFactory.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/XmlFactory.h>
+
+bool
+compare(rl::mdl::Dynamic* expected, rl::mdl::Dynamic* actual, const std::size_t& loop)
+{
+	if (
+		expected->getName() != actual->getName() ||
+		expected->getManufacturer() != actual->getManufacturer() ||
+		expected->getBodies() != actual->getBodies() ||
+		expected->getDof() != actual->getDof() ||
+		expected->getDofPosition() != actual->getDofPosition() ||
+		expected->getFrames() != actual->getFrames() ||
+		expected->getJoints() != actual->getJoints() ||
+		expected->getOperationalDof() != actual->getOperationalDof() ||
+		expected->getTransforms() != actual->getTransforms()
+	)
+	{
+		std::cerr << "Structure of cached model does not match" << std::endl;
+		return false;
+	}
+	
+	for (std::size_t i = 0; i < expected->getFrames(); ++i)
+	{
+		if (expected->getFrame(i)->getName() != actual->getFrame(i)->getName())
+		{
+			std::cerr << "Frame " << i << " of cached model does not match" << std::endl;
+			return false;
+		}
+	}
+	
+	for (std::size_t i = 0; i < expected->getBodies(); ++i)
+	{
+		for (std::size_t j = 0; j < expected->getBodies(); ++j)
+		{
+			if (expected->areColliding(i, j) != actual->areColliding(i, j))
+			{
+				std::cerr << "Collision of bodies " << i << " and " << j << " of cached model does not match" << std::endl;
+				return false;
+			}
+		}
+	}
+	
+	if (
+		expected->getHomePosition() != actual->getHomePosition() ||
+		expected->getGammaPosition() != actual->getGammaPosition() ||
+		expected->getGammaVelocity() != actual->getGammaVelocity() ||
+		expected->getMaximum() != actual->getMaximum() ||
+		expected->getMinimum() != actual->getMinimum() ||
+		expected->getSpeed() != actual->getSpeed() ||
+		expected->getWraparounds() != actual->getWraparounds() ||
+		expected->getWorldGravity() != actual->getWorldGravity()
+	)
+	{
+		std::cerr << "Parameters of cached model do not match" << std::endl;
+		return false;
+	}
+	
+	expected->seed(0);
+	
+	for (std::size_t i = 0; i < loop; ++i)
+	{
+		rl::math::Vector q = expected->generatePositionUniform();
+		rl::math::Vector qd = rl::math::Vector::Random(expected->getDof());
+		rl::math::Vector tau = rl::math::Vector::Random(expected->getDof());
+		
+		expected->setPosition(q);
+		expected->setVelocity(qd);
+		expected->setTorque(tau);
+		expected->forwardDynamics();
+		expected->calculateMassMatrix();
+		
+		actual->setPosition(q);
+		actual->setVelocity(qd);
+		actual->setTorque(tau);
+		actual->forwardDynamics();
+		actual->calculateMassMatrix();
+		
+		for (std::size_t j = 0; j < expected->getOperationalDof(); ++j)
+		{
+			if (!expected->getOperationalPosition(j).matrix().isApprox(actual->getOperationalPosition(j).matrix()))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "Operational position " << j << " of cached model does not match" << std::endl;
+				return false;
+			}
+		}
+		
+		if (!expected->getAcceleration().isApprox(actual->getAcceleration()) || !expected->getMassMatrix().isApprox(actual->getMassMatrix()))
+		{
+			std::cerr << "q = " << q.transpose() << std::endl;
+			std::cerr << "qdd = " << expected->getAcceleration().transpose() << std::endl;
+			std::cerr << "qdd (cached model) = " << actual->getAcceleration().transpose() << std::endl;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: rlCacheFactoryTest MODELFILE CACHEDIRECTORY" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		rl::mdl::XmlFactory xml;
+		rl::mdl::CacheFactory cache(&xml, argv[2]);
+		std::string filename = cache.getCacheFilename(argv[1]);
+		std::remove(filename.c_str());
+		
+		std::shared_ptr<rl::mdl::Dynamic> expected = std::dynamic_pointer_cast<rl::mdl::Dynamic>(xml.create(argv[1]));
+		std::shared_ptr<rl::mdl::Dynamic> miss = std::dynamic_pointer_cast<rl::mdl::Dynamic>(cache.create(argv[1]));
+		
+		if (cache.isHit())
+		{
+			std::cerr << "Missing cache reported as hit" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::shared_ptr<rl::mdl::Dynamic> hit = std::dynamic_pointer_cast<rl::mdl::Dynamic>(cache.create(argv[1]));
+		
+		if (!cache.isHit())
+		{
+			std::cerr << "Cache " << filename << " not used" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (!compare(expected.get(), miss.get(), 10) || !compare(expected.get(), hit.get(), 100))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		// stale cache
+		
+		rl::mdl::Dynamic other;
+		
+		if (cache.read(filename, filename, &other) || other.getFrames() > 0)
+		{
+			std::cerr << "Cache of different source file not detected" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::vector<std::pair<std::string, std::uint64_t>> dependencies = rl::mdl::CacheFactory::getDependencies(argv[1]);
+		dependencies[0].second += 1;
+		cache.write(filename, dependencies, expected.get());
+		
+		rl::mdl::Dynamic stale;
+		
+		if (cache.read(filename, argv[1], &stale) || stale.getFrames() > 0)
+		{
+			std::cerr << "Stale cache not detected" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		cache.create(argv[1]);
+		
+		if (cache.isHit())
+		{
+			std::cerr << "Stale cache reported as hit" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		cache.create(argv[1]);
+		
+		if (!cache.isHit())
+		{
+			std::cerr << "Stale cache not replaced" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// truncated cache
+		
+		std::vector<char> buffer;
+		
+		{
+			std::ifstream file(filename.c_str(), std::ios::binary);
+			buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+		
+		for (std::size_t size = 0; size < buffer.size(); size += 1 + buffer.size() / 50)
+		{
+			{
+				std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+				file.write(buffer.data(), size);
+			}
+			
+			rl::mdl::Dynamic truncated;
+			
+			if (cache.read(filename, argv[1], &truncated) || truncated.getFrames() > 0)
+			{
+				std::cerr << "Cache truncated to " << size << " bytes not detected" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// modified included file
+		
+		std::string included = filename + ".included.xml";
+		std::string including = filename + ".including.xml";
+		std::string content;
+		
+		{
+			std::ifstream file(argv[1], std::ios::binary);
+			content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+		
+		{
+			std::ofstream file(included.c_str(), std::ios::binary | std::ios::trunc);
+			file << content;
+		}
+		
+		{
+			std::ofstream file(including.c_str(), std::ios::binary | std::ios::trunc);
+			file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+			file << "<xi:include xmlns:xi=\"http://www.w3.org/2001/XInclude\" href=\"" << included << "\"/>" << std::endl;
+		}
+		
+		std::remove(cache.getCacheFilename(including).c_str());
+		cache.create(including);
+		std::vector<std::pair<std::string, std::uint64_t>> includingDependencies = rl::mdl::CacheFactory::getDependencies(including);
+		
+		{
+			std::ofstream file(included.c_str(), std::ios::binary | std::ios::trunc);
+			file << content.replace(content.find("<name>"), 6, "<name>Modified ");
+		}
+		
+		std::uint64_t modifiedHash = rl::mdl::CacheFactory::hash(included);
+		std::shared_ptr<rl::mdl::Dynamic> modified = std::dynamic_pointer_cast<rl::mdl::Dynamic>(cache.create(including));
+		
+		std::remove(cache.getCacheFilename(including).c_str());
+		std::remove(including.c_str());
+		std::remove(included.c_str());
+		
+		if (includingDependencies.size() != 2 || included != includingDependencies[1].first || modifiedHash == includingDependencies[1].second)
+		{
+			std::cerr << "Included file not recorded" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (cache.isHit() || 0 != modified->getName().find("Modified "))
+		{
+			std::cerr << "Modified included file not detected" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
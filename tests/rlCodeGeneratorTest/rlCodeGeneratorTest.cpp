@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/XmlFactory.h>
+
+#include "Generated.h"
+
+template<typename T1, typename T2>
+bool
+check(const std::string& name, const T1& expected, const T2& actual, const rl::math::Vector& q)
+{
+	if (!expected.isApprox(actual, 1.0e-9) && (expected - actual).norm() > 1.0e-9)
+	{
+		std::cerr << "q = " << q.transpose() << std::endl;
+		std::cerr << name << " = " << std::endl << expected << std::endl;
+		std::cerr << name << " (generated) = " << std::endl << actual << std::endl;
+		return false;
+	}
+	
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: rlCodeGeneratorTest MODELFILE LOOP" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[1]));
+		
+		if (Generated::JointVector::RowsAtCompileTime != dynamic->getDof() || Generated::OperationalPositions().size() != dynamic->getOperationalDof())
+		{
+			std::cerr << "Generated code does not match model " << argv[1] << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Matrix J(6 * dynamic->getOperationalDof(), dynamic->getDof());
+		rl::math::Matrix M(dynamic->getDof(), dynamic->getDof());
+		
+		Generated::JacobianMatrix J2;
+		Generated::MassMatrix M2;
+		Generated::JointVector qdd2;
+		Generated::JointVector tau2;
+		Generated::OperationalPositions x2;
+		
+		dynamic->seed(0);
+		
+		for (std::size_t i = 0; i < std::atoi(argv[2]); ++i)
+		{
+			rl::math::Vector q = dynamic->generatePositionUniform();
+			rl::math::Vector qd = rl::math::Vector::Random(dynamic->getDof());
+			rl::math::Vector qdd = rl::math::Vector::Random(dynamic->getDof());
+			rl::math::Vector tau = rl::math::Vector::Random(dynamic->getDof());
+			
+			dynamic->setPosition(q);
+			dynamic->forwardPosition();
+			Generated::forwardPosition(q, x2);
+			
+			for (std::size_t j = 0; j < dynamic->getOperationalDof(); ++j)
+			{
+				if (!check("x", dynamic->getOperationalPosition(j).matrix(), x2[j].matrix(), q))
+				{
+					return EXIT_FAILURE;
+				}
+			}
+			
+			dynamic->calculateJacobian(J);
+			Generated::calculateJacobian(q, J2);
+			
+			if (!check("J", J, J2, q))
+			{
+				return EXIT_FAILURE;
+			}
+			
+			dynamic->calculateMassMatrix(M);
+			Generated::calculateMassMatrix(q, M2);
+			
+			if (!check("M", M, M2, q))
+			{
+				return EXIT_FAILURE;
+			}
+			
+			dynamic->setVelocity(qd);
+			dynamic->setAcceleration(qdd);
+			dynamic->inverseDynamics();
+			Generated::inverseDynamics(q, qd, qdd, tau2);
+			
+			if (!check("tau", dynamic->getTorque(), tau2, q))
+			{
+				return EXIT_FAILURE;
+			}
+			
+			dynamic->setTorque(tau);
+			dynamic->forwardDynamics();
+			Generated::forwardDynamics(q, qd, tau, qdd2);
+			
+			if (!check("qdd", dynamic->getAcceleration(), qdd2, q))
+			{
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <rl/mdl/AllocationGuard.h>
+#include <rl/mdl/DormandPrinceIntegrator.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/EulerCauchyIntegrator.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
+#include <rl/mdl/SymplecticEulerIntegrator.h>
+#include <rl/mdl/XmlFactory.h>
+
+static std::atomic<std::size_t> allocations(0);
+
+static void
+count()
+{
+	if (rl::mdl::AllocationGuard::isActive())
+	{
+		++allocations;
+	}
+}
+
+#ifdef __GLIBC__
+// Eigen allocates with malloc, replace the C allocation functions and
+// forward to glibc, operator new of the standard library uses them as well
+
+extern "C" void* __libc_calloc(std::size_t, std::size_t);
+extern "C" void __libc_free(void*);
+extern "C" void* __libc_malloc(std::size_t);
+extern "C" void* __libc_realloc(void*, std::size_t);
+
+extern "C" void*
+calloc(std::size_t num, std::size_t size)
+{
+	count();
+	return __libc_calloc(num, size);
+}
+
+extern "C" void
+free(void* ptr)
+{
+	__libc_free(ptr);
+}
+
+extern "C" void*
+malloc(std::size_t size)
+{
+	count();
+	return __libc_malloc(size);
+}
+
+extern "C" void*
+realloc(void* ptr, std::size_t size)
+{
+	count();
+	return __libc_realloc(ptr, size);
+}
+#else // __GLIBC__
+void*
+operator new(std::size_t size)
+{
+	count();
+	
+	if (void* ptr = std::malloc(0 == size ? 1 : size))
+	{
+		return ptr;
+	}
+	
+	throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+#endif // __GLIBC__
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: rlDynamicsAllocationTest MODELFILE LOOP" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::mt19937 generator(std::random_device{}());
+		std::uniform_real_distribution<rl::math::Real> distribution(-1, 1);
+		
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[1]));
+		
+		if (nullptr == dynamic)
+		{
+			std::cerr << "Model " << argv[1] << " is not a dynamic model" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Vector q(dynamic->getDofPosition());
+		rl::math::Vector qd(dynamic->getDof());
+		rl::math::Vector qdd(dynamic->getDof());
+		rl::math::Vector tau(dynamic->getDof());
+		rl::math::Vector tau2(dynamic->getDof());
+		rl::math::Vector G(dynamic->getDof());
+		rl::math::Vector V(dynamic->getDof());
+		rl::math::Matrix M(dynamic->getDof(), dynamic->getDof());
+		rl::math::Matrix J(6 * dynamic->getOperationalDof(), dynamic->getDof());
+		rl::math::Vector q2(dynamic->getDofPosition());
+		rl::math::Vector qd2(dynamic->getDof());
+		rl::math::Vector dx = rl::math::Vector::Ones(6 * dynamic->getOperationalDof());
+		rl::math::Vector dq(dynamic->getDof());
+		
+		{
+			rl::mdl::AllocationGuard guard;
+			void* volatile ptr = std::malloc(sizeof(rl::math::Real));
+			std::free(ptr);
+		}
+		
+#ifdef __GLIBC__
+		if (0 == allocations)
+		{
+			std::cerr << "Allocation inside guard was not counted" << std::endl;
+			return EXIT_FAILURE;
+		}
+#endif // __GLIBC__
+		
+		allocations = 0;
+		
+		rl::mdl::DormandPrinceIntegrator dormandPrince(dynamic.get());
+		rl::mdl::EulerCauchyIntegrator eulerCauchy(dynamic.get());
+		rl::mdl::RungeKuttaNystromIntegrator rungeKuttaNystrom(dynamic.get());
+		rl::mdl::SymplecticEulerIntegrator symplecticEuler(dynamic.get());
+		
+		for (std::size_t i = 0; i < std::atoi(argv[2]); ++i)
+		{
+			for (std::ptrdiff_t j = 0; j < q.size(); ++j)
+			{
+				q(j) = distribution(generator);
+			}
+			
+			for (std::ptrdiff_t j = 0; j < qd.size(); ++j)
+			{
+				qd(j) = distribution(generator);
+				tau(j) = distribution(generator);
+			}
+			
+			{
+				rl::mdl::AllocationGuard guard;
+				
+				dynamic->setPosition(q);
+				dynamic->setVelocity(qd);
+				dynamic->setTorque(tau);
+				dynamic->forwardDynamics();
+				dynamic->getAcceleration(qdd);
+				
+				dynamic->setAcceleration(qdd);
+				dynamic->inverseDynamics();
+				dynamic->getTorque(tau2);
+				
+				dynamic->calculateMassMatrix(M);
+				dynamic->calculateCentrifugalCoriolis(V);
+				dynamic->calculateGravity(G);
+				
+				dynamic->forwardPosition();
+				dynamic->calculateJacobian(J);
+				
+				dynamic->calculateJacobian();
+				dynamic->calculateJacobianInverse(static_cast<rl::math::Real>(0.1), rl::mdl::Kinematic::JacobianInverseMethod::svd);
+				dynamic->solveJacobianInverse(dx, dq, static_cast<rl::math::Real>(0.1), rl::mdl::Kinematic::JacobianInverseMethod::svd);
+				dynamic->solveJacobianInverse(dx, dq, static_cast<rl::math::Real>(0.1), rl::mdl::Kinematic::JacobianInverseMethod::ldlt);
+				dynamic->solveJacobianInverse(dx, dq, static_cast<rl::math::Real>(0.1), rl::mdl::Kinematic::JacobianInverseMethod::llt);
+				
+				dynamic->getPosition(q2);
+				dynamic->getVelocity(qd2);
+				
+				dormandPrince.integrate(static_cast<rl::math::Real>(0.001));
+				eulerCauchy.integrate(static_cast<rl::math::Real>(0.001));
+				rungeKuttaNystrom.integrate(static_cast<rl::math::Real>(0.001));
+				symplecticEuler.integrate(static_cast<rl::math::Real>(0.001));
+			}
+			
+			if (allocations > 0)
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "allocations = " << allocations << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			if (!tau2.isApprox(tau, 1.0e-6) && (tau2 - tau).norm() > 1.0e-6)
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "tau = " << tau.transpose() << std::endl;
+				std::cerr << "tau (inverse dynamics) = " << tau2.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			if (!(M * qdd + V + G).isApprox(tau, 1.0e-6) && (M * qdd + V + G - tau).norm() > 1.0e-6)
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "tau = " << tau.transpose() << std::endl;
+				std::cerr << "M * qdd + V + G = " << (M * qdd + V + G).transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
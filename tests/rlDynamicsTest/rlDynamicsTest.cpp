@@ -28,7 +28,13 @@
 #include <memory>
 #include <random>
 #include <stdexcept>
+#include <vector>
+#include <rl/mdl/BatchEvaluator.h>
+#include <rl/mdl/DormandPrinceIntegrator.h>
 #include <rl/mdl/Dynamic.h>
+#include <rl/mdl/Joint.h>
+#include <rl/mdl/RolloutEvaluator.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
 #include <rl/mdl/XmlFactory.h>
 
 int
@@ -205,6 +211,338 @@ main(int argc, char** argv)
 				std::cerr << "qdd (matrices) = " << qddMatrices.transpose() << std::endl;
 				return EXIT_FAILURE;
 			}
+			
+			// forward dynamics (factorization)
+			
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrix();
+			dynamic->calculateMassMatrixFactorization();
+			
+			rl::math::Vector qddFactorization = tauMatrices - dynamic->getCentrifugalCoriolis() - dynamic->getGravity();
+			dynamic->solveMassMatrix(qddFactorization);
+			
+			if (!qddFactorization.isApprox(qddRecursive))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "qdd = " << qdd.transpose() << std::endl;
+				std::cerr << "tau (recursive) = " << tauRecursive.transpose() << std::endl;
+				std::cerr << "tau (matrices) = " << tauMatrices.transpose() << std::endl;
+				std::cerr << "qdd (recursive) = " << qddRecursive.transpose() << std::endl;
+				std::cerr << "qdd (factorization) = " << qddFactorization.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			// inverse dynamics derivatives (analytical)
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setAcceleration(qdd);
+			dynamic->calculateInverseDynamicsDerivatives();
+			
+			// inverse dynamics derivatives (central differences)
+			
+			rl::math::Real h = static_cast<rl::math::Real>(1.0e-6);
+			rl::math::Matrix dtaudq(dynamic->getDof(), dynamic->getDof());
+			rl::math::Matrix dtaudqd(dynamic->getDof(), dynamic->getDof());
+			rl::math::Vector dq = rl::math::Vector::Zero(dynamic->getDof());
+			rl::math::Vector q1(dynamic->getDofPosition());
+			rl::math::Vector q2(dynamic->getDofPosition());
+			
+			for (::std::size_t j = 0; j < dynamic->getDof(); ++j)
+			{
+				dq(j) = h;
+				
+				// random positions may exceed joint limits, avoid clamping in step()
+				if (dynamic->getDofPosition() == dynamic->getDof())
+				{
+					q2 = q + dq;
+					q1 = q - dq;
+				}
+				else
+				{
+					dynamic->step(q, dq, q2);
+					dynamic->step(q, -dq, q1);
+				}
+				
+				dynamic->setPosition(q2);
+				dynamic->setVelocity(qd);
+				dynamic->inverseDynamics();
+				dtaudq.col(j) = dynamic->getTorque();
+				dynamic->setPosition(q1);
+				dynamic->inverseDynamics();
+				dtaudq.col(j) = (dtaudq.col(j) - dynamic->getTorque()) / (2 * h);
+				
+				dynamic->setPosition(q);
+				dynamic->setVelocity(qd + dq);
+				dynamic->inverseDynamics();
+				dtaudqd.col(j) = dynamic->getTorque();
+				dynamic->setVelocity(qd - dq);
+				dynamic->inverseDynamics();
+				dtaudqd.col(j) = (dtaudqd.col(j) - dynamic->getTorque()) / (2 * h);
+				
+				dq(j) = 0;
+			}
+			
+			if (!dynamic->getInverseDynamicsPositionDerivative().isApprox(dtaudq, static_cast<rl::math::Real>(1.0e-5)) || !dynamic->getInverseDynamicsVelocityDerivative().isApprox(dtaudqd, static_cast<rl::math::Real>(1.0e-5)))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "qdd = " << qdd.transpose() << std::endl;
+				std::cerr << "dtau/dq (analytical) = " << std::endl << dynamic->getInverseDynamicsPositionDerivative() << std::endl;
+				std::cerr << "dtau/dq (central differences) = " << std::endl << dtaudq << std::endl;
+				std::cerr << "dtau/dqd (analytical) = " << std::endl << dynamic->getInverseDynamicsVelocityDerivative() << std::endl;
+				std::cerr << "dtau/dqd (central differences) = " << std::endl << dtaudqd << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			// forward dynamics derivatives (analytical)
+			
+			rl::math::Vector tau = rl::math::Vector::Random(dynamic->getDof());
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(tau);
+			dynamic->calculateForwardDynamicsDerivatives();
+			
+			rl::math::Matrix dqdddqAnalytical(dynamic->getDof(), dynamic->getDof());
+			rl::math::Matrix dqdddqdAnalytical(dynamic->getDof(), dynamic->getDof());
+			rl::math::Matrix invM(dynamic->getDof(), dynamic->getDof());
+			dynamic->calculateForwardDynamicsDerivatives(dqdddqAnalytical, dqdddqdAnalytical, invM);
+			
+			// forward dynamics derivatives (central differences)
+			
+			rl::math::Matrix dqdddq(dynamic->getDof(), dynamic->getDof());
+			rl::math::Matrix dqdddqd(dynamic->getDof(), dynamic->getDof());
+			rl::math::Matrix dqdddtau(dynamic->getDof(), dynamic->getDof());
+			
+			for (::std::size_t j = 0; j < dynamic->getDof(); ++j)
+			{
+				dq(j) = h;
+				
+				if (dynamic->getDofPosition() == dynamic->getDof())
+				{
+					q2 = q + dq;
+					q1 = q - dq;
+				}
+				else
+				{
+					dynamic->step(q, dq, q2);
+					dynamic->step(q, -dq, q1);
+				}
+				
+				dynamic->setPosition(q2);
+				dynamic->setVelocity(qd);
+				dynamic->setTorque(tau);
+				dynamic->forwardDynamics();
+				dqdddq.col(j) = dynamic->getAcceleration();
+				dynamic->setPosition(q1);
+				dynamic->forwardDynamics();
+				dqdddq.col(j) = (dqdddq.col(j) - dynamic->getAcceleration()) / (2 * h);
+				
+				dynamic->setPosition(q);
+				dynamic->setVelocity(qd + dq);
+				dynamic->forwardDynamics();
+				dqdddqd.col(j) = dynamic->getAcceleration();
+				dynamic->setVelocity(qd - dq);
+				dynamic->forwardDynamics();
+				dqdddqd.col(j) = (dqdddqd.col(j) - dynamic->getAcceleration()) / (2 * h);
+				
+				dynamic->setVelocity(qd);
+				dynamic->setTorque(tau + dq);
+				dynamic->forwardDynamics();
+				dqdddtau.col(j) = dynamic->getAcceleration();
+				dynamic->setTorque(tau - dq);
+				dynamic->forwardDynamics();
+				dqdddtau.col(j) = (dqdddtau.col(j) - dynamic->getAcceleration()) / (2 * h);
+				
+				dq(j) = 0;
+			}
+			
+			if (
+				!dynamic->getForwardDynamicsPositionDerivative().isApprox(dqdddq, static_cast<rl::math::Real>(1.0e-5)) ||
+				!dynamic->getForwardDynamicsVelocityDerivative().isApprox(dqdddqd, static_cast<rl::math::Real>(1.0e-5)) ||
+				!dqdddqAnalytical.isApprox(dqdddq, static_cast<rl::math::Real>(1.0e-5)) ||
+				!dqdddqdAnalytical.isApprox(dqdddqd, static_cast<rl::math::Real>(1.0e-5)) ||
+				!invM.isApprox(dqdddtau, static_cast<rl::math::Real>(1.0e-5))
+			)
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "tau = " << tau.transpose() << std::endl;
+				std::cerr << "dqdd/dq (analytical) = " << std::endl << dynamic->getForwardDynamicsPositionDerivative() << std::endl;
+				std::cerr << "dqdd/dq (central differences) = " << std::endl << dqdddq << std::endl;
+				std::cerr << "dqdd/dqd (analytical) = " << std::endl << dynamic->getForwardDynamicsVelocityDerivative() << std::endl;
+				std::cerr << "dqdd/dqd (central differences) = " << std::endl << dqdddqd << std::endl;
+				std::cerr << "dqdd/dtau (analytical) = " << std::endl << invM << std::endl;
+				std::cerr << "dqdd/dtau (central differences) = " << std::endl << dqdddtau << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// batch evaluation
+		
+		rl::math::Matrix Q = rl::math::Matrix::Random(dynamic->getDofPosition(), atoi(argv[2]));
+		rl::math::Matrix Qd = rl::math::Matrix::Random(dynamic->getDof(), atoi(argv[2]));
+		rl::math::Matrix Qdd = rl::math::Matrix::Random(dynamic->getDof(), atoi(argv[2]));
+		
+		rl::mdl::BatchEvaluator batch(dynamic.get(), 4);
+		
+		rl::math::Matrix X;
+		batch.forwardPosition(Q, X);
+		rl::math::Matrix J;
+		batch.calculateJacobian(Q, J);
+		rl::math::Matrix Tau;
+		batch.inverseDynamics(Q, Qd, Qdd, Tau);
+		
+		for (std::ptrdiff_t i = 0; i < Q.cols(); ++i)
+		{
+			q = Q.col(i);
+			qd = Qd.col(i);
+			qdd = Qdd.col(i);
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setAcceleration(qdd);
+			dynamic->inverseDynamics();
+			dynamic->calculateJacobian();
+			
+			for (std::size_t j = 0; j < dynamic->getOperationalDof(); ++j)
+			{
+				if (!rl::math::Matrix44::Map(X.col(i).data() + 16 * j).isApprox(dynamic->getOperationalPosition(j).matrix()))
+				{
+					std::cerr << "q = " << q.transpose() << std::endl;
+					std::cerr << "x (batch) = " << std::endl << rl::math::Matrix44::Map(X.col(i).data() + 16 * j) << std::endl;
+					std::cerr << "x (single) = " << std::endl << dynamic->getOperationalPosition(j).matrix() << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+			
+			if (!J.middleCols(i * dynamic->getDof(), dynamic->getDof()).isApprox(dynamic->getJacobian()) || !Tau.col(i).isApprox(dynamic->getTorque()))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "qdd = " << qdd.transpose() << std::endl;
+				std::cerr << "J (batch) = " << std::endl << J.middleCols(i * dynamic->getDof(), dynamic->getDof()) << std::endl;
+				std::cerr << "J (single) = " << std::endl << dynamic->getJacobian() << std::endl;
+				std::cerr << "tau (batch) = " << Tau.col(i).transpose() << std::endl;
+				std::cerr << "tau (single) = " << dynamic->getTorque().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// copies for threads
+		
+		dynamic->seed(1);
+		rl::math::Vector position = dynamic->getPosition();
+		std::unique_ptr<rl::mdl::Dynamic> copy(static_cast<rl::mdl::Dynamic*>(dynamic->clone()));
+		rl::math::Vector sample = copy->generatePositionUniform();
+		copy->setPosition(sample);
+		copy->forwardPosition();
+		
+		if (dynamic->getPosition() != position || dynamic->generatePositionUniform() != sample)
+		{
+			std::cerr << "Copy is not independent of model or does not continue its random sequence" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// rollouts
+		
+		std::size_t steps = 20;
+		
+		rl::math::Matrix TauRollout = rl::math::Matrix::Random(dynamic->getDof(), steps * atoi(argv[2]));
+		q.setRandom();
+		qd.setRandom();
+		
+		rl::mdl::RolloutEvaluator rollouts(dynamic.get(), 4);
+		
+		rl::mdl::DormandPrinceIntegrator dormandPrince(dynamic.get());
+		rl::mdl::RungeKuttaNystromIntegrator rungeKuttaNystrom(dynamic.get());
+		
+		for (const rl::mdl::RolloutEvaluator::Method& method : {rl::mdl::RolloutEvaluator::Method::rungeKuttaNystrom, rl::mdl::RolloutEvaluator::Method::dormandPrince})
+		{
+			rollouts.setMethod(method);
+			
+			// several adaptive steps per time step
+			rl::math::Real dt = static_cast<rl::math::Real>(rl::mdl::RolloutEvaluator::Method::dormandPrince == method ? 0.1 : 0.001);
+			
+			rl::math::Matrix QRollout;
+			rl::math::Matrix QdRollout;
+			std::vector<std::size_t> lengths;
+			
+			// stop odd rollouts after 5 steps
+			rollouts.rollout(q, qd, TauRollout, steps, dt, QRollout, QdRollout, lengths, [](const rl::math::ConstVectorRef&, const rl::math::ConstVectorRef&, const std::size_t& k, const std::size_t& t) {
+				return 1 == k % 2 && 4 == t;
+			});
+			
+			rl::mdl::Integrator* integrator = rl::mdl::RolloutEvaluator::Method::dormandPrince == method ? static_cast<rl::mdl::Integrator*>(&dormandPrince) : &rungeKuttaNystrom;
+			
+			for (std::size_t i = 0; i < lengths.size(); ++i)
+			{
+				dynamic->setPosition(q);
+				dynamic->setVelocity(qd);
+				dormandPrince.setStepSize(0);
+				
+				if (lengths[i] != (1 == i % 2 ? 5 : steps))
+				{
+					std::cerr << "rollout " << i << " length = " << lengths[i] << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				for (std::size_t j = 0; j < steps; ++j)
+				{
+					if (j < lengths[i])
+					{
+						dynamic->setTorque(TauRollout.col(i * steps + j));
+						integrator->integrate(dt);
+					}
+					
+					if (!QRollout.col(i * steps + j).isApprox(dynamic->getPosition()) || !QdRollout.col(i * steps + j).isApprox(dynamic->getVelocity()))
+					{
+						std::cerr << "rollout " << i << " step " << j << std::endl;
+						std::cerr << "q (rollout) = " << QRollout.col(i * steps + j).transpose() << std::endl;
+						std::cerr << "q (single) = " << dynamic->getPosition().transpose() << std::endl;
+						std::cerr << "qd (rollout) = " << QdRollout.col(i * steps + j).transpose() << std::endl;
+						std::cerr << "qd (single) = " << dynamic->getVelocity().transpose() << std::endl;
+						return EXIT_FAILURE;
+					}
+				}
+			}
+		}
+		
+		// coupled joints
+		
+		rl::math::Matrix coupled = rl::math::Matrix::Identity(dynamic->getDofPosition(), dynamic->getDofPosition());
+		coupled.diagonal(-1).setOnes();
+		
+		rl::math::Matrix permutation = rl::math::Matrix::Identity(dynamic->getDofPosition(), dynamic->getDofPosition()).rowwise().reverse();
+		
+		for (const rl::math::Matrix& gamma : {coupled, permutation})
+		{
+			dynamic->setGammaPosition(gamma);
+			dynamic->setGammaVelocity(gamma);
+			
+			q.setRandom();
+			qd.setRandom();
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			
+			rl::math::Vector qJoints(dynamic->getDofPosition());
+			
+			for (std::size_t i = 0, j = 0; i < dynamic->getJoints(); j += dynamic->getJoint(i)->getDofPosition(), ++i)
+			{
+				qJoints.segment(j, dynamic->getJoint(i)->getDofPosition()) = dynamic->getJoint(i)->getPosition();
+			}
+			
+			if (!qJoints.isApprox(gamma * q) || !dynamic->getPosition().isApprox(q) || !dynamic->getVelocity().isApprox(qd))
+			{
+				std::cerr << "gamma = " << std::endl << gamma << std::endl;
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "q (joints) = " << qJoints.transpose() << std::endl;
+				std::cerr << "q (model) = " << dynamic->getPosition().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
 		}
 	}
 	catch (const std::exception& e)
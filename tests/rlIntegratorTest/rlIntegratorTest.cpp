@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <rl/mdl/DormandPrinceIntegrator.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/EulerCauchyIntegrator.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
+#include <rl/mdl/SymplecticEulerIntegrator.h>
+#include <rl/mdl/XmlFactory.h>
+
+rl::math::Real
+kineticEnergy(rl::mdl::Dynamic* dynamic)
+{
+	rl::math::Vector qd = dynamic->getVelocity();
+	dynamic->calculateMassMatrix();
+	return qd.dot(dynamic->getMassMatrix() * qd) / 2;
+}
+
+void
+simulate(rl::mdl::Dynamic* dynamic, rl::mdl::Integrator* integrator, const rl::math::Vector& q, const rl::math::Vector& qd, const rl::math::Real& duration, const std::size_t& steps)
+{
+	dynamic->setPosition(q);
+	dynamic->setVelocity(qd);
+	dynamic->setTorque(rl::math::Vector::Zero(dynamic->getDof()));
+	
+	for (std::size_t i = 0; i < steps; ++i)
+	{
+		integrator->integrate(duration / steps);
+	}
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: rlIntegratorTest MODELFILE LOOP" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::mt19937 generator(std::random_device{}());
+		std::uniform_real_distribution<rl::math::Real> distribution(-1, 1);
+		
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[1]));
+		
+		rl::mdl::DormandPrinceIntegrator dormandPrince(dynamic.get());
+		rl::mdl::EulerCauchyIntegrator eulerCauchy(dynamic.get());
+		rl::mdl::RungeKuttaNystromIntegrator rungeKuttaNystrom(dynamic.get());
+		rl::mdl::SymplecticEulerIntegrator symplecticEuler(dynamic.get());
+		
+		rl::math::Vector q(dynamic->getDofPosition());
+		rl::math::Vector qd(dynamic->getDof());
+		rl::math::Real duration = static_cast<rl::math::Real>(0.1);
+		
+		for (std::size_t i = 0; i < std::atoi(argv[2]); ++i)
+		{
+			for (std::ptrdiff_t j = 0; j < q.size(); ++j)
+			{
+				q(j) = distribution(generator);
+			}
+			
+			for (std::ptrdiff_t j = 0; j < qd.size(); ++j)
+			{
+				qd(j) = distribution(generator);
+			}
+			
+			// reference via tight tolerances
+			
+			dormandPrince.setAbsoluteTolerance(static_cast<rl::math::Real>(1.0e-12));
+			dormandPrince.setRelativeTolerance(static_cast<rl::math::Real>(1.0e-12));
+			dormandPrince.setStepSize(0);
+			simulate(dynamic.get(), &dormandPrince, q, qd, duration, 10);
+			rl::math::Vector qReference = dynamic->getPosition();
+			
+			// adaptive steps within default tolerances
+			
+			dormandPrince.setAbsoluteTolerance(static_cast<rl::math::Real>(1.0e-6));
+			dormandPrince.setRelativeTolerance(static_cast<rl::math::Real>(1.0e-6));
+			dormandPrince.setStepSize(0);
+			dormandPrince.resetStatistics();
+			simulate(dynamic.get(), &dormandPrince, q, qd, duration, 10);
+			
+			if (!dynamic->getPosition().isApprox(qReference, static_cast<rl::math::Real>(1.0e-4)))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "q (reference) = " << qReference.transpose() << std::endl;
+				std::cerr << "q (Dormand-Prince) = " << dynamic->getPosition().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			if (0 == dormandPrince.getAcceptedSteps() || dormandPrince.getEvaluations() != 1 + 6 * (dormandPrince.getAcceptedSteps() + dormandPrince.getRejectedSteps()))
+			{
+				std::cerr << "accepted steps = " << dormandPrince.getAcceptedSteps() << std::endl;
+				std::cerr << "rejected steps = " << dormandPrince.getRejectedSteps() << std::endl;
+				std::cerr << "evaluations = " << dormandPrince.getEvaluations() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			// fixed steps
+			
+			simulate(dynamic.get(), &rungeKuttaNystrom, q, qd, duration, 1000);
+			
+			if (!dynamic->getPosition().isApprox(qReference, static_cast<rl::math::Real>(1.0e-4)))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "q (reference) = " << qReference.transpose() << std::endl;
+				std::cerr << "q (Runge-Kutta-Nystrom) = " << dynamic->getPosition().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			simulate(dynamic.get(), &eulerCauchy, q, qd, duration, 10000);
+			
+			if (!dynamic->getPosition().isApprox(qReference, static_cast<rl::math::Real>(1.0e-2)))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "q (reference) = " << qReference.transpose() << std::endl;
+				std::cerr << "q (Euler-Cauchy) = " << dynamic->getPosition().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			simulate(dynamic.get(), &symplecticEuler, q, qd, duration, 10000);
+			
+			if (!dynamic->getPosition().isApprox(qReference, static_cast<rl::math::Real>(1.0e-2)))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "q (reference) = " << qReference.transpose() << std::endl;
+				std::cerr << "q (symplectic Euler) = " << dynamic->getPosition().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// kinetic energy of free motion without gravity
+		
+		dynamic->setWorldGravity(rl::math::Vector3::Zero());
+		
+		dynamic->setPosition(q);
+		dynamic->setVelocity(qd);
+		rl::math::Real energy = kineticEnergy(dynamic.get());
+		
+		dormandPrince.setAbsoluteTolerance(static_cast<rl::math::Real>(1.0e-9));
+		dormandPrince.setRelativeTolerance(static_cast<rl::math::Real>(1.0e-9));
+		dormandPrince.setStepSize(0);
+		simulate(dynamic.get(), &dormandPrince, q, qd, 1, 100);
+		
+		if (std::abs(kineticEnergy(dynamic.get()) - energy) > static_cast<rl::math::Real>(1.0e-6) * energy)
+		{
+			std::cerr << "q = " << q.transpose() << std::endl;
+			std::cerr << "qd = " << qd.transpose() << std::endl;
+			std::cerr << "energy = " << energy << std::endl;
+			std::cerr << "energy (Dormand-Prince) = " << kineticEnergy(dynamic.get()) << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
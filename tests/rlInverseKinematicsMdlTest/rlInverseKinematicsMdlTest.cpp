@@ -24,17 +24,42 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
 #include <memory>
+#include <random>
 #include <stdexcept>
+#include <string>
 #include <rl/mdl/JacobianInverseKinematics.h>
 #include <rl/mdl/Kinematic.h>
+#include <rl/mdl/PortfolioInverseKinematics.h>
+#include <rl/mdl/ReachabilityMap.h>
+#include <rl/mdl/SphericalWristInverseKinematics.h>
 #include <rl/mdl/XmlFactory.h>
 
 #ifdef RL_MDL_NLOPT
 #include <rl/mdl/NloptInverseKinematics.h>
 #endif
 
+/**
+ * Path in temporary directory, removed on destruction.
+ */
+struct TemporaryFile
+{
+	TemporaryFile(const std::string& name) :
+		path((std::filesystem::temp_directory_path() / name).string())
+	{
+	}
+	
+	~TemporaryFile()
+	{
+		std::remove(this->path.c_str());
+	}
+	
+	std::string path;
+};
+
 int
 main(int argc, char** argv)
 {
@@ -69,6 +94,11 @@ main(int argc, char** argv)
 		jacobianTranspose->setMethod(rl::mdl::JacobianInverseKinematics::Method::transpose);
 		ik.push_back(std::make_pair(jacobianTranspose, "rl::mdl::JacobianInverseKinematics::Method::transpose"));
 		
+		std::shared_ptr<rl::mdl::PortfolioInverseKinematics> portfolio = std::make_shared<rl::mdl::PortfolioInverseKinematics>(kinematics.get(), 4);
+		portfolio->seed(0);
+		portfolio->setMethods({rl::mdl::PortfolioInverseKinematics::Method::svd, rl::mdl::PortfolioInverseKinematics::Method::dls});
+		ik.push_back(std::make_pair(portfolio, "rl::mdl::PortfolioInverseKinematics"));
+		
 #ifdef RL_MDL_NLOPT
 		std::shared_ptr<rl::mdl::NloptInverseKinematics> nlopt = std::make_shared<rl::mdl::NloptInverseKinematics>(kinematics.get());
 		nlopt->seed(0);
@@ -114,9 +144,149 @@ main(int argc, char** argv)
 					std::cerr << "t3 = " << std::endl << t3.matrix() << std::endl;
 					std::cerr << "q1 = " << q1.transpose() << std::endl;
 					std::cerr << "q2 = " << q2.transpose() << std::endl;
-					std::cerr << "q3 = " << q3.transpose() << std::endl;
+					std::cerr << "q2 = " << kinematics->getPosition().transpose() << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+		}
+		
+		rl::mdl::SphericalWristInverseKinematics analytical(kinematics.get());
+		
+		for (std::size_t n = 0; n < 100; ++n)
+		{
+			rl::math::Vector q1 = kinematics->generatePositionUniform();
+			kinematics->normalize(q1);
+			kinematics->setPosition(q1);
+			kinematics->forwardPosition();
+			rl::math::Transform t1 = kinematics->getOperationalPosition(0);
+			
+			rl::math::Vector q2 = kinematics->generatePositionUniform();
+			kinematics->setPosition(q2);
+			analytical.clearGoals();
+			analytical.addGoal(t1, 0);
+			
+			if (!analytical.solve())
+			{
+				std::cerr << "rl::mdl::SphericalWristInverseKinematics on file " << filename << " with no solution." << std::endl;
+				std::cerr << "t1 = " << std::endl << t1.matrix() << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			bool found = false;
+			
+			for (std::size_t i = 0; i < analytical.getSolutions().size(); ++i)
+			{
+				rl::math::Vector q3 = analytical.getSolutions()[i];
+				kinematics->setPosition(q3);
+				kinematics->forwardPosition();
+				rl::math::Transform t3 = kinematics->getOperationalPosition(0);
+				
+				if (t3.toDelta(t1).squaredNorm() > 1.0e-12)
+				{
+					std::cerr << "rl::mdl::SphericalWristInverseKinematics on file " << filename << " with incorrect operational position." << std::endl;
+					std::cerr << "t3.toDelta(t1) = " << t3.toDelta(t1).transpose() << std::endl;
+					std::cerr << "q1 = " << q1.transpose() << std::endl;
+					std::cerr << "q2 = " << kinematics->getPosition().transpose() << std::endl;
 					return EXIT_FAILURE;
 				}
+				
+				found = found || (q3 - q1).norm() < 1.0e-6;
+			}
+			
+			if (!found)
+			{
+				std::cerr << "rl::mdl::SphericalWristInverseKinematics on file " << filename << " without original joint position in " << analytical.getSolutions().size() << " solutions." << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		TemporaryFile file("rlInverseKinematicsMdlTest-" + std::to_string(std::random_device()()) + ".reachability");
+		
+		rl::mdl::ReachabilityMap reachability(kinematics.get());
+		reachability.seed(0);
+		reachability.build(10000, 4);
+		reachability.save(file.path);
+		
+		rl::mdl::ReachabilityMap mapped(kinematics.get());
+		mapped.load(file.path);
+		
+		rl::mdl::ReachabilityMap serial(kinematics.get());
+		serial.seed(0);
+		serial.build(10000, 1);
+		
+		if (0 == mapped.getCells() || mapped.getCells() != reachability.getCells() || serial.getCells() != reachability.getCells() || mapped.getSamples() != 10000)
+		{
+			std::cerr << "rl::mdl::ReachabilityMap on file " << filename << " with " << mapped.getCells() << " cells after loading " << reachability.getCells() << " cells." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::mdl::JacobianInverseKinematics reachabilityIk(kinematics.get());
+		reachabilityIk.seed(0);
+		reachabilityIk.setReachabilityMap(&mapped);
+		
+		// first samples of map
+		kinematics->seed(0);
+		
+		for (std::size_t n = 0; n < 100; ++n)
+		{
+			rl::math::Vector q1 = kinematics->generatePositionUniform();
+			kinematics->setPosition(q1);
+			kinematics->forwardPosition();
+			rl::math::Transform t1 = kinematics->getOperationalPosition(0);
+			
+			rl::math::Vector q2(kinematics->getDofPosition());
+			
+			if (!mapped.isReachable(t1) || 0 == mapped.getCount(t1) || mapped.getCount(t1) != reachability.getCount(t1) || serial.getCount(t1) != reachability.getCount(t1) || !mapped.getSeed(t1, q2))
+			{
+				std::cerr << "rl::mdl::ReachabilityMap on file " << filename << " without sample." << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			kinematics->setPosition(q2);
+			kinematics->forwardPosition();
+			
+			if ((kinematics->getOperationalPosition(0).translation() - t1.translation()).norm() > std::sqrt(3) * mapped.getResolution())
+			{
+				std::cerr << "rl::mdl::ReachabilityMap on file " << filename << " with distant seed." << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				std::cerr << "q2 = " << q2.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			kinematics->setPosition(kinematics->generatePositionUniform());
+			reachabilityIk.clearGoals();
+			reachabilityIk.addGoal(t1, 0);
+			
+			if (!reachabilityIk.solve())
+			{
+				std::cerr << "rl::mdl::JacobianInverseKinematics with rl::mdl::ReachabilityMap on file " << filename << " with no solution." << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			kinematics->normalize(q1);
+			kinematics->setPosition(q1);
+			
+			if (!reachabilityIk.solve() || !kinematics->getPosition().isApprox(q1))
+			{
+				std::cerr << "rl::mdl::JacobianInverseKinematics with rl::mdl::ReachabilityMap on file " << filename << " without keeping current solution." << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				std::cerr << "q2 = " << kinematics->getPosition().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			t1.translation().x() += 100;
+			
+			reachabilityIk.clearGoals();
+			reachabilityIk.addGoal(t1, 0);
+			
+			if (mapped.isReachable(t1) || reachabilityIk.solve())
+			{
+				std::cerr << "rl::mdl::JacobianInverseKinematics with rl::mdl::ReachabilityMap on file " << filename << " with solution for unreachable goal." << std::endl;
+				return EXIT_FAILURE;
 			}
 		}
 	}
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/TrackingInverseKinematics.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlTrackingInverseKinematicsMdlTest KINEMATICSFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename = argv[1];
+		
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Kinematic> kinematics = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(filename));
+		
+		std::size_t cycles = 2000;
+		
+		rl::mdl::TrackingInverseKinematics ik(kinematics.get());
+		ik.setCapacity(cycles);
+		// only check correctness, latency is reported by rlTrackingInverseKinematicsDemo
+		ik.setDuration(std::chrono::seconds(10));
+		
+		// smooth joint trajectory sampled every millisecond
+		
+		rl::math::Vector minimum = kinematics->getMinimum();
+		rl::math::Vector maximum = kinematics->getMaximum();
+		
+		std::vector<rl::math::Vector> q(cycles);
+		std::vector<rl::math::Transform> t(cycles);
+		
+		for (std::size_t i = 0; i < cycles; ++i)
+		{
+			q[i].resize(kinematics->getDofPosition());
+			
+			for (std::ptrdiff_t j = 0; j < q[i].size(); ++j)
+			{
+				q[i](j) = (minimum(j) + maximum(j)) / 2 + (maximum(j) - minimum(j)) / 4 * std::sin(2 * rl::math::constants::pi * (j + 1) * i / 10000 + j);
+			}
+			
+			kinematics->setPosition(q[i]);
+			kinematics->forwardPosition();
+			t[i] = kinematics->getOperationalPosition(0);
+		}
+		
+		kinematics->setPosition(q[0] + rl::math::Vector::Constant(kinematics->getDofPosition(), static_cast<rl::math::Real>(0.01)));
+		
+		for (std::size_t i = 0; i <= cycles; ++i)
+		{
+			// jump back to start pose after trajectory, solved from cache
+			
+			const rl::math::Vector& q1 = q[i < cycles ? i : 0];
+			const rl::math::Transform& t1 = t[i < cycles ? i : 0];
+			
+			ik.clearGoals();
+			ik.addGoal(t1, 0);
+			
+			if (!ik.solve())
+			{
+				std::cerr << "rl::mdl::TrackingInverseKinematics on file " << filename << " with no solution in cycle " << i << "." << std::endl;
+				std::cerr << "t1 = " << std::endl << t1.matrix() << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			rl::math::Vector q3 = kinematics->getPosition();
+			kinematics->forwardPosition();
+			rl::math::Transform t3 = kinematics->getOperationalPosition(0);
+			
+			if (t3.toDelta(t1).squaredNorm() > std::pow(ik.getEpsilon(), 2))
+			{
+				std::cerr << "rl::mdl::TrackingInverseKinematics on file " << filename << " with incorrect operational position in cycle " << i << "." << std::endl;
+				std::cerr << "t3.toDelta(t1) = " << t3.toDelta(t1).transpose() << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				std::cerr << "q3 = " << q3.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		if (0 == ik.getCacheSize())
+		{
+			std::cerr << "rl::mdl::TrackingInverseKinematics on file " << filename << " with empty cache." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// joint position set in between is used as start
+		
+		ik.clear();
+		kinematics->setPosition(q[cycles / 2]);
+		ik.clearGoals();
+		ik.addGoal(t[cycles / 2], 0);
+		
+		if (!ik.solve() || !kinematics->getPosition().isApprox(q[cycles / 2]))
+		{
+			std::cerr << "rl::mdl::TrackingInverseKinematics on file " << filename << " not starting from current joint position." << std::endl;
+			std::cerr << "q1 = " << q[cycles / 2].transpose() << std::endl;
+			std::cerr << "q3 = " << kinematics->getPosition().transpose() << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
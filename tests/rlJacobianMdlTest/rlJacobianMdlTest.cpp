@@ -28,6 +28,9 @@
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 #include <rl/math/Constants.h>
 #include <rl/math/Transform.h>
 #include <rl/mdl/Kinematic.h>
@@ -89,6 +92,34 @@ main(int argc, char** argv)
 			return EXIT_FAILURE;
 		}
 		
+		std::vector<std::pair<rl::mdl::Kinematic::JacobianInverseMethod, std::string>> methods = {
+			{rl::mdl::Kinematic::JacobianInverseMethod::bdcSvd, "bdcSvd"},
+			{rl::mdl::Kinematic::JacobianInverseMethod::cod, "cod"},
+			{rl::mdl::Kinematic::JacobianInverseMethod::ldlt, "ldlt"},
+			{rl::mdl::Kinematic::JacobianInverseMethod::llt, "llt"},
+			{rl::mdl::Kinematic::JacobianInverseMethod::svd, "svd"}
+		};
+		
+		kinematics->setPosition(q);
+		kinematics->calculateJacobian();
+		rl::math::Vector dx = rl::math::Vector::Ones(6);
+		rl::math::Vector dq(dof);
+		
+		for (std::size_t i = 0; i < methods.size(); ++i)
+		{
+			kinematics->calculateJacobianInverse(0, methods[i].first);
+			rl::math::Matrix jacobianInverse = kinematics->getJacobianInverse();
+			kinematics->solveJacobianInverse(dx, dq, 0, methods[i].first);
+			
+			if ((jacobianAlgebraic * jacobianInverse * jacobianAlgebraic - jacobianAlgebraic).norm() > 1.0e-6 || (jacobianInverse * dx - dq).norm() > 1.0e-6)
+			{
+				std::cerr << "Jacobian inverse with method " << methods[i].second << " is not a pseudo-inverse." << std::endl;
+				std::cerr << " q [rad]: " << q.transpose() << std::endl;
+				std::cerr << " jacobianInverse: " << std::endl << jacobianInverse << std::endl;
+				std::cerr << " dq: " << dq.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
 	}
 	
 	return EXIT_SUCCESS;
@@ -16,6 +16,26 @@
 #define N 100000
 #define QUERIES 100
 
+/** Metric with distances of a query to a range of values in one call. */
+struct BatchMetric : public rl::math::metrics::L2<const rl::math::Vector*>
+{
+	using rl::math::metrics::L2<const rl::math::Vector*>::operator();
+	
+	void operator()(const Value& query, const Value* first, const Value* last, Distance* distances) const
+	{
+		++calls;
+		
+		for (; first != last; ++first, ++distances)
+		{
+			*distances = (*this)(query, *first);
+		}
+	}
+	
+	static std::size_t calls;
+};
+
+std::size_t BatchMetric::calls = 0;
+
 template<typename NearestNeighbors>
 std::vector<std::vector<typename NearestNeighbors::Neighbor>>
 test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Vector>& queries, const bool& iterative, const bool& squared)
@@ -94,6 +114,16 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 	std::cout << "** LinearNearestNeighbors<Metric> *********************************************" << std::endl;
 	std::vector<std::vector<rl::math::LinearNearestNeighbors<Metric>::Neighbor>> linear = test<rl::math::LinearNearestNeighbors<Metric>>(points, queries, iterative, false);
 	
+	std::cout << "** LinearNearestNeighbors<BatchMetric> ****************************************" << std::endl;
+	BatchMetric::calls = 0;
+	std::vector<std::vector<rl::math::LinearNearestNeighbors<BatchMetric>::Neighbor>> linearBatch = test<rl::math::LinearNearestNeighbors<BatchMetric>>(points, queries, iterative, false);
+	
+	if (queries.size() != BatchMetric::calls)
+	{
+		std::cerr << "rlNearestNeighborsTest: LinearNearestNeighbors<BatchMetric> with " << BatchMetric::calls << " batch calls for " << queries.size() << " queries" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	
 	std::cout << "** LinearNearestNeighbors<MetricSquared> **************************************" << std::endl;
 	std::vector<std::vector<rl::math::LinearNearestNeighbors<MetricSquared>::Neighbor>> linear2 = test<rl::math::LinearNearestNeighbors<MetricSquared>>(points, queries, iterative, true);
 	
@@ -110,6 +140,14 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 	{
 		for (std::size_t j = 0; j < linear[i].size(); ++j)
 		{
+			if (linear[i][j] != linearBatch[i][j])
+			{
+				std::cerr << "rlNearestNeighborsTest: LinearNearestNeighbors<Metric> != LinearNearestNeighbors<BatchMetric>" << std::endl;
+				std::cerr << "[" << i << "][" << j << "] " << linear[i][j].first << " LinearNearestNeighbors<Metric>: " << linear[i][j].second->transpose() << std::endl;
+				std::cerr << "[" << i << "][" << j << "] " << linearBatch[i][j].first << " LinearNearestNeighbors<BatchMetric>: " << linearBatch[i][j].second->transpose() << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			
 			if (!Eigen::internal::isApprox(linear[i][j].first, std::sqrt(linear2[i][j].first)) ||
 				!linear[i][j].second->isApprox(*linear2[i][j].second))
 			{
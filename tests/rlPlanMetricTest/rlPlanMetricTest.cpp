@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <rl/kin/Kinematics.h>
+#include <rl/mdl/Joint.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/LinearNearestNeighbors.h>
+#include <rl/plan/Metric.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+
+/**
+ * Model that hides its weighted metric, so that distances use the virtual
+ * model functions.
+ */
+class UnweightedModel : public rl::plan::SimpleModel
+{
+public:
+	bool getWeightedMetric(rl::math::Vector& weights, rl::math::Vector& periods) const
+	{
+		return false;
+	}
+};
+
+bool
+equal(const rl::math::Real& lhs, const rl::math::Real& rhs)
+{
+	// 1e-9 with double, relative to machine epsilon with float
+	rl::math::Real tolerance = std::max(static_cast<rl::math::Real>(1.0e-9), 100 * std::numeric_limits<rl::math::Real>::epsilon());
+	return std::abs(lhs - rhs) <= tolerance * std::max(static_cast<rl::math::Real>(1), std::abs(rhs));
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: rlPlanMetricTest ENGINE KINEMATICSFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::kin::Kinematics> kinematics;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic;
+		
+		rl::plan::SimpleModel model;
+		UnweightedModel unweighted;
+		
+		if ("kin" == std::string(argv[1]))
+		{
+			kinematics = rl::kin::Kinematics::create(argv[2]);
+			model.kin = kinematics.get();
+			unweighted.kin = kinematics.get();
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(argv[2]));
+			
+			Eigen::Matrix<bool, Eigen::Dynamic, 1> wraparound(1);
+			wraparound(0) = true;
+			kinematic->getJoint(0)->setWraparound(wraparound);
+			kinematic->getJoint(kinematic->getJoints() - 1)->setWraparound(wraparound);
+			
+			model.mdl = kinematic.get();
+			unweighted.mdl = kinematic.get();
+		}
+		
+		rl::math::Vector weights;
+		rl::math::Vector periods;
+		
+		if (!model.getWeightedMetric(weights, periods))
+		{
+			std::cerr << "Model has no weighted metric." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::plan::UniformSampler sampler;
+		sampler.setModel(&model);
+		sampler.seed(1);
+		
+		std::vector<rl::math::Vector> q;
+		
+		for (std::size_t i = 0; i < 500; ++i)
+		{
+			q.push_back(sampler.generate());
+		}
+		
+		std::vector<rl::plan::Metric::Value> values;
+		
+		for (std::size_t i = 0; i < q.size(); ++i)
+		{
+			values.push_back(rl::plan::Metric::Value(&q[i], &q[i]));
+		}
+		
+		rl::plan::Metric distance(&model, false);
+		rl::plan::Metric transformedDistance(&model, true);
+		
+		std::vector<rl::math::Real> distances(values.size());
+		transformedDistance(values[0], values.data(), values.data() + values.size(), distances.data());
+		
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			if (!equal(transformedDistance(values[0], values[i]), model.transformedDistance(q[0], q[i])))
+			{
+				std::cerr << "Transformed distance " << transformedDistance(values[0], values[i]) << " != " << model.transformedDistance(q[0], q[i]) << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			if (!equal(distance(values[0], values[i]), model.distance(q[0], q[i])))
+			{
+				std::cerr << "Distance " << distance(values[0], values[i]) << " != " << model.distance(q[0], q[i]) << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			if (!equal(distances[i], model.transformedDistance(q[0], q[i])))
+			{
+				std::cerr << "Batch transformed distance " << distances[i] << " != " << model.transformedDistance(q[0], q[i]) << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			for (std::ptrdiff_t j = 0; j < q[i].size(); ++j)
+			{
+				if (!equal(transformedDistance(q[0](j), q[i](j), j), model.transformedDistance(q[0](j), q[i](j), j)))
+				{
+					std::cerr << "Coordinate transformed distance " << transformedDistance(q[0](j), q[i](j), j) << " != " << model.transformedDistance(q[0](j), q[i](j), j) << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+		}
+		
+		rl::plan::LinearNearestNeighbors nearestNeighbors(&model);
+		rl::plan::LinearNearestNeighbors nearestNeighbors2(&unweighted);
+		nearestNeighbors.insert(values);
+		nearestNeighbors2.insert(values);
+		
+		for (std::size_t i = 0; i < 50; ++i)
+		{
+			std::vector<rl::plan::NearestNeighbors::Neighbor> neighbors = nearestNeighbors.nearest(values[i], 5);
+			std::vector<rl::plan::NearestNeighbors::Neighbor> neighbors2 = nearestNeighbors2.nearest(values[i], 5);
+			
+			for (std::size_t j = 0; j < neighbors2.size(); ++j)
+			{
+				if (!equal(neighbors[j].first, neighbors2[j].first))
+				{
+					std::cerr << "Nearest neighbor distance " << neighbors[j].first << " != " << neighbors2[j].first << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+			
+			if (nearestNeighbors.radius(values[i], 1).size() != nearestNeighbors2.radius(values[i], 1).size())
+			{
+				std::cerr << "Number of neighbors within radius differs." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
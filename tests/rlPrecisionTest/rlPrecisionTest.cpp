@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <rl/math/Real.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlPrecisionTest REAL MODELFILE LOOP" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::string real(argv[1]);
+	
+	if (("float" == real && !std::is_same<rl::math::Real, float>::value) || ("double" == real && !std::is_same<rl::math::Real, double>::value))
+	{
+		std::cerr << "rl::math::Real is not " << real << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::mt19937 generator(0);
+		std::uniform_real_distribution<rl::math::Real> distribution(-1, 1);
+		
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[2]));
+		
+		if (nullptr == dynamic)
+		{
+			std::cerr << "Model " << argv[2] << " is not a dynamic model" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Real epsilon = std::sqrt(std::numeric_limits<rl::math::Real>::epsilon());
+		
+		rl::math::Vector q(dynamic->getDofPosition());
+		rl::math::Vector qd(dynamic->getDof());
+		rl::math::Vector qdd(dynamic->getDof());
+		rl::math::Vector tau(dynamic->getDof());
+		rl::math::Vector tau2(dynamic->getDof());
+		rl::math::Vector G(dynamic->getDof());
+		rl::math::Vector V(dynamic->getDof());
+		rl::math::Matrix M(dynamic->getDof(), dynamic->getDof());
+		
+		for (std::size_t i = 0; i < std::atoi(argv[3]); ++i)
+		{
+			for (std::ptrdiff_t j = 0; j < q.size(); ++j)
+			{
+				q(j) = distribution(generator);
+			}
+			
+			for (std::ptrdiff_t j = 0; j < qd.size(); ++j)
+			{
+				qd(j) = distribution(generator);
+				tau(j) = distribution(generator);
+			}
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(tau);
+			dynamic->forwardDynamics();
+			dynamic->getAcceleration(qdd);
+			
+			dynamic->setAcceleration(qdd);
+			dynamic->inverseDynamics();
+			dynamic->getTorque(tau2);
+			
+			if (!tau2.isApprox(tau, epsilon) && (tau2 - tau).norm() > epsilon)
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "tau = " << tau.transpose() << std::endl;
+				std::cerr << "tau (inverse dynamics) = " << tau2.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			dynamic->calculateMassMatrix(M);
+			dynamic->calculateCentrifugalCoriolis(V);
+			dynamic->calculateGravity(G);
+			
+			if (!(M * qdd + V + G).isApprox(tau, epsilon) && (M * qdd + V + G - tau).norm() > epsilon)
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "tau = " << tau.transpose() << std::endl;
+				std::cerr << "M * qdd + V + G = " << (M * qdd + V + G).transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/Prm.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+#include <rl/sg/ode/Scene.h>
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+
+std::shared_ptr<rl::sg::Scene>
+createScene(const std::string& engine, const std::string& filename)
+{
+	std::shared_ptr<rl::sg::Scene> scene;
+	
+#ifdef RL_SG_BULLET
+	if ("bullet" == engine)
+	{
+		scene = std::make_shared<rl::sg::bullet::Scene>();
+	}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+	if ("fcl" == engine)
+	{
+		scene = std::make_shared<rl::sg::fcl::Scene>();
+	}
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+	if ("ode" == engine)
+	{
+		scene = std::make_shared<rl::sg::ode::Scene>();
+	}
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+	if ("pqp" == engine)
+	{
+		scene = std::make_shared<rl::sg::pqp::Scene>();
+	}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+	if ("solid" == engine)
+	{
+		scene = std::make_shared<rl::sg::solid::Scene>();
+	}
+#endif // RL_SG_SOLID
+	
+	rl::sg::XmlFactory factory;
+	factory.load(filename, scene.get());
+	
+	return scene;
+}
+
+struct Worker
+{
+	Worker(const std::string& engine, const std::string& filename, const rl::mdl::Kinematic* kinematic, const std::size_t& seed) :
+		kinematic(static_cast<rl::mdl::Kinematic*>(kinematic->clone())),
+		model(),
+		sampler(),
+		scene(createScene(engine, filename)),
+		verifier()
+	{
+		this->model.mdl = this->kinematic.get();
+		this->model.model = this->scene->getModel(0);
+		this->model.scene = this->scene.get();
+		
+		this->sampler.setModel(&this->model);
+		this->sampler.seed(seed);
+		
+		this->verifier.setDelta(1 * rl::math::constants::deg2rad);
+		this->verifier.setModel(&this->model);
+	}
+	
+	std::unique_ptr<rl::mdl::Kinematic> kinematic;
+	
+	rl::plan::SimpleModel model;
+	
+	rl::plan::UniformSampler sampler;
+	
+	std::shared_ptr<rl::sg::Scene> scene;
+	
+	rl::plan::RecursiveVerifier verifier;
+};
+
+rl::plan::VectorList
+plan(const std::vector<std::string>& args, const rl::mdl::Kinematic* kinematic, rl::math::Vector& start, rl::math::Vector& goal, std::size_t& vertices, std::size_t& edges)
+{
+	std::size_t workers = boost::lexical_cast<std::size_t>(args[4]);
+	
+	std::vector<std::unique_ptr<Worker>> worker;
+	std::vector<rl::plan::Sampler*> samplers;
+	std::vector<rl::plan::Verifier*> verifiers;
+	
+	for (std::size_t i = 0; i < workers; ++i)
+	{
+		worker.emplace_back(new Worker(args[1], args[2], kinematic, i));
+		samplers.push_back(&worker[i]->sampler);
+		verifiers.push_back(&worker[i]->verifier);
+	}
+	
+	rl::plan::KdtreeNearestNeighbors nearestNeighbors(&worker.front()->model);
+	rl::plan::Prm planner;
+	
+	planner.setModel(&worker.front()->model);
+	planner.setNearestNeighbors(&nearestNeighbors);
+	planner.setSampler(&worker.front()->sampler);
+	planner.setVerifier(&worker.front()->verifier);
+	planner.setWorkers(samplers, verifiers);
+	planner.setStart(&start);
+	planner.setGoal(&goal);
+	planner.setDuration(std::chrono::seconds(20));
+	
+	planner.construct(boost::lexical_cast<std::size_t>(args[5]));
+	
+	if (!planner.solve())
+	{
+		throw std::runtime_error("solve() false");
+	}
+	
+	vertices = planner.getNumVertices();
+	edges = planner.getNumEdges();
+	
+	return planner.getPath();
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 14)
+	{
+		std::cout << "Usage: rlPrmParallelTest ENGINE SCENEFILE KINEMATICSFILE WORKERS VERTICES X Y Z A B C START1 ... STARTn GOAL1 ... GOALn" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::vector<std::string> args(argv, argv + argc);
+		
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(argv[3]));
+		
+		rl::math::Transform world = rl::math::Transform::Identity();
+		
+		world = rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[11]) * ::rl::math::constants::deg2rad,
+			::rl::math::Vector3::UnitZ()
+		) * ::rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[10]) * ::rl::math::constants::deg2rad,
+			::rl::math::Vector3::UnitY()
+		) * ::rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[9]) * ::rl::math::constants::deg2rad,
+			::rl::math::Vector3::UnitX()
+		);
+		
+		world.translation().x() = boost::lexical_cast<rl::math::Real>(argv[6]);
+		world.translation().y() = boost::lexical_cast<rl::math::Real>(argv[7]);
+		world.translation().z() = boost::lexical_cast<rl::math::Real>(argv[8]);
+		
+		kinematic->world() = world;
+		
+		rl::math::Vector start(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < start.size(); ++i)
+		{
+			start(i) = boost::lexical_cast<rl::math::Real>(argv[i + 12]) * rl::math::constants::deg2rad;
+		}
+		
+		rl::math::Vector goal(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < goal.size(); ++i)
+		{
+			goal(i) = boost::lexical_cast<rl::math::Real>(argv[start.size() + i + 12]) * rl::math::constants::deg2rad;
+		}
+		
+		std::size_t vertices1;
+		std::size_t edges1;
+		rl::plan::VectorList path1 = plan(args, kinematic.get(), start, goal, vertices1, edges1);
+		
+		std::size_t vertices2;
+		std::size_t edges2;
+		rl::plan::VectorList path2 = plan(args, kinematic.get(), start, goal, vertices2, edges2);
+		
+		std::cout << "NumVertices: " << vertices1 << "  NumEdges: " << edges1 << "  Path: " << path1.size() << std::endl;
+		
+		if (vertices1 != vertices2 || edges1 != edges2 || path1.size() != path2.size())
+		{
+			std::cerr << "Roadmaps differ for same seeds and number of workers" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		for (rl::plan::VectorList::iterator i = path1.begin(), j = path2.begin(); i != path1.end(); ++i, ++j)
+		{
+			if (*i != *j)
+			{
+				std::cerr << "Paths differ for same seeds and number of workers" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
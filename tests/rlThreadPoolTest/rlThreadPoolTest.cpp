@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2013, Andre Gaschler, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <rl/util/ThreadPool.h>
+
+int
+main(int argc, char** argv)
+{
+	rl::util::ThreadPool pool(4);
+	
+	if (4 != pool.size())
+	{
+		std::cerr << "rl::util::ThreadPool with " << pool.size() << " instead of 4 threads." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// every index called once per run, workers are reused between runs
+	
+	std::vector<std::thread::id> ids(pool.size());
+	
+	for (std::size_t n = 0; n < 1000; ++n)
+	{
+		std::size_t threads = n % (pool.size() + 1);
+		std::vector<std::atomic<std::size_t>> calls(pool.size());
+		
+		pool.run(threads, [&](const std::size_t& i) {
+			++calls[i];
+			
+			if (std::thread::id() == ids[i])
+			{
+				ids[i] = std::this_thread::get_id();
+			}
+			else if (ids[i] != std::this_thread::get_id())
+			{
+				throw std::runtime_error("Index " + std::to_string(i) + " called from new thread");
+			}
+		});
+		
+		for (std::size_t i = 0; i < calls.size(); ++i)
+		{
+			if ((i < threads ? 1u : 0u) != calls[i])
+			{
+				std::cerr << "rl::util::ThreadPool called index " << i << " " << calls[i] << " times in run " << n << " with " << threads << " threads." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	
+	// exception of lowest failed index is rethrown, pool stays usable
+	
+	try
+	{
+		pool.run(pool.size(), [&](const std::size_t& i) {
+			if (i > 0)
+			{
+				throw std::runtime_error(std::to_string(i));
+			}
+		});
+		
+		std::cerr << "rl::util::ThreadPool without exception." << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch (const std::runtime_error& e)
+	{
+		if (std::string("1") != e.what())
+		{
+			std::cerr << "rl::util::ThreadPool with exception " << e.what() << " instead of 1." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	std::atomic<std::size_t> calls(0);
+	
+	pool.run(pool.size(), [&](const std::size_t&) {
+		++calls;
+	});
+	
+	if (pool.size() != calls)
+	{
+		std::cerr << "rl::util::ThreadPool with " << calls << " calls after exception." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}